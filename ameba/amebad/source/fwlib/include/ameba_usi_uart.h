@@ -286,6 +286,26 @@ typedef struct {
                                               DISABLE: USI uart IrDA rx filter is not used.
                                               @note This parameter is only used in IrDA mode. */
 } USI_UartIrDAInitTypeDef;
+
+/**
+  * @brief  USI UART RX DMA Ring Structure Definition
+  */
+typedef struct {
+	u8 USIIndex;		/*!< USI index, 0. */
+	u8 GdmaChnl;
+	u8 *Buf;		/*!< Ring buffer, cache line aligned. */
+	u32 Size;		/*!< Ring size in bytes, multiple of cache line size. */
+	void (*Callback)(void *CbData, u32 Wr);	/*!< Called from ISR on idle line and on wrap with the write count. */
+	void *CbData;		/*!< Callback argument. */
+
+	volatile u32 Wr;	/*!< Free running count of bytes written to the ring. */
+	volatile u32 Rd;	/*!< Free running count of bytes consumed by the application. */
+	u32 ArmPos;		/*!< Ring offset GDMA was last armed at. */
+	u32 ArmWr;		/*!< Wr when GDMA was last armed. */
+	u32 OverflowCnt;	/*!< Bytes lost because the application fell behind, overwritten by GDMA or dropped from the FIFO. */
+	u32 DmaErrCnt;		/*!< GDMA error interrupts, the ring is re-armed behind the data moved before the error. */
+	GDMA_InitTypeDef Gdma;
+} USI_UARTRxRingTypeDef;
 /**
   * @}
   */
@@ -443,6 +463,14 @@ typedef struct {
   * @}
   */
 
+/** @defgroup USI_UART_Rx_Ring_define
+  * @{
+  */
+#define USI_UART_RX_RING_BURST			16
+/**
+  * @}
+  */
+
 /** @defgroup USI_UART_SoftWare_Status_define
   * @{
   */
@@ -492,6 +520,7 @@ _LONG_CALL_ void USI_UARTBreakCtl(USI_TypeDef *USIx, u32 NewState);
 _LONG_CALL_ u32 USI_UARTClearRxFifo(USI_TypeDef *USIx);
 _LONG_CALL_ void USI_UARTClearTxFifo(USI_TypeDef *USIx);
 _LONG_CALL_ u32 USI_UARTGetRxFifoValidCnt(USI_TypeDef *USIx);
+_LONG_CALL_ u32 USI_UARTRxFifoDrain(USI_TypeDef *USIx, u8 *OutBuf, u32 Count);
 _LONG_CALL_ u32 USI_UARTGetTxFifoEmptyCnt(USI_TypeDef *USIx);
 _LONG_CALL_ void USI_UARTINTConfig(USI_TypeDef *USIx, u32 UART_IT, u32 newState);
 _LONG_CALL_ u32 USI_UARTIntStatus(USI_TypeDef *USIx);
@@ -518,6 +547,10 @@ _LONG_CALL_ void USI_UARTTXDMACmd(USI_TypeDef *USIx, u32 NewState);
 _LONG_CALL_ void USI_UARTRXDMACmd(USI_TypeDef *USIx, u32 NewState);
 _LONG_CALL_ bool USI_UARTTXGDMA_Init(u8 USIIndex, GDMA_InitTypeDef *GDMA_InitStruct, void *CallbackData, IRQ_FUN CallbackFunc, u8 *pTxBuf, int TxCount);
 _LONG_CALL_ bool USI_UARTRXGDMA_Init(u8 USIIndex, GDMA_InitTypeDef *GDMA_InitStruct, void *CallbackData, IRQ_FUN CallbackFunc, u8 *pRxBuf, int RxCount);
+_LONG_CALL_ bool USI_UARTRxRingInit(USI_UARTRxRingTypeDef *Ring, u8 USIIndex, u8 *Buf, u32 Size, u32 TimeOutCnt, void (*Callback)(void *CbData, u32 Wr), void *CbData);
+_LONG_CALL_ void USI_UARTRxRingDeInit(USI_UARTRxRingTypeDef *Ring);
+_LONG_CALL_ u32 USI_UARTRxRingPeek(USI_UARTRxRingTypeDef *Ring, u8 **ppData);
+_LONG_CALL_ void USI_UARTRxRingConsume(USI_UARTRxRingTypeDef *Ring, u32 Len);
 /**
   * @}
   */
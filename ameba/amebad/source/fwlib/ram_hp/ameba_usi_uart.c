@@ -375,7 +375,7 @@ void USI_UARTCharGet(USI_TypeDef *USIx, u8  *pRxByte)
 }
 
 /**
-  * @brief  Receive data from rx FIFO, poll USI_UARTReadable.
+  * @brief  Receive data from rx FIFO, poll USI_UARTGetRxFifoValidCnt.
   * @param  USIx: selected UART peripheral, where x can be 0.
   * @param[out]  outBuf: buffer to save data read from UART FIFO.
   * @param  count: number of data to be read.
@@ -392,10 +392,8 @@ void USI_UARTReceiveData(
 	/*check the parameters*/
 	assert_param(IS_ALL_USI_PERIPH(USIx));
 
-	for (cnt = 0; cnt < Count; cnt++) {
-		while (USI_UARTReadable(USIx) == 0);
-
-		*OutBuf++ = (u8)USIx->RX_FIFO_READ;
+	while (cnt < Count) {
+		cnt += USI_UARTRxFifoDrain(USIx, OutBuf + cnt, Count - cnt);
 	}
 }
 
@@ -429,7 +427,7 @@ void USI_UARTSendData(
   * @param  USIx: selected UART peripheral, where x can be 0.
   * @param[out]  outBuf: buffer to save data read from UART FIFO.
   * @param  count: number of data to be read.
-  * @param  Times: poll USI_UARTReadable times before timeout.
+  * @param  Times: poll USI_UARTGetRxFifoValidCnt times before timeout.
   * @retval transfer len
   */
 u32 USI_UARTReceiveDataTO(
@@ -445,15 +443,10 @@ u32 USI_UARTReceiveDataTO(
 	/*check the parameters*/
 	assert_param(IS_ALL_USI_PERIPH(USIx));
 
-	while (1) {
-		if (USI_UARTReadable(USIx)) {
-			*(OutBuf + cnt) = (u8)USIx->RX_FIFO_READ;
-			cnt++;
+	while (cnt < Count) {
+		if (USI_UARTGetRxFifoValidCnt(USIx)) {
+			cnt += USI_UARTRxFifoDrain(USIx, OutBuf + cnt, Count - cnt);
 			polltimes = 0;
-
-			if (cnt >= Count) {
-				break;
-			}
 		} else {
 			polltimes++;
 
@@ -641,6 +634,41 @@ u32 USI_UARTGetRxFifoValidCnt(USI_TypeDef *USIx)
 	return (u32)((USIx->RX_FIFO_STATUS & USI_RXFIFO_VALID_CNT) >> 8);
 }
 
+/**
+  * @brief  Read the data already in rx FIFO without waiting.
+  * @param  USIx: where x can be 0.
+  * @param[out]  OutBuf: buffer to save data read from UART FIFO.
+  * @param  Count: max number of data to be read.
+  * @note   RX FIFO valid count is read once per batch instead of checking
+  *         USI_UARTReadable before each byte.
+  * @retval number of data read
+  */
+u32 USI_UARTRxFifoDrain(USI_TypeDef *USIx, u8 *OutBuf, u32 Count)
+{
+	u32 cnt = 0;
+	u32 valid;
+
+	/*check the parameters*/
+	assert_param(IS_ALL_USI_PERIPH(USIx));
+
+	while (cnt < Count) {
+		valid = USI_UARTGetRxFifoValidCnt(USIx);
+		if (valid == 0) {
+			break;
+		}
+
+		if (valid > Count - cnt) {
+			valid = Count - cnt;
+		}
+
+		while (valid--) {
+			OutBuf[cnt++] = (u8)USIx->RX_FIFO_READ;
+		}
+	}
+
+	return cnt;
+}
+
 /**
   * @brief    USI UART get empty entry count in TX FIFO .
   * @param  USIx: where x can be 0.
@@ -1119,6 +1147,269 @@ bool USI_UARTRXGDMA_Init(
 	return TRUE;
 }
 
+/* RX ring: GDMA streams into the ring from the offset it was armed at up to
+ * the ring end and is re-armed at offset 0 from the block ISR. The rx FIFO
+ * timeout interrupt reports an idle line: the channel is stopped, the bytes
+ * under one DMA burst left in the FIFO are drained by CPU in batches, and
+ * GDMA is re-armed right after them.
+ */
+static void USI_UARTRxRing_Arm(USI_UARTRxRingTypeDef *Ring, u32 Pos)
+{
+	GDMA_InitTypeDef *GDMA_InitStruct = &Ring->Gdma;
+
+	Ring->ArmPos = Pos;
+	Ring->ArmWr = Ring->Wr;
+
+	GDMA_InitStruct->GDMA_DstAddr = (u32)(Ring->Buf + Pos);
+	GDMA_InitStruct->GDMA_BlockSize = Ring->Size - Pos;
+
+	GDMA_Init(GDMA_InitStruct->GDMA_Index, GDMA_InitStruct->GDMA_ChNum, GDMA_InitStruct);
+	GDMA_Cmd(GDMA_InitStruct->GDMA_Index, GDMA_InitStruct->GDMA_ChNum, ENABLE);
+}
+
+/* GDMA does not stop at Rd: once it has come round past the application the
+ * bytes it wrote over are lost, count them and move Rd to the oldest byte left.
+ * Called with interrupts disabled.
+ */
+static void USI_UARTRxRing_Overrun(USI_UARTRxRingTypeDef *Ring)
+{
+	u32 Len = Ring->Wr - Ring->Rd;
+
+	if (Len > Ring->Size) {
+		Ring->OverflowCnt += Len - Ring->Size;
+		Ring->Rd = Ring->Wr - Ring->Size;
+	}
+}
+
+static u32 USI_UARTRxRing_DmaIrq(void *Data)
+{
+	USI_UARTRxRingTypeDef *Ring = (USI_UARTRxRingTypeDef *)Data;
+	u32 PrevIrqStatus;
+	u32 IsrType;
+	u32 Wr;
+
+	PrevIrqStatus = irq_disable_save();
+	IsrType = GDMA_ClearINT(0, Ring->GdmaChnl);
+
+	if (IsrType & ErrType) {
+		/* the channel stopped, keep what it moved and re-arm behind it */
+		Ring->DmaErrCnt++;
+		GDMA_Abort(0, Ring->GdmaChnl);
+		Ring->Wr = Ring->ArmWr + (GDMA_GetDstAddr(0, Ring->GdmaChnl) - (u32)(Ring->Buf + Ring->ArmPos));
+		USI_UARTRxRing_Overrun(Ring);
+		USI_UARTRxRing_Arm(Ring, Ring->Wr % Ring->Size);
+	} else if (IsrType & (BlockType | TransferType)) {
+		GDMA_Cmd(0, Ring->GdmaChnl, DISABLE);
+		Ring->Wr = Ring->ArmWr + (Ring->Size - Ring->ArmPos);
+		USI_UARTRxRing_Overrun(Ring);
+		USI_UARTRxRing_Arm(Ring, 0);
+	} else {
+		/* already handled by the timeout ISR if the status is gone */
+		irq_enable_restore(PrevIrqStatus);
+		return 0;
+	}
+	Wr = Ring->Wr;
+	irq_enable_restore(PrevIrqStatus);
+
+	if (Ring->Callback != NULL) {
+		Ring->Callback(Ring->CbData, Wr);
+	}
+
+	return 0;
+}
+
+static u32 USI_UARTRxRing_Irq(void *Data)
+{
+	USI_UARTRxRingTypeDef *Ring = (USI_UARTRxRingTypeDef *)Data;
+	USI_TypeDef *USIx = USI_DEV_TABLE[Ring->USIIndex].USIx;
+	u32 PrevIrqStatus;
+	u32 Pos;
+	u32 Room;
+	u32 Cnt;
+	u8 Drop[16];
+	u32 Wr;
+
+	if ((USI_UARTIntStatus(USIx) & USI_RX_FIFO_TIMEOUT_INTER) == 0) {
+		return 0;
+	}
+
+	PrevIrqStatus = irq_disable_save();
+
+	USI_UARTRXDMACmd(USIx, DISABLE);
+	GDMA_Abort(0, Ring->GdmaChnl);
+	GDMA_ClearINT(0, Ring->GdmaChnl);
+
+	Ring->Wr = Ring->ArmWr + (GDMA_GetDstAddr(0, Ring->GdmaChnl) - (u32)(Ring->Buf + Ring->ArmPos));
+	USI_UARTRxRing_Overrun(Ring);
+	Pos = Ring->Wr % Ring->Size;
+
+	/* the timeout interrupt is cleared by hardware once the FIFO is empty */
+	while (USI_UARTGetRxFifoValidCnt(USIx)) {
+		Room = Ring->Size - (Ring->Wr - Ring->Rd);
+		if (Room == 0) {
+			Ring->OverflowCnt += USI_UARTRxFifoDrain(USIx, Drop, sizeof(Drop));
+			continue;
+		}
+		if (Room > Ring->Size - Pos) {
+			Room = Ring->Size - Pos;
+		}
+
+		DCache_Invalidate((u32)(Ring->Buf + Pos), Room);
+		Cnt = USI_UARTRxFifoDrain(USIx, Ring->Buf + Pos, Room);
+		DCache_Clean((u32)(Ring->Buf + Pos), Cnt);
+
+		Ring->Wr += Cnt;
+		Pos += Cnt;
+		if (Pos == Ring->Size) {
+			Pos = 0;
+		}
+	}
+
+	USI_UARTRxRing_Arm(Ring, Pos);
+	USI_UARTRXDMACmd(USIx, ENABLE);
+	Wr = Ring->Wr;
+
+	irq_enable_restore(PrevIrqStatus);
+
+	if (Ring->Callback != NULL) {
+		Ring->Callback(Ring->CbData, Wr);
+	}
+
+	return 0;
+}
+
+/**
+  * @brief  Start continuous USI UART RX into a ring buffer by GDMA, with idle line detection.
+  * @param  Ring: ring control block.
+  * @param  USIIndex: 0. USI UART must be already initialized by USI_UARTInit.
+  * @param  Buf: ring buffer, cache line aligned.
+  * @param  Size: ring size in bytes, multiple of cache line size and less than 4096.
+  * @param  TimeOutCnt: rx idle time reported as end of a burst, unit: bit period.
+  * @param  Callback: called from ISR on idle line and on ring wrap with the current write count.
+  *         Bytes up to this count can be taken by USI_UARTRxRingPeek.
+  * @param  CbData: callback argument.
+  * @note   The ring owns USI_IRQ until USI_UARTRxRingDeInit.
+  * @retval TRUE/FLASE
+  */
+bool USI_UARTRxRingInit(
+	USI_UARTRxRingTypeDef *Ring,
+	u8 USIIndex,
+	u8 *Buf,
+	u32 Size,
+	u32 TimeOutCnt,
+	void (*Callback)(void *CbData, u32 Wr),
+	void *CbData
+)
+{
+	USI_TypeDef *USIx = USI_DEV_TABLE[USIIndex].USIx;
+	GDMA_InitTypeDef *GDMA_InitStruct = &Ring->Gdma;
+
+	assert_param(IS_ALL_USI_PERIPH(USIx));
+	assert_param((Size >= 2 * USI_UART_RX_RING_BURST) && (Size < 4096));
+
+	_memset((void *)Ring, 0, sizeof(USI_UARTRxRingTypeDef));
+	Ring->USIIndex = USIIndex;
+	Ring->Buf = Buf;
+	Ring->Size = Size;
+	Ring->Callback = Callback;
+	Ring->CbData = CbData;
+
+	Ring->GdmaChnl = GDMA_ChnlAlloc(0, (IRQ_FUN)USI_UARTRxRing_DmaIrq, (u32)Ring, 12);
+	if (Ring->GdmaChnl == 0xFF) {
+		/* No Available DMA channel */
+		return FALSE;
+	}
+
+	GDMA_InitStruct->GDMA_DIR = TTFCPeriToMem;
+	GDMA_InitStruct->GDMA_SrcHandshakeInterface = USI_DEV_TABLE[USIIndex].Rx_HandshakeInterface;
+	GDMA_InitStruct->GDMA_SrcAddr = (u32)&USIx->RX_FIFO_READ;
+	GDMA_InitStruct->GDMA_Index   = 0;
+	GDMA_InitStruct->GDMA_ChNum   = Ring->GdmaChnl;
+	GDMA_InitStruct->GDMA_IsrType = (BlockType | TransferType | ErrType);
+	GDMA_InitStruct->GDMA_SrcMsize = MsizeSixteen;
+	GDMA_InitStruct->GDMA_SrcDataWidth = TrWidthOneByte;
+	/* any ring offset can be the start of a block */
+	GDMA_InitStruct->GDMA_DstMsize = MsizeSixteen;
+	GDMA_InitStruct->GDMA_DstDataWidth = TrWidthOneByte;
+	GDMA_InitStruct->GDMA_DstInc = IncType;
+	GDMA_InitStruct->GDMA_SrcInc = NoChange;
+	GDMA_InitStruct->MaxMuliBlock = 1;
+
+	DCache_CleanInvalidate((u32)Buf, Size);
+
+	USI_UARTRxDMAModeConfig(USIx, USI_UART_RX_GDMA_IS_DMA_FLOW_CTRL);
+	USI_UARTRXDMAConfig(USIx, USI_UART_RX_RING_BURST);
+	USI_UARTRxTimeOutConfig(USIx, TimeOutCnt);
+	USI_UARTRxRing_Arm(Ring, 0);
+	USI_UARTRXDMACmd(USIx, ENABLE);
+
+	InterruptRegister((IRQ_FUN)USI_UARTRxRing_Irq, USI_DEV_TABLE[USIIndex].IrqNum, (u32)Ring, 10);
+	InterruptEn(USI_DEV_TABLE[USIIndex].IrqNum, 10);
+	USI_UARTINTConfig(USIx, USI_RX_FIFO_TIMEOUT_INTER, ENABLE);
+
+	return TRUE;
+}
+
+/**
+  * @brief  Stop USI UART RX ring and release its GDMA channel and USI interrupt.
+  * @param  Ring: ring started by USI_UARTRxRingInit.
+  * @retval None
+  */
+void USI_UARTRxRingDeInit(USI_UARTRxRingTypeDef *Ring)
+{
+	USI_TypeDef *USIx = USI_DEV_TABLE[Ring->USIIndex].USIx;
+
+	USI_UARTINTConfig(USIx, USI_RX_FIFO_TIMEOUT_INTER, DISABLE);
+	InterruptDis(USI_DEV_TABLE[Ring->USIIndex].IrqNum);
+	InterruptUnRegister(USI_DEV_TABLE[Ring->USIIndex].IrqNum);
+
+	USI_UARTRXDMACmd(USIx, DISABLE);
+	GDMA_Abort(0, Ring->GdmaChnl);
+	GDMA_ClearINT(0, Ring->GdmaChnl);
+	GDMA_ChnlFree(0, Ring->GdmaChnl);
+}
+
+/**
+  * @brief  Get the oldest unconsumed bytes of the ring without copying.
+  * @param  Ring: ring started by USI_UARTRxRingInit.
+  * @param  ppData: returns the address of the first unconsumed byte.
+  * @retval number of contiguous bytes at *ppData, which stops at the ring end.
+  */
+u32 USI_UARTRxRingPeek(USI_UARTRxRingTypeDef *Ring, u8 **ppData)
+{
+	u32 Rd = Ring->Rd;
+	u32 Pos = Rd % Ring->Size;
+	u32 Len = Ring->Wr - Rd;
+
+	if (Len > Ring->Size - Pos) {
+		Len = Ring->Size - Pos;
+	}
+
+	*ppData = Ring->Buf + Pos;
+	if (Len) {
+		DCache_Invalidate((u32)*ppData, Len);
+	}
+
+	return Len;
+}
+
+/**
+  * @brief  Mark bytes returned by USI_UARTRxRingPeek as consumed.
+  * @param  Ring: ring started by USI_UARTRxRingInit.
+  * @param  Len: number of bytes consumed.
+  * @note   If OverflowCnt changed since USI_UARTRxRingPeek, GDMA overwrote the oldest bytes
+  *         and the ring already skipped them, the peeked data may be partly newer than expected.
+  * @retval None
+  */
+void USI_UARTRxRingConsume(USI_UARTRxRingTypeDef *Ring, u32 Len)
+{
+	u32 PrevIrqStatus;
+
+	PrevIrqStatus = irq_disable_save();
+	Ring->Rd += MIN(Len, Ring->Wr - Ring->Rd);
+	irq_enable_restore(PrevIrqStatus);
+}
+
 /**
   * @brief  Fills USI_LPUARTInitStruct member low power rx path related with its default value.
   * @param  USI_LPUARTInitStruct: pointer to an USI_LPUARTInitTypeDef structure which will be initialized.
@@ -584,6 +584,24 @@ typedef struct {
 	u32 A1_Q;
 	u32 A2_Q;
 } CODEC_EQFilterCoef;
+
+/**
+ * @brief AUDIO_CODEC EQ band design Structure Definition
+ */
+typedef struct {
+	u32 Type;			/*!< Specifies the filter, a value of @ref AUDIO_CODEC_EQ_Filter_Type */
+	float Fc;			/*!< Center, corner or shelf midpoint frequency in Hz, below sr / 2 */
+	float Q;			/*!< Quality factor, 0.707 gives a Butterworth HPF/LPF and a maximally flat shelf */
+	float GainDb;		/*!< Boost or cut in dB, peaking and shelf only */
+} CODEC_EQBandParams;
+
+/**
+ * @brief AUDIO_CODEC EQ profile Structure Definition, all bands of one adc channel
+ */
+typedef struct {
+	u32 BandMask;						/*!< bit n enables band ADCEQBDn */
+	CODEC_EQFilterCoef Coef[5];			/*!< one per band, ADCEQBD0 ~ ADCEQBD4 */
+} CODEC_EQProfile;
 /**
   * @}
   */
@@ -787,6 +805,21 @@ typedef struct {
 * @}
 */
 
+/** @defgroup AUDIO_CODEC_EQ_Filter_Type
+  * @{
+  */
+#define CODEC_EQ_BYPASS						((u32)0x00000000)
+#define CODEC_EQ_PEAKING					((u32)0x00000001)
+#define CODEC_EQ_LOWSHELF					((u32)0x00000002)
+#define CODEC_EQ_HIGHSHELF					((u32)0x00000003)
+#define CODEC_EQ_HPF						((u32)0x00000004)
+#define CODEC_EQ_LPF						((u32)0x00000005)
+
+#define IS_CODEC_EQ_Filter_Type(TYPE) ((TYPE) <= CODEC_EQ_LPF)
+/**
+* @}
+*/
+
 /** @defgroup AUDIO_CODEC_Sample_Rate_Source
   * @{
   */
@@ -908,6 +941,9 @@ _LONG_CALL_ void AUDIO_CODEC_SetDmicSrc(u32 ad_chn, u32 dmic_num);
 _LONG_CALL_ void AUDIO_CODEC_SetADCEQClk(u32 ad_chn, u32 NewState);
 _LONG_CALL_ void AUDIO_CODEC_SetADCEQFilter(u32 ad_chn, u32 band_sel, CODEC_EQFilterCoef *EQFilterCoefPoint);
 _LONG_CALL_ void AUDIO_CODEC_SetADCEQBand(u32 ad_chn, u32 band_sel, u32 NewState);
+_LONG_CALL_ bool AUDIO_CODEC_DesignEQFilter(CODEC_EQBandParams *Band, u32 sr, CODEC_EQFilterCoef *EQFilterCoefPoint);
+_LONG_CALL_ bool AUDIO_CODEC_DesignEQProfile(CODEC_EQBandParams *Bands, u32 band_num, u32 sr, CODEC_EQProfile *Profile);
+_LONG_CALL_ void AUDIO_CODEC_LoadADCEQProfile(u32 ad_chn, CODEC_EQProfile *Profile);
 _LONG_CALL_ void AUDIO_CODEC_SetADCZDET(u32 adc_sel, u32 type);
 _LONG_CALL_ void AUDIO_CODEC_SetADCZDETTimeOut(u32 adc_sel, u32 time_out);
 _LONG_CALL_ void AUDIO_CODEC_Record(u32 i2s_sel, u32 type, I2S_InitTypeDef *I2S_InitStruct);
@@ -34,6 +34,12 @@
 #define I2S_CLOCK_XTAL40M	40000000
 
 #define PLL_CLOCK_MAX_NUM	    2
+
+#define AUDIO_DRIFT_TRIM_MAX_PPM	200		/* keep the trim far inside the PLL F0F range */
+#define AUDIO_DRIFT_OUTLIER_PPM		1000	/* larger errors are stalls or restarts, not drift */
+#define AUDIO_DRIFT_SETTLE_SEC		8		/* frame offset is paid back over this time */
+#define AUDIO_DRIFT_WINDOW_SEC		2		/* +-1 frame of counter is 10ppm over this time at 48k */
+#define AUDIO_DRIFT_CNT_MASK		0x07FFFFFF	/* SPORT frame counter width */
 /**
 * @}
 */
@@ -71,6 +77,29 @@ typedef struct {
 * @}
 */
 
+/** @defgroup AUDIO_DriftTypeDef
+  * @{
+  */
+
+typedef struct {
+	u32 Index;			/*!< SPORT index */
+	u32 Direction;		/*!< SP_DIR_TX or SP_DIR_RX */
+	u32 Clock;			/*!< audio clock the SPORT runs from, see Audio_Clock_Choose */
+	u32 SampleRate;		/*!< nominal sample rate */
+	u32 RefHz;			/*!< tick rate of the reference timestamp */
+	u32 LastCnt;		/*!< SPORT down counter at the previous update, in frames */
+	u32 LastRef;		/*!< reference timestamp at the previous update */
+	u32 Started;		/*!< 0: no baseline, 1: baseline taken, 2: rate estimated */
+	u32 RejectCnt;		/*!< updates dropped as outliers */
+	float HwPpm;		/*!< filtered rate error of the untrimmed clock */
+	float Offset;		/*!< SPORT frames ahead (+) or behind (-) the reference */
+	float TrimPpm;		/*!< trim in effect on the PLL */
+	float ResamplePpm;	/*!< correction left to a resampler when the clock can not be trimmed */
+} AUDIO_DriftTypeDef;
+/**
+* @}
+*/
+
 /**
 * @}
 */
@@ -80,8 +109,12 @@ typedef struct {
   * @{
   */
 
+bool Audio_Clock_SportNiMi(u32 clock, u32 sr, u32 chn_len, u32 chn_cnt, u32 *ni, u32 *mi);
 bool is_sport_ni_mi_supported(u32 clock, u32 sr, u32 chn_len, u32 chn_cnt);
 void Audio_Clock_Choose(u32 clock_sel, AUDIO_InitParams *initparams, AUDIO_ClockParams *params);
+void Audio_Clock_DriftInit(AUDIO_DriftTypeDef *Drift, u32 Index, u32 Direction, u32 Clock, u32 SampleRate, u32 RefHz);
+void Audio_Clock_DriftDeInit(AUDIO_DriftTypeDef *Drift);
+float Audio_Clock_DriftUpdate(AUDIO_DriftTypeDef *Drift, u32 RefTick);
 /**
 * @}
 */
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AMEBA_AUDIO_DMIC_H_
+#define _AMEBA_AUDIO_DMIC_H_
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup AUDIO
+  * @brief AUDIO driver modules
+  * @{
+  */
+
+/** @defgroup AUDIO_DMIC
+* @brief AUDIO_DMIC voice gated capture modules
+* @verbatim
+  *****************************************************************************************
+  * How to use DMIC capture
+  *****************************************************************************************
+  *	1. Enable the codec and SPORT clocks, set the DMIC pins, and AUDIO_SP_Init the
+  *	   internal SPORT for RX with 16 bit words.
+  *
+  *	2. AUDIO_DMIC_CodecInit(I2S0, &I2S_InitStruct, DMIC_1P25M, 2) sets up the DMIC record
+  *	   path, its DMIC clock and the ADC HPF.
+  *
+  *	3. AUDIO_DMIC_VADStructInit(&Params), adjust Params if needed, then
+  *	   AUDIO_DMIC_CaptureInit(...) starts the GDMA ring and the SPORT.
+  *
+  *	Every period is analysed in the GDMA interrupt by a fixed-point energy and
+  *	zero crossing VAD. The callback only runs while speech is present, so the
+  *	application task can block, and the CPU sleep, between voice events.
+  *
+  *****************************************************************************************
+  * @endverbatim
+* @{
+*/
+
+/* Exported constants ------------------------------------------------------------*/
+/** @defgroup AUDIO_DMIC_Exported_Constants AUDIO_DMIC Exported Constants
+  * @{
+  */
+
+/** @defgroup AUDIO_DMIC_VAD_State
+  * @{
+  */
+#define AUDIO_DMIC_VAD_IDLE		((u32)0x00000000)	/* no speech, nothing to deliver */
+#define AUDIO_DMIC_VAD_START	((u32)0x00000001)	/* speech begins with this period */
+#define AUDIO_DMIC_VAD_SPEECH	((u32)0x00000002)	/* speech goes on */
+#define AUDIO_DMIC_VAD_END		((u32)0x00000003)	/* speech ends after this period */
+/**
+  * @}
+  */
+
+/**
+* @}
+*/
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup AUDIO_DMIC_Exported_Types AUDIO_DMIC Exported Types
+  * @{
+  */
+
+/**
+  * @brief  AUDIO_DMIC capture callback, Event is AUDIO_DMIC_VAD_START, AUDIO_DMIC_VAD_SPEECH
+  *         with a period of Pcm, or AUDIO_DMIC_VAD_END with Pcm NULL.
+  */
+typedef void (*AUDIO_DMIC_CB)(void *CbData, u32 Event, s16 *Pcm, u32 Frames);
+
+/**
+  * @brief  AUDIO_DMIC VAD parameters Structure Definition
+  */
+typedef struct {
+	u32 OnRatio;		/*!< Q4 energy over the noise floor for an active period, 64 is 6dB */
+	u32 MinEnergy;		/*!< mean square below which a period is never active */
+	u32 ZcrMax;			/*!< zero crossings per 256 frames above which a period can not start speech */
+	u32 OnsetNum;		/*!< active periods in a row to start speech */
+	u32 HangoverNum;	/*!< inactive periods before speech ends */
+	u32 PreRollNum;		/*!< periods from before the onset delivered on start */
+} AUDIO_DMIC_VADParams;
+
+/**
+  * @brief  AUDIO_DMIC VAD Structure Definition
+  */
+typedef struct {
+	AUDIO_DMIC_VADParams Params;
+	u32 ChnCnt;			/*!< interleaved channels, channel 0 is analysed */
+	u32 PeriodFrames;
+	u32 Floor;			/*!< noise floor as mean square, 0 before the first period */
+	u32 Energy;			/*!< mean square of the last period */
+	u32 Zcr;			/*!< zero crossings per 256 frames of the last period */
+	s16 LastSample;
+	u32 ActiveCnt;		/*!< active periods in a row */
+	u32 Hangover;		/*!< inactive periods left before speech ends */
+	u32 Speech;
+} AUDIO_DMIC_VADTypeDef;
+
+/**
+  * @brief  AUDIO_DMIC capture Structure Definition
+  */
+typedef struct {
+	AUDIO_SP_StreamTypeDef Stream;
+	AUDIO_DMIC_VADTypeDef Vad;
+	AUDIO_DMIC_CB Callback;
+	void *CbData;
+	u32 PeriodCnt;		/*!< periods analysed, bounds the pre-roll right after start */
+} AUDIO_DMIC_CaptureTypeDef;
+
+/**
+* @}
+*/
+
+/* Exported functions ------------------------------------------------------------*/
+/** @defgroup AUDIO_DMIC_Exported_Functions AUDIO_DMIC Exported Functions
+  * @{
+  */
+
+void AUDIO_DMIC_CodecInit(u32 i2s_sel, I2S_InitTypeDef *I2S_InitStruct, u32 dmic_clk, u32 hpf_fc);
+void AUDIO_DMIC_VADStructInit(AUDIO_DMIC_VADParams *Params);
+void AUDIO_DMIC_VADInit(AUDIO_DMIC_VADTypeDef *Vad, AUDIO_DMIC_VADParams *Params, u32 ChnCnt, u32 PeriodFrames);
+u32 AUDIO_DMIC_VADProcess(AUDIO_DMIC_VADTypeDef *Vad, const s16 *Pcm);
+bool AUDIO_DMIC_CaptureInit(AUDIO_DMIC_CaptureTypeDef *Capture, u32 Index, u32 SelGDMA, u32 ChnCnt, u8 *Buf,
+							u32 PeriodBytes, u32 PeriodNum, struct GDMA_CH_LLI *Lli, AUDIO_DMIC_VADParams *Params,
+							AUDIO_DMIC_CB Callback, void *CbData);
+void AUDIO_DMIC_CaptureDeInit(AUDIO_DMIC_CaptureTypeDef *Capture);
+/**
+* @}
+*/
+
+/** @} */
+
+/** @} */
+
+/** @} */
+
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AMEBA_AUDIO_FMT_H_
+#define _AMEBA_AUDIO_FMT_H_
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup AUDIO
+  * @brief AUDIO driver modules
+  * @{
+  */
+
+/** @defgroup AUDIO_FMT
+* @brief AUDIO_FMT sample format conversion modules
+* @verbatim
+  *****************************************************************************************
+  * Sample formats
+  *****************************************************************************************
+  *	- s16: signed 16 bit sample in s16.
+  *	- s24: signed 24 bit sample in the low 24 bits of s32, sign extended, as SPORT
+  *	  moves 24 bit words.
+  *	- s32: signed 32 bit sample, full scale.
+  *	- float: -1.0 ~ 1.0 full scale.
+  *	- Interleaved stereo s16 is L in the low half word and R in the high half word.
+  *
+  *	Narrowing conversions round to nearest and saturate. s16 buffers of the paired
+  *	(SIMD) kernels should be 4 bytes aligned.
+  *
+  *****************************************************************************************
+  * @endverbatim
+* @{
+*/
+
+/* Exported constants ------------------------------------------------------------*/
+/** @defgroup AUDIO_FMT_Exported_Constants AUDIO_FMT Exported Constants
+  * @{
+  */
+
+#define AUDIO_FMT_GAIN_UNITY	0x1000		/* gain is Q3.12, up to 8x */
+#define AUDIO_FMT_RESAMPLE_CHN_MAX	8
+#define AUDIO_FMT_RESAMPLE_PPM_MAX	1000		/* output may hold up to 2 frames more than the input */
+/**
+* @}
+*/
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup AUDIO_FMT_Exported_Types AUDIO_FMT Exported Types
+  * @{
+  */
+
+/** @defgroup AUDIO_FMT_ResampleTypeDef
+  * @brief Fractional resampler for small rate corrections, linear interpolation.
+  * @{
+  */
+typedef struct {
+	u32 ChnCnt;
+	u64 Step;		/*!< input frames per output frame, Q32 */
+	u64 Pos;		/*!< Q32 position, 0 is the last frame of the previous block */
+	s16 Last[AUDIO_FMT_RESAMPLE_CHN_MAX];
+} AUDIO_FMT_ResampleTypeDef;
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+/* Exported functions ------------------------------------------------------------*/
+/** @defgroup AUDIO_FMT_Exported_Functions AUDIO_FMT Exported Functions
+  * @{
+  */
+
+void AUDIO_FMT_S16ToS32(s32 *dst, const s16 *src, u32 num);
+void AUDIO_FMT_S32ToS16(s16 *dst, const s32 *src, u32 num);
+void AUDIO_FMT_S16ToS24(s32 *dst, const s16 *src, u32 num);
+void AUDIO_FMT_S24ToS16(s16 *dst, const s32 *src, u32 num);
+void AUDIO_FMT_S24ToS32(s32 *dst, const s32 *src, u32 num);
+void AUDIO_FMT_S32ToS24(s32 *dst, const s32 *src, u32 num);
+void AUDIO_FMT_S16ToFloat(float *dst, const s16 *src, u32 num);
+void AUDIO_FMT_FloatToS16(s16 *dst, const float *src, u32 num);
+void AUDIO_FMT_S32ToFloat(float *dst, const s32 *src, u32 num);
+void AUDIO_FMT_FloatToS32(s32 *dst, const float *src, u32 num);
+void AUDIO_FMT_MonoToStereoS16(s16 *dst, const s16 *src, u32 frames);
+void AUDIO_FMT_StereoToMonoS16(s16 *dst, const s16 *src, u32 frames, s16 gain_l, s16 gain_r);
+void AUDIO_FMT_DeinterleaveS16(s16 *const *dst, const s16 *src, u32 chn_cnt, u32 frames);
+void AUDIO_FMT_DeinterleaveS32(s32 *const *dst, const s32 *src, u32 chn_cnt, u32 frames);
+void AUDIO_FMT_InterleaveS16(s16 *dst, const s16 *const *src, u32 chn_cnt, u32 frames);
+void AUDIO_FMT_GainS16(s16 *dst, const s16 *src, u32 num, u32 gain);
+void AUDIO_FMT_MixS16(s16 *dst, const s16 *src, u32 num);
+void AUDIO_FMT_ResampleInit(AUDIO_FMT_ResampleTypeDef *State, u32 chn_cnt);
+void AUDIO_FMT_ResampleSetPpm(AUDIO_FMT_ResampleTypeDef *State, float ppm);
+u32 AUDIO_FMT_ResampleS16(AUDIO_FMT_ResampleTypeDef *State, s16 *dst, const s16 *src, u32 frames);
+/**
+* @}
+*/
+
+/** @} */
+
+/** @} */
+
+/** @} */
+
+
+#endif
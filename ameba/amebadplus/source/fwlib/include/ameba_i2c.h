@@ -726,6 +726,46 @@ typedef struct {
 	I2C_TypeDef *I2Cx;
 } I2C_IntModeCtrl;
 
+/**
+  * @brief  I2C Queued Message Structure Definition
+  */
+typedef struct {
+	u16 Addr;		/*!< Slave address of this message. */
+	u16 Flags;		/*!< I2C_MSG_RD for read, 0 for write. */
+	u32 Len;		/*!< Number of bytes, must not be 0. */
+	u8 *Buf;		/*!< Data buffer. */
+} I2C_MsgTypeDef;
+
+/**
+  * @brief  I2C Queued Transaction Structure Definition
+  */
+typedef struct I2C_XferTypeDef {
+	struct I2C_XferTypeDef *Next;	/*!< Link used by the queue, no need to set. */
+	I2C_MsgTypeDef *Msgs;		/*!< Messages joined by RESTART, the last one ends with STOP. */
+	u32 MsgNum;			/*!< Number of messages. */
+	void (*Callback)(void *CbData, s32 Status);	/*!< Called from ISR with RTK_SUCCESS or RTK_FAIL. */
+	void *CbData;			/*!< Callback argument. */
+} I2C_XferTypeDef;
+
+/**
+  * @brief  I2C Transaction Queue Structure Definition
+  */
+typedef struct {
+	u32 Index;		/*!< I2C index. */
+	I2C_TypeDef *I2Cx;
+	u32 DmaThreshold;	/*!< Messages of at least this many bytes use GDMA, 0 never uses GDMA. */
+	u8 GdmaChnl;
+	u8 State;
+	u8 DmaPrev;
+	volatile u8 Busy;
+	I2C_XferTypeDef *volatile Head;
+	I2C_XferTypeDef *Tail;
+	u32 MsgIdx;
+	u32 TxPos;
+	u32 RxPos;
+	GDMA_InitTypeDef Gdma;
+} I2C_QueueTypeDef;
+
 /**
   * @brief  I2C dev Table Definition
   */
@@ -863,6 +903,12 @@ _LONG_CALL_ void I2C_DmaMode2Config(I2C_TypeDef *I2Cx, u32 I2C_DmaCmd, u32 I2C_D
 _LONG_CALL_ bool I2C_TXGDMA_Init(u8 Index, GDMA_InitTypeDef *GDMA_InitStruct, void *CallbackData, IRQ_FUN CallbackFunc, u8 *pTxBuf, int TxCount);
 _LONG_CALL_ bool I2C_RXGDMA_Init(u8 Index, GDMA_InitTypeDef *GDMA_InitStruct, void *CallbackData, IRQ_FUN CallbackFunc, u8 *pRxBuf, int RxCount);
 
+/* I2C_Exported_Queue_Functions I2C Exported Queue Functions */
+_LONG_CALL_ bool I2C_QueueInit(I2C_QueueTypeDef *Queue, u32 Index, u32 DmaThreshold, u32 IrqPriority);
+_LONG_CALL_ void I2C_QueueDeInit(I2C_QueueTypeDef *Queue);
+_LONG_CALL_ u32 I2C_QueueSubmit(I2C_QueueTypeDef *Queue, I2C_XferTypeDef *Xfer);
+_LONG_CALL_ u32 I2C_QueueBusy(I2C_QueueTypeDef *Queue);
+
 
 /* Other Definitions --------------------------------------------------------*/
 #if 1
@@ -887,6 +933,8 @@ extern u32 IC_FS_SCL_LCNT_TRIM;
 #define I2C_EARLY_RX_DONE 			-1
 #define I2C_TRX_BUFFER_DEPTH 16
 #define I2C_POLL_TIMEOUT_MS  1000
+#define I2C_MSG_RD			BIT(0)
+#define I2C_QUEUE_DMA_MAX	4096
 
 
 #endif
@@ -293,6 +293,8 @@ u32 IPC_INTRequest(IPC_TypeDef *IPCx, u8 IPC_ChNum);
 u32 IPC_INTGet(IPC_TypeDef *IPCx);
 void IPC_INTClear(IPC_TypeDef *IPCx, u8 IPC_Shiftbit);
 u32 IPC_INTHandler(void *Data);
+void IPC_INTStatCmd(u32 NewState);
+void IPC_INTGetStat(u8 IPC_Shiftbit, u32 *Count, u32 *MaxTime);
 void IPC_INTUserHandler(IPC_TypeDef *IPCx, u8 IPC_Shiftbit, void *IrqHandler, void *IrqData);
 IPC_TypeDef *IPC_GetDev(u32 IPC_Dir, u32 Is_Rx);
 IPC_TypeDef *IPC_GetDevById(u32 cpu_id);
@@ -15,6 +15,22 @@
   * @brief IPC driver modules
 * @{
 */
+/* same as CACHE_LINE_SIZE, ameba_cache.h is included after this file */
+#define IPC_RING_LINE_SIZE			32
+/* max number of buffers in one IPC buffer pool */
+#define IPC_POOL_MAX_BUF			32
+/* max number of arguments of one IPC RPC call, keeps IPC_RPC_CALL in one cache line */
+#define IPC_RPC_MAX_ARGS			4
+/* IPC_wait_idle spins for twice the average peer response time, bounded by these, then blocks */
+#ifndef IPC_WAIT_SPIN_MIN_US
+#define IPC_WAIT_SPIN_MIN_US		5
+#endif
+#ifndef IPC_WAIT_SPIN_MAX_US
+#define IPC_WAIT_SPIN_MAX_US		200
+#endif
+/* number of buckets of IPC_wait_idle wait time histogram */
+#define IPC_WAIT_HIST_NUM			8
+
 /* Exported types --------------------------------------------------------*/
 /** @addtogroup IPC_Exported_Types IPC Exported Types
   * @{
@@ -28,6 +44,83 @@ typedef struct ipc_msg_struct {
 	u32 msg_len;
 	u32 rsvd;
 } IPC_MSG_STRUCT, *PIPC_MSG_STRUCT, ipc_msg_struct_t;
+
+/**
+  * @brief IPC Message Ring Definition
+  * @note SPSC ring in shared memory, head is only written by the sender and tail only by the
+  *	receiver, each in its own cache line. Use IPC_RING_SIZE to size the memory.
+ */
+typedef struct ipc_ring_struct {
+	volatile u32 head;
+	u32 depth;
+	u32 rsvd0[IPC_RING_LINE_SIZE / sizeof(u32) - 2];
+	volatile u32 tail;
+	u32 rsvd1[IPC_RING_LINE_SIZE / sizeof(u32) - 1];
+	IPC_MSG_STRUCT msg[];
+} IPC_RING_STRUCT, *PIPC_RING_STRUCT;
+
+/**
+  * @brief IPC Buffer Pool Definition
+  * @note Header of a shared memory pool, buffers follow it. owner[i] tells which core
+  *	may touch buffer i, it is only changed under IPC_SEM_POOL.
+  *	The pool functions mask irq while they hold IPC_SEM_POOL, so they can be called from
+  *	interrupt handlers too.
+ */
+typedef struct ipc_pool_struct {
+	u32 buf_size;
+	u32 buf_num;
+	u32 violation;
+	u8 owner[IPC_POOL_MAX_BUF];
+	u32 rsvd[5];
+} IPC_POOL_STRUCT, *PIPC_POOL_STRUCT;
+
+/**
+  * @brief IPC RPC Function Definition
+ */
+typedef u32(*IPC_RPC_FUN)(u32 *args, u32 argc);
+
+/**
+  * @brief IPC RPC Function Table Entry Definition
+ */
+typedef struct ipc_rpc_entry {
+	u32 func_id;
+	IPC_RPC_FUN func;
+} IPC_RPC_ENTRY;
+
+/**
+  * @brief IPC RPC Call Frame Definition
+  * @note One cache line, lives in memory both cores can access. Written by the caller until
+  *	it is submitted and by the callee until state becomes IPC_RPC_DONE or IPC_RPC_NO_FUNC.
+ */
+typedef struct ipc_rpc_call {
+	u16 func_id;
+	u16 argc;
+	u32 args[IPC_RPC_MAX_ARGS];
+	u32 ret;
+	volatile u32 state;
+	u32 issue_time;
+} IPC_RPC_CALL, *PIPC_RPC_CALL;
+
+/**
+  * @brief IPC RPC Statistics Definition
+ */
+typedef struct ipc_rpc_stat {
+	u32 calls;				/*!< Number of completed calls. */
+	u32 ring_full;			/*!< Times the request ring was full on submit. */
+	u32 doorbell_timeout;	/*!< Calls queued whose doorbell timed out, they still run. */
+	u32 latency_total;		/*!< Sum of round-trip latency in us, average = latency_total / calls. */
+	u32 latency_max;		/*!< Max round-trip latency in us. */
+} IPC_RPC_STAT;
+
+/**
+  * @brief IPC RPC Channel Definition
+ */
+typedef struct ipc_rpc_struct {
+	u32 IPC_Dir;
+	u8 IPC_ChNum;
+	PIPC_RING_STRUCT IPC_Ring;
+	IPC_RPC_STAT stat;
+} IPC_RPC_STRUCT, *PIPC_RPC_STRUCT;
 /**
   * @}
   */
@@ -45,6 +138,37 @@ typedef struct ipc_msg_struct {
 #define IPC_SEND_SUCCESS 0
 #define IPC_SEND_TIMEOUT 1
 #define IPC_SEMA_MAX_DELAY			0xFFFFFFFF
+#define IPC_RING_FULL    4
+#define IPC_POOL_NOT_OWNER 5
+/**
+  * @}
+  */
+
+/** @defgroup IPC_RING_SIZE
+  * @{
+  */
+#define IPC_RING_SIZE(depth)		(sizeof(IPC_RING_STRUCT) + (depth) * sizeof(IPC_MSG_STRUCT))
+/**
+  * @}
+  */
+
+/** @defgroup IPC_POOL_Owner
+  * @{
+  */
+#define IPC_POOL_FREE				0
+#define IPC_POOL_OWNER(cpu_id)		((u8)((cpu_id) + 1))
+#define IPC_POOL_SIZE(size, num)	(sizeof(IPC_POOL_STRUCT) + (size) * (num))
+/**
+  * @}
+  */
+
+/** @defgroup IPC_RPC_State
+  * @{
+  */
+#define IPC_RPC_IDLE				0
+#define IPC_RPC_PENDING				1
+#define IPC_RPC_DONE				2
+#define IPC_RPC_NO_FUNC				3
 /**
   * @}
   */
@@ -60,9 +184,39 @@ typedef struct ipc_msg_struct {
 void ipc_table_init(IPC_TypeDef *IPCx);
 u32 ipc_send_message(u32 IPC_Dir, u8 IPC_ChNum, PIPC_MSG_STRUCT IPC_Msg);
 PIPC_MSG_STRUCT ipc_get_message(u32 IPC_Dir, u8 IPC_ChNum);
+void ipc_ring_init(PIPC_RING_STRUCT IPC_Ring, u32 Depth);
+u32 ipc_ring_send(u32 IPC_Dir, u8 IPC_ChNum, PIPC_RING_STRUCT IPC_Ring, PIPC_MSG_STRUCT IPC_Msg);
+PIPC_RING_STRUCT ipc_ring_get(u32 IPC_Dir, u8 IPC_ChNum);
+u32 ipc_ring_recv(PIPC_RING_STRUCT IPC_Ring, PIPC_MSG_STRUCT IPC_Msg);
+void ipc_pool_init(PIPC_POOL_STRUCT IPC_Pool, u32 BufSize, u32 BufNum);
+void *ipc_pool_alloc(PIPC_POOL_STRUCT IPC_Pool);
+u32 ipc_pool_send(u32 IPC_Dir, u8 IPC_ChNum, PIPC_POOL_STRUCT IPC_Pool, void *Buf, u32 Len);
+void *ipc_pool_recv(u32 IPC_Dir, u8 IPC_ChNum, PIPC_POOL_STRUCT *IPC_Pool, u32 *Len);
+u32 ipc_pool_free(PIPC_POOL_STRUCT IPC_Pool, void *Buf);
+void ipc_rpc_register(const IPC_RPC_ENTRY *Table, u32 Num);
+void ipc_rpc_init(PIPC_RPC_STRUCT IPC_Rpc, u32 IPC_Dir, u8 IPC_ChNum, PIPC_RING_STRUCT IPC_Ring, u32 Depth);
+u32 ipc_rpc_submit(PIPC_RPC_STRUCT IPC_Rpc, PIPC_RPC_CALL Calls, u32 Num);
+u32 ipc_rpc_poll(PIPC_RPC_STRUCT IPC_Rpc, PIPC_RPC_CALL Call);
+u32 ipc_rpc_call(PIPC_RPC_STRUCT IPC_Rpc, PIPC_RPC_CALL Call, u32 *Ret, u32 Timeout);
+void ipc_rpc_serve(u32 IPC_Dir, u8 IPC_ChNum);
 
 void IPC_TXHandler(void *Data, u32 IrqStatus, u32 ChanNum);
+u32 IPC_wait_idle(IPC_TypeDef *IPCx, u32 IPC_ChNum);
+u32 IPC_wait_idle_GetStat(u8 IPC_ChNum, u32 *Hist);
 extern IPC_IRQ_FUN IPC_IrqHandler[IPC_CHANNEL_NUM];
 
+/**
+  * @brief  Bucket of a log2 latency histogram with BucketNum buckets.
+  * @note   Bucket 0 counts latencies under 8us, bucket i [8us << (i - 1), 8us << i), the last
+  *		bucket all longer ones.
+  * @retval bucket index.
+  */
+__STATIC_INLINE u32 IPC_HistBucket(u32 Us, u32 BucketNum)
+{
+	u32 idx = 32 - __CLZ(Us >> 3);
+
+	return (idx < BucketNum) ? idx : (BucketNum - 1);
+}
+
 
 #endif
\ No newline at end of file
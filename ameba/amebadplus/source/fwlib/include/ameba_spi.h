@@ -518,6 +518,71 @@ typedef struct {
 	IRQn_Type IrqNum;
 } SPI_DevTable;
 
+/**
+  * @brief  SPI Queued Transaction Structure Definition
+  */
+typedef void (*SSI_XFER_CB)(void *CbData, u32 Status);
+
+typedef struct SSI_XferTypeDef {
+	struct SSI_XferTypeDef *Next;	/*!< Link used by the queue, no need to set. */
+
+	u8 CmdLen;		/*!< Number of command frames sent first, 0 or 1. */
+	u8 Cmd;			/*!< Command frame value. */
+	u8 AddrLen;		/*!< Number of address frames sent after Cmd, 0~4, MSB first. */
+	u8 CsHold;		/*!< Keep CS asserted after this transaction, so the next one continues it. */
+	u32 Addr;		/*!< Address value. */
+
+	u32 DataFrameSize;	/*!< Frame size for this transaction, a value of @ref SPI_Data_Frame_Size.
+				     0 keeps the current frame size. */
+	u8 *TxData;		/*!< Data phase Tx buffer, NULL sends zero frames. */
+	u8 *RxData;		/*!< Data phase Rx buffer, NULL drops received data. */
+	u32 Length;		/*!< Data phase length in bytes. */
+
+	SSI_XFER_CB Callback;	/*!< Called on completion with RTK_SUCCESS or RTK_FAIL. */
+	void *CbData;		/*!< Callback argument. */
+} SSI_XferTypeDef;
+
+typedef struct {
+	u32 Index;		/*!< SPI index, 0 or 1. */
+	u32 PollThreshold;	/*!< Data phases shorter than this (bytes) are done by polling. */
+	void (*CsCtrl)(u32 Index, u32 Assert);	/*!< Optional GPIO CS control, NULL uses hardware SS. */
+
+	u8 TxChnl;
+	u8 RxChnl;
+	u8 CsActive;
+	volatile u8 Busy;
+	SSI_XferTypeDef *volatile Head;
+	SSI_XferTypeDef *Tail;
+
+	GDMA_InitTypeDef TxGdma;
+	GDMA_InitTypeDef RxGdma;
+	u32 TxDummy;	/* zero frames of Tx-less transactions */
+	u32 RxDummy;	/* sink of Rx-less transactions, apart so it never feeds TX */
+} SSI_QueueTypeDef;
+
+/**
+  * @brief  SPI Slave Rx Ring Structure Definition
+  */
+typedef void (*SSI_RX_RING_CB)(void *CbData, u8 *Buf, u32 Len);
+
+typedef struct {
+	u32 Index;		/*!< SPI index, 0 or 1. */
+	u8 **Buf;		/*!< BufNum buffers of BufSize bytes, cache line aligned. */
+	u32 BufNum;		/*!< Number of buffers, at least 2. */
+	u32 BufSize;		/*!< Buffer size in bytes. */
+	struct GDMA_CH_LLI *Lli;	/*!< BufNum LLI nodes owned by the ring. */
+	SSI_RX_RING_CB Callback;	/*!< Called from ISR for each filled buffer, NULL to use SSI_SlaveRxRingGet. */
+	void *CbData;		/*!< Callback argument. */
+
+	GDMA_InitTypeDef Gdma;
+	volatile u32 Done;	/*!< Buffers filled by GDMA. */
+	volatile u32 Taken;	/*!< Buffers handed to the application. */
+	volatile u32 Freed;	/*!< Buffers given back by the application. */
+
+	u32 OverrunCnt;		/*!< Rx FIFO overflow events seen. */
+	u32 LateCnt;		/*!< Buffers overwritten before the application released them. */
+} SSI_SlaveRxRingTypeDef;
+
 /**
   * @}
   */
@@ -648,6 +713,7 @@ _LONG_CALL_ u32 SSI_GetIsr(SPI_TypeDef *spi_dev);
 _LONG_CALL_ u32 SSI_ReadData(SPI_TypeDef *spi_dev);
 _LONG_CALL_ u32 SSI_ReceiveData(SPI_TypeDef *spi_dev, void *RxData, u32 Length);
 _LONG_CALL_ u32 SSI_SendData(SPI_TypeDef *spi_dev, void *TxData, u32 Length, u32 Role);
+_LONG_CALL_ u32 SSI_TransferFullDuplex(SPI_TypeDef *spi_dev, const void *TxData, void *RxData, u32 Length);
 _LONG_CALL_ u32 SSI_GetRawIsr(SPI_TypeDef *spi_dev);
 _LONG_CALL_ u32 SSI_GetSlaveEnable(SPI_TypeDef *spi_dev);
 _LONG_CALL_ void SSI_SlaveOutputEnable(SPI_TypeDef *spi_dev, u32 Status);
@@ -671,6 +737,15 @@ _LONG_CALL_ bool SSI_RXGDMA_Init(u8 Index, GDMA_InitTypeDef *GDMA_InitStruct, vo
 								 IRQ_FUN CallbackFunc, u8  *pRxData, u32 Length);
 _LONG_CALL_ void SSI_SetDmaEnable(SPI_TypeDef *spi_dev, u32 newState, u32 Mask);
 _LONG_CALL_ void SSI_SetDmaLevel(SPI_TypeDef *spi_dev, u32 TxLeve, u32 RxLevel);
+_LONG_CALL_ bool SSI_QueueInit(SSI_QueueTypeDef *Queue, u32 Index, u32 PollThreshold, void (*CsCtrl)(u32 Index, u32 Assert));
+_LONG_CALL_ void SSI_QueueDeInit(SSI_QueueTypeDef *Queue);
+_LONG_CALL_ u32 SSI_QueueSubmit(SSI_QueueTypeDef *Queue, SSI_XferTypeDef *Xfer);
+_LONG_CALL_ u32 SSI_QueueBusy(SSI_QueueTypeDef *Queue);
+_LONG_CALL_ bool SSI_SlaveRxRingInit(SSI_SlaveRxRingTypeDef *Ring, u32 Index, u8 **Buf, u32 BufNum, u32 BufSize,
+									 struct GDMA_CH_LLI *Lli, SSI_RX_RING_CB Callback, void *CbData);
+_LONG_CALL_ void SSI_SlaveRxRingStop(SSI_SlaveRxRingTypeDef *Ring);
+_LONG_CALL_ u8 *SSI_SlaveRxRingGet(SSI_SlaveRxRingTypeDef *Ring);
+_LONG_CALL_ void SSI_SlaveRxRingRelease(SSI_SlaveRxRingTypeDef *Ring);
 
 
 
@@ -863,6 +863,35 @@ typedef enum _FLASH_REGION_TYPE_ {
 	USER  =   	7,
 } FLASH_REGION_TYPE, *PFLASH_REGION_TYPE;
 
+/**
+  * @brief  FLASH Bulk Read Statistics Structure Definition
+  */
+typedef struct {
+	u32 xip_read_cnt;			/*!< Number of reads served by memcpy from the XIP window. */
+	u32 xip_read_bytes;			/*!< Bytes read through the XIP window. */
+	u32 xip_line_fills;			/*!< Cache lines touched by XIP reads, upper bound of cache misses (and evictions) caused. */
+	u32 xip_read_ticks;			/*!< SYSTIMER ticks (31us) spent in XIP reads. */
+	u32 direct_read_cnt;		/*!< Number of reads served by GDMA or SPIC user mode, bypassing the cache, failed ones are not counted. */
+	u32 direct_read_bytes;		/*!< Bytes read bypassing the cache. */
+	u32 direct_read_ticks;		/*!< SYSTIMER ticks (31us) spent in direct reads. */
+	u32 user_mode_fallback;		/*!< Direct reads done in SPIC user mode because no GDMA channel was free. */
+} FLASH_ReadStatTypeDef;
+
+/**
+  * @brief  FLASH Write Buffer Statistics Structure Definition
+  */
+typedef struct {
+	u32 write_cnt;				/*!< Number of FLASH_WriteStreamBuffered calls. */
+	u32 put_cnt;				/*!< FLASH_Write_Lock needed without the buffer, one per page a write touches, one per bypassing write. */
+	u32 bytes_buffered;			/*!< Bytes merged in the page buffer. */
+	u32 flush_cnt;				/*!< Number of FLASH_Write_Lock taken, put_cnt - flush_cnt locks are saved. */
+	u32 flush_full;				/*!< Flushes because the page is full. */
+	u32 flush_switch;			/*!< Flushes because another page is written. */
+	u32 flush_sync;				/*!< Flushes by FLASH_WriteBufferSync. */
+	u32 flush_timeout;			/*!< Flushes because the timeout expired. */
+	u32 flush_bypass;			/*!< Flushes before a write that bypasses the buffer. */
+} FLASH_WriteBufStatTypeDef;
+
 /**
   * @}
   */
@@ -1041,12 +1070,23 @@ _LONG_CALL_ void FLASH_CalibrationPLLPS_Shift(u32 phase_sel);
 
 _LONG_CALL_ int FLASH_WriteStream(u32 address, u32 len, u8 *data);
 _LONG_CALL_ int FLASH_ReadStream(u32 address, u32 len, u8 *data);
+int FLASH_ReadStreamBulk(u32 address, u32 len, u8 *data);
+void FLASH_GetReadStats(FLASH_ReadStatTypeDef *stats);
+void FLASH_ClearReadStats(void);
+
+/* FLASH_WriteBuffer_Functions FLASH Write Buffer Functions */
+int FLASH_WriteBufferInit(u32 timeout_ms, void (*flush_hook)(u32 address, u32 len));
+int FLASH_WriteStreamBuffered(u32 address, u32 len, u8 *data);
+int FLASH_WriteBufferSync(void);
+int FLASH_WriteBufferPoll(void);
+u32 FLASH_WriteBufferPending(u32 *address);
+void FLASH_WriteBufferGetStats(FLASH_WriteBufStatTypeDef *stats);
 
 
 /* FLASH_XIP_Functions FLASH XIP Functions
   * @note These functions will lock cpu when exec to forbit XIP, and flush cache after exec.
   */
-void FLASH_Write_Lock(void);
+int FLASH_Write_Lock(void);
 void FLASH_Write_Unlock(void);
 void FLASH_RxCmdXIP(u8 cmd, u32 read_len, u8 *read_data);
 void FLASH_SetStatusXIP(u8 Cmd, u32 Len, u8 *Status);
@@ -1054,12 +1094,35 @@ void FLASH_SetStatusBitsXIP(u32 SetBits, u32 NewState);
 void FLASH_TxDataXIP(u32 StartAddr, u32 DataPhaseLen, u8 *pData);
 void FLASH_EraseXIP(u32 EraseType, u32 Address);
 void FLASH_Write_IPC_Int(void *Data, u32 IrqStatus, u32 ChanNum);
+void FLASH_Write_StepTick(u32 step_tick);
+u32 FLASH_Write_IPC_GetMaxIrqOff(void);
+void FLASH_Write_Lock_GetHist(u32 *hist);
 
 
 /* Other definitions --------------------------------------------------------*/
 
 #define PAGE_SIZE_4K	0x1000
 
+/* FLASH_ReadStreamBulk: reads of at least this size bypass the XIP cache */
+#ifndef FLASH_BULK_READ_THRESHOLD
+#define FLASH_BULK_READ_THRESHOLD	0x2000
+#endif
+/* bytes moved per GDMA block, GDMA block size is limited to 4096 items */
+#define FLASH_BULK_READ_DMA_CHUNK	0x2000
+/* FLASH_ReadStreamBulk fails if one GDMA block is not done in this time */
+#define FLASH_BULK_READ_TIMEOUT_US	10000
+/* bytes read per FLASH_Write_Lock in user mode, bounds the irq-off window */
+#define FLASH_BULK_READ_USER_CHUNK	0x400
+
+/* FLASH_Write_Lock on KM4 fails if KM0 does not answer the lock handshake in this time */
+#define FLASH_SYNC_TIMEOUT_US		100000
+/* number of buckets of flash lock handshake latency histogram */
+#define FLASH_LOCK_HIST_NUM		8
+
+/* flash write buffer coalesces writes inside one program page */
+#define FLASH_WB_PAGE_SIZE		0x100
+#define FLASH_WB_MAX_DELAY		0xFFFFFFFF
+
 extern FLASH_InitTypeDef flash_init_para;
 extern u32 SPIC_CALIB_PATTERN[2];
 
@@ -725,6 +725,32 @@ typedef struct {
 
 } SP_InitTypeDef;
 
+/**
+* @brief  AUDIO_SPORT Stream Callback Definition
+*/
+typedef void (*AUDIO_SP_STREAM_CB)(void *CbData, u32 HwCnt);
+
+/**
+* @brief  AUDIO_SPORT Stream Structure Definition
+* @note   HwCnt is written by the GDMA ISR only and SwCnt by the application only,
+*         so one producer and one consumer share the ring without locking.
+*/
+typedef struct {
+	u32 Index;				/*!< SPORT index */
+	u32 Direction;			/*!< SP_DIR_TX or SP_DIR_RX */
+	u8 *Buf;				/*!< PeriodNum * PeriodBytes ring, cache line aligned */
+	u32 PeriodBytes;		/*!< Period size, multiple of cache line size */
+	u32 PeriodNum;			/*!< Number of periods, at least 2 */
+	struct GDMA_CH_LLI *Lli;	/*!< PeriodNum LLIs, one per period, linked in a circle */
+	AUDIO_SP_STREAM_CB Callback;	/*!< Period elapsed callback, called in GDMA ISR */
+	void *CbData;			/*!< Callback argument */
+
+	volatile u32 HwCnt;		/*!< Free running count of periods finished by GDMA */
+	volatile u32 SwCnt;		/*!< Free running count of periods written (TX) or read (RX) by application */
+	volatile u32 XrunCnt;	/*!< Periods played without new data (TX) or overwritten before read (RX) */
+	GDMA_InitTypeDef Gdma;
+} AUDIO_SP_StreamTypeDef;
+
 /**
   * @}
   */
@@ -1261,6 +1287,13 @@ _LONG_CALL_ void AUDIO_SP_TXDirectRegSel(u32 dst_index, u32 src_index, u32 reg_c
 _LONG_CALL_ void AUDIO_SP_Deinit(u32 index, u32 direction);
 _LONG_CALL_ void AUDIO_SP_SetTxDataFormat(u32 index, u32 format);
 _LONG_CALL_ void AUDIO_SP_SetRxDataFormat(u32 index, u32 format);
+_LONG_CALL_ bool AUDIO_SP_StreamInit(AUDIO_SP_StreamTypeDef *Stream, u32 Index, u32 Direction, u32 SelGDMA, u8 *Buf,
+									 u32 PeriodBytes, u32 PeriodNum, struct GDMA_CH_LLI *Lli, AUDIO_SP_STREAM_CB Callback, void *CbData);
+_LONG_CALL_ void AUDIO_SP_StreamDeInit(AUDIO_SP_StreamTypeDef *Stream);
+_LONG_CALL_ u32 AUDIO_SP_StreamAvail(AUDIO_SP_StreamTypeDef *Stream);
+_LONG_CALL_ u32 AUDIO_SP_StreamFill(AUDIO_SP_StreamTypeDef *Stream);
+_LONG_CALL_ u8 *AUDIO_SP_StreamGetPeriod(AUDIO_SP_StreamTypeDef *Stream);
+_LONG_CALL_ void AUDIO_SP_StreamCommit(AUDIO_SP_StreamTypeDef *Stream);
 
 /**
   * @}
@@ -453,6 +453,69 @@ typedef struct {
 	IRQn_Type	IrqNum;
 } UART_DevTable;
 
+/**
+ * @brief UART RX DMA ring structure definition
+ */
+typedef struct {
+	u8 UartIndex;		/*!< UART index, which can be 0~2. */
+	u8 GdmaChnl;
+	u8 *Buf;		/*!< Ring buffer, cache line aligned. */
+	u32 Size;		/*!< Ring size in bytes, multiple of cache line size. */
+	void (*Callback)(void *CbData, u32 Wr);	/*!< Called from ISR on idle line and on wrap with the write count. */
+	void *CbData;		/*!< Callback argument. */
+
+	volatile u32 Wr;	/*!< Free running count of bytes written to the ring. */
+	volatile u32 Rd;	/*!< Free running count of bytes consumed by the application. */
+	u32 ArmPos;		/*!< Ring offset GDMA was last armed at. */
+	u32 ArmWr;		/*!< Wr when GDMA was last armed. */
+	u32 OverflowCnt;	/*!< Bytes lost because the application fell behind, overwritten by GDMA or dropped from the FIFO. */
+	u32 DmaErrCnt;		/*!< GDMA error interrupts, the ring is re-armed behind the data moved before the error. */
+	GDMA_InitTypeDef Gdma;
+} UART_RxRingTypeDef;
+
+/**
+ * @brief UART TX gather segment definition
+ */
+typedef struct {
+	const u8 *Base;		/*!< Segment start address. */
+	u32 Len;		/*!< Segment length in bytes, 1~4095. */
+} UART_IovecTypeDef;
+
+/**
+ * @brief UART TX chain definition, one frame sent from several segments back to back
+ */
+typedef struct UART_TxChain {
+	struct UART_TxChain *Next;	/*!< Queue link, owned by the driver while the chain is queued. */
+	const UART_IovecTypeDef *Iov;	/*!< Segment list, must stay valid until Callback. */
+	u32 IovNum;		/*!< Number of segments. */
+	struct GDMA_CH_LLI *Lli;	/*!< LLI storage with IovNum entries, cache line aligned, owned by the driver until Callback. */
+	void (*Callback)(void *CbData);	/*!< Called from GDMA ISR when the last byte is moved to the TX FIFO. */
+	void *CbData;		/*!< Callback argument. */
+} UART_TxChainTypeDef;
+
+/**
+ * @brief UART TX chain queue structure definition
+ */
+typedef struct {
+	u8 UartIndex;		/*!< UART index, which can be 0~2. */
+	u8 GdmaChnl;
+	UART_TxChainTypeDef *Head;	/*!< Chain on the wire. */
+	UART_TxChainTypeDef *Tail;
+	GDMA_InitTypeDef Gdma;
+} UART_TxQueueTypeDef;
+
+/**
+ * @brief UART auto baud structure definition
+ */
+typedef struct {
+	UART_TypeDef *UARTx;	/*!< UART device, where x can be 0~2. */
+	u32 RxIPClockHz;	/*!< UART rx clock in Hz, XTAL or OSC. */
+	u32 BaudRate;		/*!< Nominal baud rate locked to, 0 before lock. */
+	u32 Applied;		/*!< Baud rate currently programmed, nominal plus tracked drift. */
+	s32 DriftPpm;		/*!< Filtered peer drift against BaudRate in ppm. */
+	u32 RejectCnt;		/*!< Consecutive measurements rejected as outliers. */
+} UART_AutoBaudTypeDef;
+
 /**
   * @}
   */
@@ -676,6 +739,15 @@ _LONG_CALL_ bool UART_TXGDMA_Init(u8 UartIndex, GDMA_InitTypeDef *GDMA_InitStruc
 _LONG_CALL_ bool UART_RXGDMA_Init(u8 UartIndex, GDMA_InitTypeDef *GDMA_InitStruct, void *CallbackData,
 								  IRQ_FUN CallbackFunc, u8 *pRxBuf, int RxCount);
 _LONG_CALL_ void UART_RTSForceCmd(UART_TypeDef *UARTx, u32 NewState);
+_LONG_CALL_ bool UART_RxRingInit(UART_RxRingTypeDef *Ring, u8 UartIndex, u8 *Buf, u32 Size,
+								 void (*Callback)(void *CbData, u32 Wr), void *CbData, u32 IrqPriority);
+_LONG_CALL_ void UART_RxRingDeInit(UART_RxRingTypeDef *Ring);
+_LONG_CALL_ u32 UART_RxRingPeek(UART_RxRingTypeDef *Ring, u8 **ppData);
+_LONG_CALL_ void UART_RxRingConsume(UART_RxRingTypeDef *Ring, u32 Len);
+_LONG_CALL_ bool UART_TxQueueInit(UART_TxQueueTypeDef *Queue, u8 UartIndex);
+_LONG_CALL_ void UART_TxQueueDeInit(UART_TxQueueTypeDef *Queue);
+_LONG_CALL_ void UART_TxQueueSubmit(UART_TxQueueTypeDef *Queue, UART_TxChainTypeDef *Chain);
+_LONG_CALL_ bool UART_TxQueueBusy(UART_TxQueueTypeDef *Queue);
 
 /* UART_Low_Power_functions UART Low Power Functions */
 _LONG_CALL_ void UART_MonitorParaConfig(UART_TypeDef *UARTx, u32 BitNumThres, u32 OscPerbitUpdCtrl);
@@ -683,6 +755,9 @@ _LONG_CALL_ void UART_LPRxBaudSet(UART_TypeDef *UARTx, u32 BaudRate, u32 RxIPClo
 _LONG_CALL_ void UART_RxMonitorCmd(UART_TypeDef *UARTx, u32 NewState);
 _LONG_CALL_ u32 UART_RxMonBaudCtrlRegGet(UART_TypeDef *UARTx);
 _LONG_CALL_ u32 UART_RxMonitorSatusGet(UART_TypeDef *UARTx);
+_LONG_CALL_ void UART_AutoBaudStart(UART_AutoBaudTypeDef *AutoBaud, UART_TypeDef *UARTx, u32 RxIPClockHz, u32 InitBaud);
+_LONG_CALL_ void UART_AutoBaudStop(UART_AutoBaudTypeDef *AutoBaud);
+_LONG_CALL_ u32 UART_AutoBaudUpdate(UART_AutoBaudTypeDef *AutoBaud);
 
 /* UART_IRDA_functions UART IRDA Functions */
 _LONG_CALL_ void UART_IrDAStructInit(IrDA_InitTypeDef *IrDA_InitStruct);
@@ -695,6 +770,13 @@ _LONG_CALL_ void UART_RxDebounceCmd(UART_TypeDef *UARTx, u32 NewState);
 
 /* Other Definitions --------------------------------------------------------*/
 #define MAX_UART_INDEX			(3)
+#define UART_RX_RING_BURST		(16)
+#define UART_TX_SEG_MAX			(4095)
+#define UART_AUTOBAUD_BIT_THRES	(100)		/* bits measured per monitor period */
+#define UART_AUTOBAUD_LOCK_TOL		(30000)		/* ppm, snap range to a standard rate */
+#define UART_AUTOBAUD_TRACK_TOL	(60000)		/* ppm, larger error after lock is treated as noise */
+#define UART_AUTOBAUD_RETUNE_PPM	(5000)		/* ppm, filtered drift that triggers a divisor update */
+#define UART_AUTOBAUD_RELOCK_CNT	(4)		/* consecutive outliers before relock */
 
 extern const UART_DevTable UART_DEV_TABLE[MAX_UART_INDEX];
 extern const u32 APBPeriph_UARTx[MAX_UART_INDEX];
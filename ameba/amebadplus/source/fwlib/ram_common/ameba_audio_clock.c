@@ -38,39 +38,75 @@ const u32 i2s_clock_source[3] = {PLL_CLOCK_98P304M, PLL_CLOCK_45P1584M, I2S_CLOC
   * @{
   */
 
+static u32 audio_clock_gcd(u32 a, u32 b)
+{
+	u32 t;
+
+	while (b) {
+		t = a % b;
+		a = b;
+		b = t;
+	}
+
+	return a;
+}
+
 /**
-  * @brief  Determine whether the clock can be divided normally.
+  * @brief  Get the smallest sport divider ni/mi that makes clock * ni / mi equal to the bclk.
   * @param	clock: audio clock.
   * @param  sr: sport sample rate.
   * @param  chn_len: sport channel length.
   * @param  chn_cnt: sport channel number.
+  * @param  ni: returns the divider numerator, can be NULL.
+  * @param  mi: returns the divider denominator, can be NULL.
+  * @note   bclk = chn_cnt * chn_len * sr, and clock * ni = mi * bclk must hold exactly.
+  *         The smallest solution is ni = bclk / gcd(clock, bclk), mi = clock / gcd(clock, bclk),
+  *         every other one is a multiple of it, so it is the only candidate to check against
+  *         the ni <= 32767, mi <= 65535 and mi >= 2 * ni limits.
   * @retval ni_mi_found:0/1
   */
-bool is_sport_ni_mi_supported(u32 clock, u32 sr, u32 chn_len, u32 chn_cnt)
+bool Audio_Clock_SportNiMi(u32 clock, u32 sr, u32 chn_len, u32 chn_cnt, u32 *ni, u32 *mi)
 {
-	int ni = 1;
-	int mi = 1;
-	int max_ni = 32767;
-	int max_mi = 65535;
-	bool ni_mi_found = 0;
-
-	for (; ni <= max_ni ; ni++) {
-		if (clock * ni % (chn_cnt * chn_len * sr) == 0) {
-			mi = clock * ni / (chn_cnt * chn_len * sr);
-			//printf("check founded: ni : %d, mi: %d \n", ni, mi);
-			if (mi < 2 * ni) {
-				//printf("mi <= ni, check fail, try another pll divider or sport mclk divider \n");
-				break;
-			}
-			if (mi <= max_mi) {
-				//printf("check ni : %d, mi: %d success\n", ni, mi);
-				ni_mi_found = 1;
-				break;
-			}
-		}
+	u64 bclk = (u64)chn_cnt * chn_len * sr;
+	u32 max_ni = 32767;
+	u32 max_mi = 65535;
+	u32 gcd;
+	u32 ni_min;
+	u32 mi_min;
+
+	if ((bclk == 0) || (bclk > 0xFFFFFFFFU)) {
+		return 0;
 	}
 
-	return ni_mi_found;
+	gcd = audio_clock_gcd(clock, (u32)bclk);
+	ni_min = (u32)bclk / gcd;
+	mi_min = clock / gcd;
+
+	if ((ni_min > max_ni) || (mi_min > max_mi) || ((u64)mi_min < 2 * (u64)ni_min)) {
+		return 0;
+	}
+
+	if (ni) {
+		*ni = ni_min;
+	}
+	if (mi) {
+		*mi = mi_min;
+	}
+
+	return 1;
+}
+
+/**
+  * @brief  Determine whether the clock can be divided normally.
+  * @param	clock: audio clock.
+  * @param  sr: sport sample rate.
+  * @param  chn_len: sport channel length.
+  * @param  chn_cnt: sport channel number.
+  * @retval ni_mi_found:0/1
+  */
+bool is_sport_ni_mi_supported(u32 clock, u32 sr, u32 chn_len, u32 chn_cnt)
+{
+	return Audio_Clock_SportNiMi(clock, sr, chn_len, chn_cnt, NULL, NULL);
 }
 
 /**
@@ -244,6 +280,180 @@ void Audio_Clock_Choose(u32 clock_sel, AUDIO_InitParams *initparams, AUDIO_Clock
 	params->MCLK_MI = MI ;
 
 }
+
+static float audio_clock_absf(float x)
+{
+	return (x < 0) ? -x : x;
+}
+
+static bool audio_clock_drift_trimmable(AUDIO_DriftTypeDef *Drift)
+{
+	return (Drift->Clock == PLL_CLOCK_98P304M) || (Drift->Clock == PLL_CLOCK_45P1584M);
+}
+
+/* Latch and read the 27 bit SPORT frame counter. It counts down, see SP_MASK_TX_SPORT_COUNTER.
+ * The 5 bit FS phase next to it is left out: it is only reported for 32 bit channels and is a
+ * bit position inside a channel slot rather than a fraction of the frame. */
+static u32 audio_clock_drift_count(AUDIO_DriftTypeDef *Drift)
+{
+	AUDIO_SP_SetPhaseLatch(Drift->Index);
+	if (Drift->Direction == SP_DIR_TX) {
+		return AUDIO_SP_GetTXCounterVal(Drift->Index);
+	} else {
+		return AUDIO_SP_GetRXCounterVal(Drift->Index);
+	}
+}
+
+static float audio_clock_drift_trim(AUDIO_DriftTypeDef *Drift, float ppm)
+{
+	u32 action = PLL_AUTO;
+	float abs_ppm = audio_clock_absf(ppm);
+
+	if (abs_ppm >= 0.5f) {
+		action = (ppm > 0) ? PLL_FASTER : PLL_SLOWER;
+	}
+
+	if (Drift->Clock == PLL_CLOCK_98P304M) {
+		return PLL_I2S_98P304M_ClkTune(PLL_I2S, abs_ppm, action);
+	} else {
+		return PLL_I2S_45P158M_ClkTune(PLL_I2S, abs_ppm, action);
+	}
+}
+
+/**
+  * @brief  Start tracking the rate of a SPORT against a reference clock.
+  * @param  Drift: drift tracking state.
+  * @param  Index: SPORT index, the SPORT must already be configured.
+  * @param  Direction: SP_DIR_TX or SP_DIR_RX, the counter to follow.
+  * @param  Clock: audio clock of the SPORT, as returned by Audio_Clock_Choose.
+  * @param  SampleRate: nominal sample rate.
+  * @param  RefHz: tick rate of the reference timestamps given to Audio_Clock_DriftUpdate.
+  * @note   The 98.304M and 45.1584M PLLs are trimmed, one tracker per PLL. With the XTAL clock
+  *         the correction is only reported in ResamplePpm for AUDIO_FMT_ResampleSetPpm.
+  * @retval None
+  */
+void Audio_Clock_DriftInit(AUDIO_DriftTypeDef *Drift, u32 Index, u32 Direction, u32 Clock, u32 SampleRate, u32 RefHz)
+{
+	assert_param(Index < 2);
+	assert_param(IS_SP_SET_DIR(Direction));
+	assert_param(SampleRate != 0 && RefHz != 0);
+
+	_memset(Drift, 0, sizeof(AUDIO_DriftTypeDef));
+	Drift->Index = Index;
+	Drift->Direction = Direction;
+	Drift->Clock = Clock;
+	Drift->SampleRate = SampleRate;
+	Drift->RefHz = RefHz;
+
+	if (Direction == SP_DIR_TX) {
+		AUDIO_SP_SetTXCounter(Index, ENABLE);
+	} else {
+		AUDIO_SP_SetRXCounter(Index, ENABLE);
+	}
+
+	if (audio_clock_drift_trimmable(Drift)) {
+		audio_clock_drift_trim(Drift, 0);
+	}
+}
+
+/**
+  * @brief  Stop tracking and put the PLL back to its nominal frequency.
+  * @param  Drift: drift tracking state.
+  * @retval None
+  */
+void Audio_Clock_DriftDeInit(AUDIO_DriftTypeDef *Drift)
+{
+	if (audio_clock_drift_trimmable(Drift) && Drift->TrimPpm != 0) {
+		audio_clock_drift_trim(Drift, 0);
+	}
+
+	if (Drift->Direction == SP_DIR_TX) {
+		AUDIO_SP_SetTXCounter(Drift->Index, DISABLE);
+	} else {
+		AUDIO_SP_SetRXCounter(Drift->Index, DISABLE);
+	}
+
+	Drift->TrimPpm = 0;
+	Drift->ResamplePpm = 0;
+	Drift->Started = 0;
+}
+
+/**
+  * @brief  Measure the SPORT rate against the reference and servo the PLL.
+  * @param  Drift: drift tracking state.
+  * @param  RefTick: reference timestamp taken now, in RefHz ticks, may wrap.
+  * @note   Call periodically, e.g. once per DMA period, at most every 20 minutes so the
+  *         27 bit SPORT counter does not wrap between calls at 96k. The first call only takes
+  *         the baseline. The counter resolves one frame, so a rate is only measured once
+  *         AUDIO_DRIFT_WINDOW_SEC has passed, calls in between return the trim in effect.
+  *         The rate error of the untrimmed clock is filtered by 1/8 per update and cancelled
+  *         directly, and the accumulated frame offset is paid back over AUDIO_DRIFT_SETTLE_SEC,
+  *         so the offset decays as a first order loop and buffers neither creep nor need margin.
+  * @retval PLL trim in effect in ppm, or the resampler correction for an XTAL clock.
+  */
+float Audio_Clock_DriftUpdate(AUDIO_DriftTypeDef *Drift, u32 RefTick)
+{
+	u32 cnt = audio_clock_drift_count(Drift);
+	u32 dcnt = (Drift->LastCnt - cnt) & AUDIO_DRIFT_CNT_MASK;
+	u32 dref = RefTick - Drift->LastRef;
+	bool trimmable = audio_clock_drift_trimmable(Drift);
+	float frames;
+	float expect;
+	float hw_ppm;
+	float target;
+
+	if (Drift->Started && dref < Drift->RefHz * AUDIO_DRIFT_WINDOW_SEC) {
+		return trimmable ? Drift->TrimPpm : Drift->ResamplePpm;
+	}
+
+	Drift->LastCnt = cnt;
+	Drift->LastRef = RefTick;
+	if (!Drift->Started) {
+		Drift->Started = 1;
+		return trimmable ? Drift->TrimPpm : Drift->ResamplePpm;
+	}
+
+	frames = (float)dcnt;
+	expect = (float)((double)dref * Drift->SampleRate / Drift->RefHz);
+	hw_ppm = (frames - expect) * 1000000.0f / expect - Drift->TrimPpm;
+
+	if (Drift->Started == 1) {
+		if (audio_clock_absf(hw_ppm) > AUDIO_DRIFT_OUTLIER_PPM) {
+			Drift->RejectCnt++;
+			return trimmable ? Drift->TrimPpm : Drift->ResamplePpm;
+		}
+		Drift->HwPpm = hw_ppm;
+		Drift->Started = 2;
+	} else if (audio_clock_absf(hw_ppm - Drift->HwPpm) > AUDIO_DRIFT_OUTLIER_PPM) {
+		/* underrun, restart or a late call: drop the sample, the new baseline is already taken */
+		Drift->RejectCnt++;
+		return trimmable ? Drift->TrimPpm : Drift->ResamplePpm;
+	} else {
+		Drift->HwPpm += (hw_ppm - Drift->HwPpm) / 8;
+	}
+
+	if (!trimmable) {
+		/* the SPORT keeps its rate, the stream has to be stretched (TX) or shrunk (RX) instead */
+		Drift->ResamplePpm = (Drift->Direction == SP_DIR_TX) ? Drift->HwPpm : -Drift->HwPpm;
+		return Drift->ResamplePpm;
+	}
+
+	Drift->Offset += frames - expect;
+	target = -Drift->HwPpm - Drift->Offset * 1000000.0f / ((float)Drift->SampleRate * AUDIO_DRIFT_SETTLE_SEC);
+
+	if (target > AUDIO_DRIFT_TRIM_MAX_PPM) {
+		target = AUDIO_DRIFT_TRIM_MAX_PPM;
+	} else if (target < -AUDIO_DRIFT_TRIM_MAX_PPM) {
+		target = -AUDIO_DRIFT_TRIM_MAX_PPM;
+	}
+
+	/* one F0F step is ~0.9ppm, skip rewrites that would land on the same step */
+	if (audio_clock_absf(target - Drift->TrimPpm) >= 0.45f) {
+		Drift->TrimPpm = audio_clock_drift_trim(Drift, target);
+	}
+
+	return Drift->TrimPpm;
+}
 /**
 * @}
 */
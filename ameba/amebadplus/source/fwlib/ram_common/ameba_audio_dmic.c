@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ameba_soc.h"
+#include "ameba_audio_dmic.h"
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup AUDIO
+  * @brief AUDIO driver modules
+  * @{
+  */
+
+/** @defgroup AUDIO_DMIC
+* @brief AUDIO_DMIC voice gated capture modules
+* @{
+*/
+
+/* Exported functions ------------------------------------------------------------*/
+/** @defgroup AUDIO_DMIC_Exported_Functions AUDIO_DMIC Exported Functions
+  * @{
+  */
+
+/**
+  * @brief  Set up the codec DMIC record path for voice capture.
+  * @param  i2s_sel: codec I2S connected to the capture SPORT, I2S0.
+  * @param  I2S_InitStruct: codec I2S rx parameters, 16 bit word length.
+  * @param  dmic_clk: DMIC clock, the lowest one supporting the sample rate saves the most power.
+  *          This parameter can be one of the following values:
+  *            @arg DMIC_5M
+  *            @arg DMIC_2P5M
+  *            @arg DMIC_1P25M
+  *            @arg DMIC_625K
+  *            @arg DMIC_312P5K
+  *            @arg DMIC_769P2K
+  * @param  hpf_fc: ADC HPF fc select of AUDIO_CODEC_SetADCHPF, the HPF removes the DC offset
+  *         the VAD energy and zero crossing count would otherwise see.
+  * @note   ADC gain changes are applied at zero crossings, so gain control does not click.
+  * @retval None
+  */
+void AUDIO_DMIC_CodecInit(u32 i2s_sel, I2S_InitTypeDef *I2S_InitStruct, u32 dmic_clk, u32 hpf_fc)
+{
+	AUDIO_CODEC_Record(i2s_sel, APP_DMIC_RECORD, I2S_InitStruct);
+
+	AUDIO_CODEC_SetDmicClk(dmic_clk, ENABLE);
+	AUDIO_CODEC_SetADCHPF(ADC1, hpf_fc, ENABLE);
+	AUDIO_CODEC_SetADCHPF(ADC2, hpf_fc, ENABLE);
+	AUDIO_CODEC_SetADCZDET(ADC1, ZDET_STEP);
+	AUDIO_CODEC_SetADCZDET(ADC2, ZDET_STEP);
+}
+
+/**
+  * @brief  Fill the VAD parameters with defaults for 10 ~ 20ms periods.
+  * @param  Params: VAD parameters.
+  * @retval None
+  */
+void AUDIO_DMIC_VADStructInit(AUDIO_DMIC_VADParams *Params)
+{
+	Params->OnRatio = 64;		/* 6dB over the noise floor */
+	Params->MinEnergy = 400;	/* about -64dBFS */
+	Params->ZcrMax = 96;		/* 0.375 crossings per frame, hiss rather than voice */
+	Params->OnsetNum = 2;
+	Params->HangoverNum = 15;
+	Params->PreRollNum = 4;
+}
+
+/**
+  * @brief  Reset a VAD.
+  * @param  Vad: VAD state.
+  * @param  Params: VAD parameters, copied.
+  * @param  ChnCnt: interleaved channel number of the periods.
+  * @param  PeriodFrames: frames per period.
+  * @retval None
+  */
+void AUDIO_DMIC_VADInit(AUDIO_DMIC_VADTypeDef *Vad, AUDIO_DMIC_VADParams *Params, u32 ChnCnt, u32 PeriodFrames)
+{
+	assert_param(ChnCnt != 0 && PeriodFrames != 0);
+
+	_memset(Vad, 0, sizeof(AUDIO_DMIC_VADTypeDef));
+	Vad->Params = *Params;
+	Vad->ChnCnt = ChnCnt;
+	Vad->PeriodFrames = PeriodFrames;
+}
+
+/**
+  * @brief  Run the VAD on one period.
+  * @param  Vad: VAD state.
+  * @param  Pcm: PeriodFrames interleaved s16 frames.
+  * @note   A period is active when its mean square is OnRatio over the noise floor and above
+  *         MinEnergy. Speech only starts on voiced periods with a low zero crossing rate, so
+  *         hiss and fans do not trigger it, while fricatives inside speech keep it going and
+  *         the pre-roll recovers the ones before the onset. The floor follows quiet periods,
+  *         falling fast and rising slowly, and barely moves during speech.
+  *         One multiply-accumulate per frame, no division in the loop.
+  * @retval AUDIO_DMIC_VAD_IDLE, AUDIO_DMIC_VAD_START, AUDIO_DMIC_VAD_SPEECH or AUDIO_DMIC_VAD_END.
+  */
+u32 AUDIO_DMIC_VADProcess(AUDIO_DMIC_VADTypeDef *Vad, const s16 *Pcm)
+{
+	AUDIO_DMIC_VADParams *Params = &Vad->Params;
+	u32 chn_cnt = Vad->ChnCnt;
+	u32 frames = Vad->PeriodFrames;
+	s32 prev = Vad->LastSample;
+	u64 acc = 0;
+	u64 level;
+	u64 thr;
+	u32 zc = 0;
+	u32 energy;
+	u32 i;
+	s32 x;
+	bool active;
+
+	for (i = 0; i < frames; i++) {
+		x = Pcm[i * chn_cnt];
+		acc += (u32)(x * x);
+		zc += ((x ^ prev) < 0);
+		prev = x;
+	}
+	Vad->LastSample = (s16)prev;
+
+	energy = (u32)(acc / frames);
+	Vad->Energy = energy;
+	Vad->Zcr = zc * 256 / frames;
+
+	if (Vad->Floor == 0) {
+		Vad->Floor = MAX(energy, 1);
+		return AUDIO_DMIC_VAD_IDLE;
+	}
+
+	level = (u64)energy * 16;
+	thr = (u64)Vad->Floor * Params->OnRatio;
+	active = (energy >= Params->MinEnergy) && (level >= thr) && ((Vad->Zcr <= Params->ZcrMax) || Vad->Speech);
+
+	if (!active && !Vad->Speech) {
+		if (energy < Vad->Floor) {
+			Vad->Floor -= (Vad->Floor - energy) >> 2;
+		} else {
+			Vad->Floor += (energy - Vad->Floor) >> 6;
+		}
+	} else if (energy > Vad->Floor) {
+		/* a stationary noise that starts during speech is still learnt, only slowly */
+		Vad->Floor += (energy - Vad->Floor) >> 10;
+	}
+	Vad->Floor = MAX(Vad->Floor, 1);
+
+	if (active) {
+		Vad->ActiveCnt++;
+		Vad->Hangover = Params->HangoverNum;
+		if (!Vad->Speech && Vad->ActiveCnt >= Params->OnsetNum) {
+			Vad->Speech = 1;
+			return AUDIO_DMIC_VAD_START;
+		}
+		return Vad->Speech ? AUDIO_DMIC_VAD_SPEECH : AUDIO_DMIC_VAD_IDLE;
+	}
+
+	Vad->ActiveCnt = 0;
+	if (!Vad->Speech) {
+		return AUDIO_DMIC_VAD_IDLE;
+	}
+
+	if (Vad->Hangover) {
+		Vad->Hangover--;
+	}
+	if (Vad->Hangover == 0) {
+		Vad->Speech = 0;
+		return AUDIO_DMIC_VAD_END;
+	}
+
+	return AUDIO_DMIC_VAD_SPEECH;
+}
+
+/* Stream callback in GDMA ISR: the only consumer of the capture ring. */
+static void audio_dmic_period(void *CbData, u32 HwCnt)
+{
+	AUDIO_DMIC_CaptureTypeDef *Capture = (AUDIO_DMIC_CaptureTypeDef *)CbData;
+	AUDIO_SP_StreamTypeDef *Stream = &Capture->Stream;
+	u32 frames = Capture->Vad.PeriodFrames;
+	u32 state;
+	u32 pre;
+	u32 safe;
+	u8 *Period;
+
+	/* Stream->HwCnt is read live in the pre-roll loop instead */
+	(void) HwCnt;
+
+	while ((Period = AUDIO_SP_StreamGetPeriod(Stream)) != NULL) {
+		state = AUDIO_DMIC_VADProcess(&Capture->Vad, (s16 *)Period);
+
+		if (state == AUDIO_DMIC_VAD_START) {
+			Capture->Callback(Capture->CbData, AUDIO_DMIC_VAD_START, NULL, 0);
+
+			/* periods already read stay intact until GDMA comes round to them again, it goes on
+			while the callback runs, so the oldest period is checked again before each one */
+			pre = MIN(Capture->Vad.Params.PreRollNum, Capture->PeriodCnt);
+			for (; pre > 0; pre--) {
+				safe = Stream->PeriodNum - 2 - MIN(Stream->HwCnt - Stream->SwCnt, Stream->PeriodNum - 2);
+				if (pre > safe) {
+					continue;
+				}
+				Capture->Callback(Capture->CbData, AUDIO_DMIC_VAD_SPEECH,
+								  (s16 *)(Stream->Buf + ((Stream->SwCnt - pre) % Stream->PeriodNum) * Stream->PeriodBytes), frames);
+			}
+		}
+
+		if (state != AUDIO_DMIC_VAD_IDLE) {
+			Capture->Callback(Capture->CbData, AUDIO_DMIC_VAD_SPEECH, (s16 *)Period, frames);
+		}
+		if (state == AUDIO_DMIC_VAD_END) {
+			Capture->Callback(Capture->CbData, AUDIO_DMIC_VAD_END, NULL, 0);
+		}
+
+		AUDIO_SP_StreamCommit(Stream);
+		Capture->PeriodCnt++;
+	}
+}
+
+/**
+  * @brief  Start voice gated DMIC capture on a SPORT GDMA ring.
+  * @param  Capture: capture control block.
+  * @param  Index: SPORT wired to the codec, already configured by AUDIO_SP_Init for RX.
+  * @param  SelGDMA: GDMA Int or Ext.
+  * @param  ChnCnt: interleaved s16 channel number, channel 0 is analysed.
+  * @param  Buf: PeriodNum * PeriodBytes ring buffer, cache line aligned.
+  * @param  PeriodBytes: period size in bytes, multiple of cache line size, 10 ~ 20ms is typical.
+  * @param  PeriodNum: number of periods, PreRollNum + 3 or more to keep the whole pre-roll.
+  * @param  Lli: PeriodNum LLIs for GDMA, cache line aligned.
+  * @param  Params: VAD parameters, see AUDIO_DMIC_VADStructInit.
+  * @param  Callback: called in GDMA ISR only while speech is present, it should just queue
+  *         the period or copy it out before returning, the period is reused afterwards.
+  * @param  CbData: callback argument.
+  * @retval TRUE/FLASE
+  */
+bool AUDIO_DMIC_CaptureInit(AUDIO_DMIC_CaptureTypeDef *Capture, u32 Index, u32 SelGDMA, u32 ChnCnt, u8 *Buf,
+							u32 PeriodBytes, u32 PeriodNum, struct GDMA_CH_LLI *Lli, AUDIO_DMIC_VADParams *Params,
+							AUDIO_DMIC_CB Callback, void *CbData)
+{
+	assert_param(Callback != NULL);
+	assert_param(ChnCnt != 0);
+	assert_param(PeriodBytes % (ChnCnt * sizeof(s16)) == 0);
+
+	Capture->Callback = Callback;
+	Capture->CbData = CbData;
+	Capture->PeriodCnt = 0;
+	AUDIO_DMIC_VADInit(&Capture->Vad, Params, ChnCnt, PeriodBytes / (ChnCnt * sizeof(s16)));
+
+	if (AUDIO_SP_StreamInit(&Capture->Stream, Index, SP_DIR_RX, SelGDMA, Buf, PeriodBytes, PeriodNum, Lli,
+							audio_dmic_period, (void *)Capture) == FALSE) {
+		return FALSE;
+	}
+
+	AUDIO_SP_DmaCmd(Index, ENABLE);
+	AUDIO_SP_RXStart(Index, ENABLE);
+
+	return TRUE;
+}
+
+/**
+  * @brief  Stop DMIC capture and release its GDMA channel.
+  * @param  Capture: capture started by AUDIO_DMIC_CaptureInit.
+  * @retval None
+  */
+void AUDIO_DMIC_CaptureDeInit(AUDIO_DMIC_CaptureTypeDef *Capture)
+{
+	AUDIO_SP_RXStart(Capture->Stream.Index, DISABLE);
+	AUDIO_SP_StreamDeInit(&Capture->Stream);
+}
+/**
+* @}
+*/
+
+/** @} */
+
+/** @} */
+
+/** @} */
@@ -0,0 +1,586 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ameba_soc.h"
+#include "ameba_audio_fmt.h"
+
+/** @addtogroup Ameba_Periph_Driver
+  * @{
+  */
+
+/** @defgroup AUDIO
+  * @brief AUDIO driver modules
+  * @{
+  */
+
+/** @defgroup AUDIO_FMT
+* @brief AUDIO_FMT sample format conversion modules
+* @{
+*/
+
+/* Cortex-M33 DSP extension is used when the compiler targets it, the C path gives the same results. */
+#if defined (__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1U)
+#define AUDIO_FMT_DSP		1
+#define AUDIO_FMT_SSAT(x, n)	__SSAT((x), (n))
+#else
+#define AUDIO_FMT_DSP		0
+#define AUDIO_FMT_SSAT(x, n)	audio_fmt_ssat((x), (n))
+
+static inline s32 audio_fmt_ssat(s32 x, u32 n)
+{
+	s32 max = (s32)((1UL << (n - 1)) - 1);
+	s32 min = -max - 1;
+
+	if (x > max) {
+		return max;
+	}
+	if (x < min) {
+		return min;
+	}
+
+	return x;
+}
+#endif
+
+/* shift right by n with round to nearest, never overflows for n >= 1 */
+#define AUDIO_FMT_RSHIFT(x, n)	((((x) >> ((n) - 1)) + 1) >> 1)
+
+/* Exported functions ------------------------------------------------------------*/
+/** @defgroup AUDIO_FMT_Exported_Functions AUDIO_FMT Exported Functions
+  * @{
+  */
+
+/**
+  * @brief  Convert s16 samples to s32.
+  * @param  dst: destination buffer.
+  * @param  src: source buffer.
+  * @param  num: number of samples.
+  * @retval None
+  */
+void AUDIO_FMT_S16ToS32(s32 *dst, const s16 *src, u32 num)
+{
+	while (num--) {
+		*dst++ = (s32)*src++ * 65536;
+	}
+}
+
+/**
+  * @brief  Convert s32 samples to s16, rounded and saturated.
+  * @param  dst: destination buffer, can be the same as src.
+  * @param  src: source buffer.
+  * @param  num: number of samples.
+  * @retval None
+  */
+void AUDIO_FMT_S32ToS16(s16 *dst, const s32 *src, u32 num)
+{
+	while (num--) {
+		*dst++ = (s16)AUDIO_FMT_SSAT(AUDIO_FMT_RSHIFT(*src, 16), 16);
+		src++;
+	}
+}
+
+/**
+  * @brief  Convert s16 samples to s24.
+  * @param  dst: destination buffer.
+  * @param  src: source buffer.
+  * @param  num: number of samples.
+  * @retval None
+  */
+void AUDIO_FMT_S16ToS24(s32 *dst, const s16 *src, u32 num)
+{
+	while (num--) {
+		*dst++ = (s32)*src++ * 256;
+	}
+}
+
+/**
+  * @brief  Convert s24 samples to s16, rounded and saturated.
+  * @param  dst: destination buffer, can be the same as src.
+  * @param  src: source buffer.
+  * @param  num: number of samples.
+  * @retval None
+  */
+void AUDIO_FMT_S24ToS16(s16 *dst, const s32 *src, u32 num)
+{
+	while (num--) {
+		*dst++ = (s16)AUDIO_FMT_SSAT(AUDIO_FMT_RSHIFT(*src, 8), 16);
+		src++;
+	}
+}
+
+/**
+  * @brief  Convert s24 samples to s32.
+  * @param  dst: destination buffer, can be the same as src.
+  * @param  src: source buffer.
+  * @param  num: number of samples.
+  * @retval None
+  */
+void AUDIO_FMT_S24ToS32(s32 *dst, const s32 *src, u32 num)
+{
+	while (num--) {
+		*dst++ = (s32)((u32)*src++ << 8);
+	}
+}
+
+/**
+  * @brief  Convert s32 samples to s24, rounded and saturated.
+  * @param  dst: destination buffer, can be the same as src.
+  * @param  src: source buffer.
+  * @param  num: number of samples.
+  * @retval None
+  */
+void AUDIO_FMT_S32ToS24(s32 *dst, const s32 *src, u32 num)
+{
+	while (num--) {
+		*dst++ = AUDIO_FMT_SSAT(AUDIO_FMT_RSHIFT(*src, 8), 24);
+		src++;
+	}
+}
+
+/**
+  * @brief  Convert s16 samples to float.
+  * @param  dst: destination buffer.
+  * @param  src: source buffer.
+  * @param  num: number of samples.
+  * @retval None
+  */
+void AUDIO_FMT_S16ToFloat(float *dst, const s16 *src, u32 num)
+{
+	while (num--) {
+		*dst++ = (float)*src++ * (1.0f / 32768.0f);
+	}
+}
+
+/**
+  * @brief  Convert float samples to s16, rounded and saturated.
+  * @param  dst: destination buffer.
+  * @param  src: source buffer.
+  * @param  num: number of samples.
+  * @retval None
+  */
+void AUDIO_FMT_FloatToS16(s16 *dst, const float *src, u32 num)
+{
+	float v;
+
+	while (num--) {
+		v = *src++ * 32768.0f;
+		v += (v >= 0.0f) ? 0.5f : -0.5f;
+
+		if (v >= 32767.0f) {
+			*dst++ = 32767;
+		} else if (v <= -32768.0f) {
+			*dst++ = -32768;
+		} else {
+			*dst++ = (s16)v;
+		}
+	}
+}
+
+/**
+  * @brief  Convert s32 samples to float.
+  * @param  dst: destination buffer, can be the same as src.
+  * @param  src: source buffer.
+  * @param  num: number of samples.
+  * @retval None
+  */
+void AUDIO_FMT_S32ToFloat(float *dst, const s32 *src, u32 num)
+{
+	while (num--) {
+		*dst++ = (float)*src++ * (1.0f / 2147483648.0f);
+	}
+}
+
+/**
+  * @brief  Convert float samples to s32, saturated.
+  * @param  dst: destination buffer, can be the same as src.
+  * @param  src: source buffer.
+  * @param  num: number of samples.
+  * @retval None
+  */
+void AUDIO_FMT_FloatToS32(s32 *dst, const float *src, u32 num)
+{
+	float v;
+
+	while (num--) {
+		v = *src++ * 2147483648.0f;
+
+		if (v >= 2147483647.0f) {
+			*dst++ = 0x7FFFFFFF;
+		} else if (v <= -2147483648.0f) {
+			*dst++ = (s32)0x80000000;
+		} else {
+			*dst++ = (s32)v;
+		}
+	}
+}
+
+/**
+  * @brief  Duplicate s16 mono samples to interleaved stereo.
+  * @param  dst: destination buffer of 2 * frames samples, 4 bytes aligned.
+  * @param  src: source buffer of frames samples, 4 bytes aligned.
+  * @param  frames: number of frames.
+  * @retval None
+  */
+void AUDIO_FMT_MonoToStereoS16(s16 *dst, const s16 *src, u32 frames)
+{
+#if AUDIO_FMT_DSP
+	const u32 *in = (const u32 *)src;
+	u32 *out = (u32 *)dst;
+	u32 w;
+
+	for (; frames >= 2; frames -= 2) {
+		w = *in++;
+		*out++ = __PKHBT(w, w, 16);
+		*out++ = __PKHTB(w, w, 16);
+	}
+	src = (const s16 *)in;
+	dst = (s16 *)out;
+#endif
+
+	while (frames--) {
+		dst[0] = *src;
+		dst[1] = *src++;
+		dst += 2;
+	}
+}
+
+/**
+  * @brief  Mix interleaved s16 stereo down to mono: out = L * gain_l + R * gain_r.
+  * @param  dst: destination buffer of frames samples, can be the same as src.
+  * @param  src: source buffer of 2 * frames samples, 4 bytes aligned.
+  * @param  frames: number of frames.
+  * @param  gain_l: left weight in Q15, -32767 ~ 32767. 16384 with gain_r 16384 is the average.
+  * @param  gain_r: right weight in Q15, -32767 ~ 32767.
+  * @retval None
+  */
+void AUDIO_FMT_StereoToMonoS16(s16 *dst, const s16 *src, u32 frames, s16 gain_l, s16 gain_r)
+{
+	assert_param((gain_l != -32768) && (gain_r != -32768));
+
+#if AUDIO_FMT_DSP
+	const u32 *in = (const u32 *)src;
+	u32 gain = (u16)gain_l | ((u32)(u16)gain_r << 16);
+
+	while (frames--) {
+		*dst++ = (s16)__SSAT((s32)__SMLAD(*in++, gain, 0x4000) >> 15, 16);
+	}
+#else
+	while (frames--) {
+		*dst++ = (s16)AUDIO_FMT_SSAT(((s32)src[0] * gain_l + (s32)src[1] * gain_r + 0x4000) >> 15, 16);
+		src += 2;
+	}
+#endif
+}
+
+/**
+  * @brief  Split interleaved s16 frames (stereo or TDM) into one buffer per channel.
+  * @param  dst: chn_cnt channel buffers of frames samples each.
+  * @param  src: source buffer of chn_cnt * frames samples.
+  * @param  chn_cnt: number of channels, 2/4/8 use unrolled loops.
+  * @param  frames: number of frames.
+  * @retval None
+  */
+void AUDIO_FMT_DeinterleaveS16(s16 *const *dst, const s16 *src, u32 chn_cnt, u32 frames)
+{
+	s16 *d0 = dst[0], *d1, *d2, *d3, *d4, *d5, *d6, *d7;
+	u32 i, ch;
+
+	switch (chn_cnt) {
+	case 2:
+		d1 = dst[1];
+		for (i = 0; i < frames; i++, src += 2) {
+			d0[i] = src[0];
+			d1[i] = src[1];
+		}
+		break;
+
+	case 4:
+		d1 = dst[1];
+		d2 = dst[2];
+		d3 = dst[3];
+		for (i = 0; i < frames; i++, src += 4) {
+			d0[i] = src[0];
+			d1[i] = src[1];
+			d2[i] = src[2];
+			d3[i] = src[3];
+		}
+		break;
+
+	case 8:
+		d1 = dst[1];
+		d2 = dst[2];
+		d3 = dst[3];
+		d4 = dst[4];
+		d5 = dst[5];
+		d6 = dst[6];
+		d7 = dst[7];
+		for (i = 0; i < frames; i++, src += 8) {
+			d0[i] = src[0];
+			d1[i] = src[1];
+			d2[i] = src[2];
+			d3[i] = src[3];
+			d4[i] = src[4];
+			d5[i] = src[5];
+			d6[i] = src[6];
+			d7[i] = src[7];
+		}
+		break;
+
+	default:
+		for (i = 0; i < frames; i++) {
+			for (ch = 0; ch < chn_cnt; ch++) {
+				dst[ch][i] = *src++;
+			}
+		}
+		break;
+	}
+}
+
+/**
+  * @brief  Split interleaved s32/s24 frames (stereo or TDM) into one buffer per channel.
+  * @param  dst: chn_cnt channel buffers of frames samples each.
+  * @param  src: source buffer of chn_cnt * frames samples.
+  * @param  chn_cnt: number of channels, 2/4/8 use unrolled loops.
+  * @param  frames: number of frames.
+  * @retval None
+  */
+void AUDIO_FMT_DeinterleaveS32(s32 *const *dst, const s32 *src, u32 chn_cnt, u32 frames)
+{
+	s32 *d0 = dst[0], *d1, *d2, *d3, *d4, *d5, *d6, *d7;
+	u32 i, ch;
+
+	switch (chn_cnt) {
+	case 2:
+		d1 = dst[1];
+		for (i = 0; i < frames; i++, src += 2) {
+			d0[i] = src[0];
+			d1[i] = src[1];
+		}
+		break;
+
+	case 4:
+		d1 = dst[1];
+		d2 = dst[2];
+		d3 = dst[3];
+		for (i = 0; i < frames; i++, src += 4) {
+			d0[i] = src[0];
+			d1[i] = src[1];
+			d2[i] = src[2];
+			d3[i] = src[3];
+		}
+		break;
+
+	case 8:
+		d1 = dst[1];
+		d2 = dst[2];
+		d3 = dst[3];
+		d4 = dst[4];
+		d5 = dst[5];
+		d6 = dst[6];
+		d7 = dst[7];
+		for (i = 0; i < frames; i++, src += 8) {
+			d0[i] = src[0];
+			d1[i] = src[1];
+			d2[i] = src[2];
+			d3[i] = src[3];
+			d4[i] = src[4];
+			d5[i] = src[5];
+			d6[i] = src[6];
+			d7[i] = src[7];
+		}
+		break;
+
+	default:
+		for (i = 0; i < frames; i++) {
+			for (ch = 0; ch < chn_cnt; ch++) {
+				dst[ch][i] = *src++;
+			}
+		}
+		break;
+	}
+}
+
+/**
+  * @brief  Merge one s16 buffer per channel into interleaved frames.
+  * @param  dst: destination buffer of chn_cnt * frames samples.
+  * @param  src: chn_cnt channel buffers of frames samples each.
+  * @param  chn_cnt: number of channels.
+  * @param  frames: number of frames.
+  * @retval None
+  */
+void AUDIO_FMT_InterleaveS16(s16 *dst, const s16 *const *src, u32 chn_cnt, u32 frames)
+{
+	const s16 *s0 = src[0];
+	const s16 *s1 = (chn_cnt > 1) ? src[1] : NULL;
+	u32 i, ch;
+
+	if (chn_cnt == 2) {
+		for (i = 0; i < frames; i++, dst += 2) {
+			dst[0] = s0[i];
+			dst[1] = s1[i];
+		}
+		return;
+	}
+
+	for (i = 0; i < frames; i++) {
+		for (ch = 0; ch < chn_cnt; ch++) {
+			*dst++ = src[ch][i];
+		}
+	}
+}
+
+/**
+  * @brief  Apply a gain to s16 samples, rounded and saturated.
+  * @param  dst: destination buffer, can be the same as src, 4 bytes aligned.
+  * @param  src: source buffer, 4 bytes aligned.
+  * @param  num: number of samples.
+  * @param  gain: gain in Q3.12, AUDIO_FMT_GAIN_UNITY ~ 0x7FFF.
+  * @retval None
+  */
+void AUDIO_FMT_GainS16(s16 *dst, const s16 *src, u32 num, u32 gain)
+{
+	assert_param(gain <= 0x7FFF);
+
+#if AUDIO_FMT_DSP
+	const u32 *in = (const u32 *)src;
+	u32 *out = (u32 *)dst;
+	s32 lo, hi;
+	u32 w;
+
+	for (; num >= 2; num -= 2) {
+		w = *in++;
+		lo = __SSAT((__SMULBB(w, gain) + 0x800) >> 12, 16);
+		hi = __SSAT((__SMULTB(w, gain) + 0x800) >> 12, 16);
+		*out++ = __PKHBT(lo, hi, 16);
+	}
+	src = (const s16 *)in;
+	dst = (s16 *)out;
+#endif
+
+	while (num--) {
+		*dst++ = (s16)AUDIO_FMT_SSAT(((s32)*src++ * (s32)gain + 0x800) >> 12, 16);
+	}
+}
+
+/**
+  * @brief  Add s16 samples into dst with saturation, dst = dst + src.
+  * @param  dst: accumulate buffer, 4 bytes aligned.
+  * @param  src: source buffer, 4 bytes aligned.
+  * @param  num: number of samples.
+  * @retval None
+  */
+void AUDIO_FMT_MixS16(s16 *dst, const s16 *src, u32 num)
+{
+#if AUDIO_FMT_DSP
+	const u32 *in = (const u32 *)src;
+	u32 *out = (u32 *)dst;
+
+	for (; num >= 2; num -= 2) {
+		*out = __QADD16(*out, *in++);
+		out++;
+	}
+	src = (const s16 *)in;
+	dst = (s16 *)out;
+#endif
+
+	while (num--) {
+		*dst = (s16)AUDIO_FMT_SSAT((s32)*dst + *src++, 16);
+		dst++;
+	}
+}
+
+/**
+  * @brief  Reset the fractional resampler to 1:1.
+  * @param  State: resampler state.
+  * @param  chn_cnt: interleaved channel number, 1 ~ AUDIO_FMT_RESAMPLE_CHN_MAX.
+  * @retval None
+  */
+void AUDIO_FMT_ResampleInit(AUDIO_FMT_ResampleTypeDef *State, u32 chn_cnt)
+{
+	assert_param(chn_cnt >= 1 && chn_cnt <= AUDIO_FMT_RESAMPLE_CHN_MAX);
+
+	_memset(State, 0, sizeof(AUDIO_FMT_ResampleTypeDef));
+	State->ChnCnt = chn_cnt;
+	State->Step = (u64)1 << 32;
+	State->Pos = (u64)1 << 32;
+}
+
+/**
+  * @brief  Set the rate correction, it can be changed between blocks without a glitch.
+  * @param  State: resampler state.
+  * @param  ppm: output rate relative to input, > 0 produces more frames than it consumes.
+  *         Clamped to +-AUDIO_FMT_RESAMPLE_PPM_MAX.
+  * @retval None
+  */
+void AUDIO_FMT_ResampleSetPpm(AUDIO_FMT_ResampleTypeDef *State, float ppm)
+{
+	if (ppm > AUDIO_FMT_RESAMPLE_PPM_MAX) {
+		ppm = AUDIO_FMT_RESAMPLE_PPM_MAX;
+	} else if (ppm < -AUDIO_FMT_RESAMPLE_PPM_MAX) {
+		ppm = -AUDIO_FMT_RESAMPLE_PPM_MAX;
+	}
+
+	State->Step = (u64)(4294967296.0 / (1.0 + (double)ppm / 1000000.0) + 0.5);
+}
+
+/**
+  * @brief  Resample one block of interleaved s16 frames by the configured ratio.
+  * @param  State: resampler state.
+  * @param  dst: output buffer, must hold frames + 2 frames for blocks up to 1000 frames.
+  * @param  src: input frames, all of them are consumed.
+  * @param  frames: input frame number.
+  * @note   Linear interpolation, which is transparent for the few hundred ppm a clock drifts.
+  *         The last input frame is held back for the next block, so the first block returns one less.
+  * @retval Output frame number.
+  */
+u32 AUDIO_FMT_ResampleS16(AUDIO_FMT_ResampleTypeDef *State, s16 *dst, const s16 *src, u32 frames)
+{
+	u32 chn_cnt = State->ChnCnt;
+	u64 pos = State->Pos;
+	u32 out = 0;
+	u32 idx;
+	u32 frac;
+	u32 c;
+	const s16 *left;
+	const s16 *right;
+
+	if (frames == 0) {
+		return 0;
+	}
+
+	/* input frame k sits at position k + 1, position 0 is the last frame of the previous block */
+	for (;;) {
+		idx = (u32)(pos >> 32);
+		if (idx >= frames) {
+			break;
+		}
+
+		left = (idx == 0) ? State->Last : &src[(idx - 1) * chn_cnt];
+		right = &src[idx * chn_cnt];
+		frac = (u32)pos >> 17;
+		for (c = 0; c < chn_cnt; c++) {
+			*dst++ = (s16)(left[c] + ((((s32)right[c] - left[c]) * (s32)frac) >> 15));
+		}
+		out++;
+		pos += State->Step;
+	}
+
+	for (c = 0; c < chn_cnt; c++) {
+		State->Last[c] = src[(frames - 1) * chn_cnt + c];
+	}
+	State->Pos = pos - ((u64)frames << 32);
+
+	return out;
+}
+/**
+* @}
+*/
+
+/** @} */
+
+/** @} */
+
+/** @} */
@@ -5,6 +5,7 @@
  */
 
 #include "ameba_soc.h"
+#include <math.h>
 
 static const char *const TAG = "CODEC";
 
@@ -882,6 +883,208 @@ void AUDIO_CODEC_SetADCEQBand(u32 ad_chn, u32 band_sel, u32 newstate)
 
 }
 
+/* EQ coefficients are 2's complement 4.25, 29 bits wide. */
+#define CODEC_EQ_COEF_ONE		(1 << 25)
+#define CODEC_EQ_COEF_MAX		((1 << 28) - 1)
+#define CODEC_EQ_COEF_MIN		(-(1 << 28))
+#define CODEC_EQ_PI				3.14159265358979
+
+static bool audio_codec_eq_quantize(double coef, u32 *reg)
+{
+	double scaled = coef * CODEC_EQ_COEF_ONE;
+	s32 q;
+
+	if (scaled > CODEC_EQ_COEF_MAX || scaled < CODEC_EQ_COEF_MIN) {
+		return FALSE;
+	}
+
+	q = (s32)((scaled < 0) ? (scaled - 0.5) : (scaled + 0.5));
+	*reg = (u32)q & AUD_MASK_ADC_0_BIQUAD_H0_x;
+
+	return TRUE;
+}
+
+/**
+  * @brief  Design one ADC EQ band into the codec biquad format.
+  * @param  Band: filter type, frequency, Q and gain of the band.
+  * @param  sr: adc sample rate in Hz.
+  * @param  EQFilterCoefPoint: returns the coefficients for AUDIO_CODEC_SetADCEQFilter.
+  * @note   Uses the audio EQ cookbook (R. Bristow-Johnson) formulas normalized to a0 = 1, i.e.
+  *         H(z) = (H0 + B1 z^-1 + B2 z^-2) / (1 + A1 z^-1 + A2 z^-2), each in 4.25 format, so
+  *         the band runs y[n] = H0 x[n] + B1 x[n-1] + B2 x[n-2] - A1 y[n-1] - A2 y[n-2].
+  *         CODEC_EQ_BYPASS gives the unity band, the register reset value.
+  * @note   Designed in double, float moves the poles of low bands by tens of LSBs. Below
+  *         fc = sr / 2000 the 4.25 rounding of A1/A2 alone shifts the response by more than
+  *         0.05dB, e.g. a 20Hz low shelf at 96kHz.
+  * @return  TRUE, or FALSE when the parameters are invalid or a coefficient does not fit -8 ~ 7.99,
+  *          which happens only for very large boosts.
+  */
+bool AUDIO_CODEC_DesignEQFilter(CODEC_EQBandParams *Band, u32 sr, CODEC_EQFilterCoef *EQFilterCoefPoint)
+{
+	double w0, cs, alpha, A, sqA;
+	double b0, b1, b2, a0, a1, a2;
+
+	assert_param(IS_CODEC_EQ_Filter_Type(Band->Type));
+
+	if (Band->Type == CODEC_EQ_BYPASS) {
+		EQFilterCoefPoint->H0_Q = CODEC_EQ_COEF_ONE;
+		EQFilterCoefPoint->B1_Q = 0;
+		EQFilterCoefPoint->B2_Q = 0;
+		EQFilterCoefPoint->A1_Q = 0;
+		EQFilterCoefPoint->A2_Q = 0;
+		return TRUE;
+	}
+
+	if (sr == 0 || Band->Fc <= 0 || Band->Fc >= (float)sr / 2 || Band->Q <= 0) {
+		RTK_LOGE(TAG, "invalid EQ band fc:%d sr:%lu\n", (int)Band->Fc, sr);
+		return FALSE;
+	}
+
+	w0 = 2 * CODEC_EQ_PI * Band->Fc / sr;
+	cs = cos(w0);
+	alpha = sin(w0) / (2 * Band->Q);
+	A = pow(10, Band->GainDb / 40.0);
+	sqA = 2 * sqrt(A) * alpha;
+
+	switch (Band->Type) {
+	case CODEC_EQ_PEAKING:
+		b0 = 1 + alpha * A;
+		b1 = -2 * cs;
+		b2 = 1 - alpha * A;
+		a0 = 1 + alpha / A;
+		a1 = -2 * cs;
+		a2 = 1 - alpha / A;
+		break;
+
+	case CODEC_EQ_LOWSHELF:
+		b0 = A * ((A + 1) - (A - 1) * cs + sqA);
+		b1 = 2 * A * ((A - 1) - (A + 1) * cs);
+		b2 = A * ((A + 1) - (A - 1) * cs - sqA);
+		a0 = (A + 1) + (A - 1) * cs + sqA;
+		a1 = -2 * ((A - 1) + (A + 1) * cs);
+		a2 = (A + 1) + (A - 1) * cs - sqA;
+		break;
+
+	case CODEC_EQ_HIGHSHELF:
+		b0 = A * ((A + 1) + (A - 1) * cs + sqA);
+		b1 = -2 * A * ((A - 1) + (A + 1) * cs);
+		b2 = A * ((A + 1) + (A - 1) * cs - sqA);
+		a0 = (A + 1) - (A - 1) * cs + sqA;
+		a1 = 2 * ((A - 1) - (A + 1) * cs);
+		a2 = (A + 1) - (A - 1) * cs - sqA;
+		break;
+
+	case CODEC_EQ_HPF:
+		b0 = (1 + cs) / 2;
+		b1 = -(1 + cs);
+		b2 = b0;
+		a0 = 1 + alpha;
+		a1 = -2 * cs;
+		a2 = 1 - alpha;
+		break;
+
+	case CODEC_EQ_LPF:
+	default:
+		b0 = (1 - cs) / 2;
+		b1 = 1 - cs;
+		b2 = b0;
+		a0 = 1 + alpha;
+		a1 = -2 * cs;
+		a2 = 1 - alpha;
+		break;
+	}
+
+	if (!audio_codec_eq_quantize(b0 / a0, &EQFilterCoefPoint->H0_Q) ||
+		!audio_codec_eq_quantize(b1 / a0, &EQFilterCoefPoint->B1_Q) ||
+		!audio_codec_eq_quantize(b2 / a0, &EQFilterCoefPoint->B2_Q) ||
+		!audio_codec_eq_quantize(a1 / a0, &EQFilterCoefPoint->A1_Q) ||
+		!audio_codec_eq_quantize(a2 / a0, &EQFilterCoefPoint->A2_Q)) {
+		RTK_LOGE(TAG, "EQ coefficient out of range, reduce the gain\n");
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/**
+  * @brief  Design a whole ADC EQ profile, so switching profiles later needs no math.
+  * @param  Bands: band parameters, Bands[n] goes to ADCEQBDn.
+  * @param  band_num: number of bands, 0 ~ 5, the remaining bands are left disabled.
+  * @param  sr: adc sample rate in Hz.
+  * @param  Profile: returns the coefficients and the enable mask of the profile.
+  * @return  TRUE, or FALSE if any band can not be designed.
+  */
+bool AUDIO_CODEC_DesignEQProfile(CODEC_EQBandParams *Bands, u32 band_num, u32 sr, CODEC_EQProfile *Profile)
+{
+	CODEC_EQBandParams bypass = {CODEC_EQ_BYPASS, 0, 0, 0};
+	u32 i;
+
+	assert_param(band_num <= 5);
+
+	Profile->BandMask = 0;
+	for (i = 0; i < 5; i++) {
+		if (i < band_num && Bands[i].Type != CODEC_EQ_BYPASS) {
+			if (!AUDIO_CODEC_DesignEQFilter(&Bands[i], sr, &Profile->Coef[i])) {
+				return FALSE;
+			}
+			Profile->BandMask |= BIT(i);
+		} else {
+			AUDIO_CODEC_DesignEQFilter(&bypass, sr, &Profile->Coef[i]);
+		}
+	}
+
+	return TRUE;
+}
+
+/**
+  * @brief  Load an EQ profile into an adc channel in one call.
+  * @param  ad_chn: select adc channel
+  *          This parameter can be one of the following values:
+  *            @arg ADCHN1
+  *            @arg ADCHN2
+  * @param  Profile: profile built by AUDIO_CODEC_DesignEQProfile.
+  * @note   The bands are switched off with one register write while the coefficients change,
+  *         so no half updated biquad ever runs, then the new band set is enabled at once.
+  *         The EQ clock is turned on when any band is enabled.
+  * @return  None
+  */
+void AUDIO_CODEC_LoadADCEQProfile(u32 ad_chn, CODEC_EQProfile *Profile)
+{
+	CODEC_EQ_BAND_TypeDef *eq_base_addr;
+	__IO uint32_t *eq_ctrl;
+	u32 band_bits = AUD_BIT_ADC_0_BIQUAD_EN_0 | AUD_BIT_ADC_0_BIQUAD_EN_1 | AUD_BIT_ADC_0_BIQUAD_EN_2 |
+					AUD_BIT_ADC_0_BIQUAD_EN_3 | AUD_BIT_ADC_0_BIQUAD_EN_4;
+	u32 i;
+
+	assert_param(IS_CODEC_ADCHN_SEL(ad_chn));
+
+	AUDIO_CODEC_TypeDef *audio_base = AUDIO_CODEC_GetAddr();
+
+	if (ad_chn == ADCHN1) {
+		eq_base_addr = audio_base->CODEC_ADC_0_EQ_BAND;
+		eq_ctrl = &audio_base->CODEC_ADC_0_EQ_CTRL;
+	} else {
+		eq_base_addr = audio_base->CODEC_ADC_1_EQ_BAND;
+		eq_ctrl = &audio_base->CODEC_ADC_1_EQ_CTRL;
+	}
+
+	*eq_ctrl &= ~band_bits;
+
+	for (i = 0; i < 5; i++) {
+		eq_base_addr[i].CODEC_BIQUAD_H0_x = Profile->Coef[i].H0_Q;
+		eq_base_addr[i].CODEC_BIQUAD_B1_x = Profile->Coef[i].B1_Q;
+		eq_base_addr[i].CODEC_BIQUAD_B2_x = Profile->Coef[i].B2_Q;
+		eq_base_addr[i].CODEC_BIQUAD_A1_x = Profile->Coef[i].A1_Q;
+		eq_base_addr[i].CODEC_BIQUAD_A2_x = Profile->Coef[i].A2_Q;
+	}
+
+	if (Profile->BandMask & band_bits) {
+		AUDIO_CODEC_SetADCEQClk(ad_chn, ENABLE);
+	}
+
+	*eq_ctrl |= Profile->BandMask & band_bits;
+}
+
 
 /**
   * @brief  Set ADC path zero detection function.
@@ -6,6 +6,9 @@
 
 #include "ameba_soc.h"
 #include "os_wrapper.h"
+#ifdef __ZEPHYR__
+#include <zephyr/kernel.h>
+#endif
 
 static const char *const TAG = "FLASH";
 uint32_t PrevIrqStatus;
@@ -36,17 +39,88 @@ uint32_t PrevIrqStatus;
 static u32 Start_Timer_Cnt = 0;
 static u32 Start_Systick_Cnt = 0;
 
+static u32 Max_IrqOff_Us = 0;
+/* ticks lost while KM4 locked flash and not caught up yet, written with irq off */
+static u32 Step_Tick_Pending = 0;
+
 u32 xTaskIncrementTick(void);
 u32 xTaskGetTickCountFromISR(void);
+u32 xTaskCatchUpTicks(u32 xTicksToCatchUp);
+u32 xTimerPendFunctionCallFromISR(void (*xFunctionToPend)(void *, u32), void *pvParameter1, u32 ulParameter2, u32 *pxHigherPriorityTaskWoken);
+
+/* runs in the timer service task, takes all ticks recorded since it was pended */
+static void FLASH_Write_CatchUpTick(void *Data, u32 Param)
+{
+	u32 step_tick;
+	u32 IrqStatus;
+
+	(void) Data;
+	(void) Param;
+
+	IrqStatus = irq_disable_save();
+	step_tick = Step_Tick_Pending;
+	Step_Tick_Pending = 0;
+	irq_enable_restore(IrqStatus);
+
+	if (step_tick) {
+		xTaskCatchUpTicks(step_tick);
+	}
+}
+
+/**
+  * @brief  Advance kernel tick after flash lock, called in IPC interrupt with irq disabled.
+  * @param  step_tick: number of ticks lost while KM4 locked flash.
+  * @note   The ticks are only recorded here, FLASH_Write_CatchUpTick is pended to the timer
+  *		service task and processes them by xTaskCatchUpTicks, so the irq-off window does not
+  *		grow with the flash operation time. Only if the timer queue is full, each lost tick is
+  *		processed here by xTaskIncrementTick like the tick interrupt does.
+  * @retval none
+  */
+__weak void FLASH_Write_StepTick(u32 step_tick)
+{
+	u32 pended = Step_Tick_Pending;
+
+	if (step_tick == 0) {
+		return;
+	}
+
+	Step_Tick_Pending = pended + step_tick;
+
+	/* one call in flight takes all ticks recorded till it runs */
+	if (pended != 0) {
+		return;
+	}
+
+	if (xTimerPendFunctionCallFromISR(FLASH_Write_CatchUpTick, NULL, 0, NULL) != TRUE) {
+		Step_Tick_Pending = 0;
+		while (step_tick > 0) {
+			xTaskIncrementTick();
+			step_tick--;
+		}
+	}
+}
+
+/**
+  * @brief  Get the longest irq-off window of FLASH_Write_IPC_Int.
+  * @retval max irq-off time in us.
+  */
+u32 FLASH_Write_IPC_GetMaxIrqOff(void)
+{
+	return Max_IrqOff_Us;
+}
 
 void FLASH_Write_IPC_Int(void *Data, u32 IrqStatus, u32 ChanNum)
 {
+	u32 irq_off_start;
+	u32 irq_off_us;
+
 	/* To avoid gcc warnings */
 	(void) Data;
 	(void) IrqStatus;
 	(void) ChanNum;
 
 	__disable_irq();
+	irq_off_start = DTimestamp_Get();
 
 	PIPC_MSG_STRUCT ipc_msg = (PIPC_MSG_STRUCT)ipc_get_message(IPC_KM4_TO_KM0, IPC_A2N_FLASHPG_REQ);
 	u8 *pflag = (u8 *)ipc_msg->msg;
@@ -71,14 +145,19 @@ void FLASH_Write_IPC_Int(void *Data, u32 IrqStatus, u32 ChanNum)
 
 		u32 step_tick = (time_pass_ms > (systick_pass_tick + 1)) ? (time_pass_ms - (systick_pass_tick + 1)) : 0;
 		/*  update kernel tick */
-		while (step_tick > 0) {
-			xTaskIncrementTick();
-			step_tick --;
-		}
+		FLASH_Write_StepTick(step_tick);
 
 		*pflag = WRITE_SYNC_CLEAR;
 	}
 	DCache_Clean((u32)pflag, sizeof(pflag));
+	/* wake KM4 waiting in WFE for the flag */
+	__DSB();
+	__SEV();
+
+	irq_off_us = DTimestamp_Get() - irq_off_start;
+	if (irq_off_us > Max_IrqOff_Us) {
+		Max_IrqOff_Us = irq_off_us;
+	}
 
 	__enable_irq();
 }
@@ -98,10 +177,22 @@ const IPC_INIT_TABLE ipc_flashpg_table[] = {
 #else
 /* CONFIG_ARM_CORE_CM4 */
 ALIGNMTO(CACHE_LINE_SIZE) static u8 Flash_Sync_Flag[CACHE_LINE_SIZE];
+static u32 Flash_Lock_Hist[FLASH_LOCK_HIST_NUM];
 
-static void Flash_Write_Lock_IPC(u8 sync_type)
+/**
+  * @brief  Send lock/unlock request to KM0 and wait till KM0 clears the flag.
+  * @param  sync_type: WRITE_SYNC_LOCK or WRITE_SYNC_UNLOCK.
+  * @note   KM4 sleeps in WFE between checks of the flag, KM0 executes SEV after its handler
+  *		cleared the flag. Any interrupt of KM4 wakes it as well, so the timeout is checked
+  *		at least every systick, irq must be enabled when this is called.
+  * @retval RTK_SUCCESS, or RTK_FAIL if the request can not be sent or KM0 does not answer
+  *		within FLASH_SYNC_TIMEOUT_US.
+  */
+static int Flash_Write_Lock_IPC(u8 sync_type)
 {
 	IPC_MSG_STRUCT ipc_msg_temp;
+	u32 start, latency;
+
 	/* Set lock flag */
 	Flash_Sync_Flag[0] = sync_type;
 	DCache_Clean((u32)Flash_Sync_Flag, sizeof(Flash_Sync_Flag));
@@ -110,14 +201,45 @@ static void Flash_Write_Lock_IPC(u8 sync_type)
 	ipc_msg_temp.msg = (u32)Flash_Sync_Flag;
 	ipc_msg_temp.msg_len = 1;
 	ipc_msg_temp.rsvd = 0;
-	ipc_send_message(IPC_KM4_TO_KM0, IPC_A2N_FLASHPG_REQ, &ipc_msg_temp);
+
+	start = DTimestamp_Get();
+	if (ipc_send_message(IPC_KM4_TO_KM0, IPC_A2N_FLASHPG_REQ, &ipc_msg_temp) != IPC_SEND_SUCCESS) {
+		RTK_LOGS(TAG, RTK_LOG_ERROR, "Flash_Write_Lock_IPC send fail\n");
+		return RTK_FAIL;
+	}
 
 	while (1) {
 		DCache_Invalidate((u32)Flash_Sync_Flag, sizeof(Flash_Sync_Flag));
 		if (Flash_Sync_Flag[0] == WRITE_SYNC_CLEAR) {
 			break;
 		}
+
+		if (DTimestamp_Get() - start > FLASH_SYNC_TIMEOUT_US) {
+			RTK_LOGS(TAG, RTK_LOG_ERROR, "Flash_Write_Lock_IPC wait KM0 timeout\n");
+			return RTK_FAIL;
+		}
+
+		/* an SEV after the flag was read is latched in the event register, WFE returns at once */
+		__WFE();
 	}
+
+	latency = DTimestamp_Get() - start;
+	Flash_Lock_Hist[IPC_HistBucket(latency, FLASH_LOCK_HIST_NUM)]++;
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Get the cross-core handshake latency histogram of FLASH_Write_Lock/FLASH_Write_Unlock.
+  * @param  hist: array of FLASH_LOCK_HIST_NUM words. hist[0] counts handshakes shorter than 8us,
+  *		hist[i] counts [8us << (i - 1), 8us << i), the last bucket counts all longer ones.
+  * @retval none
+  */
+void FLASH_Write_Lock_GetHist(u32 *hist)
+{
+	assert_param(hist != NULL);
+
+	_memcpy(hist, Flash_Lock_Hist, sizeof(Flash_Lock_Hist));
 }
 #endif
 
@@ -125,9 +247,11 @@ static void Flash_Write_Lock_IPC(u8 sync_type)
   * @brief  This function is used to lock CPU when write or erase flash under XIP.
   * @note
   *		- all interrupt include systick will be stopped.
-  * @retval none
+  *		- on KM4 it fails if KM0 does not answer the lock request within FLASH_SYNC_TIMEOUT_US,
+  *		then nothing is locked and FLASH_Write_Unlock must not be called.
+  * @retval RTK_SUCCESS or RTK_FAIL.
   */
-void FLASH_Write_Lock(void)
+int FLASH_Write_Lock(void)
 {
 	rtos_sched_suspend();
 
@@ -136,26 +260,34 @@ void FLASH_Write_Lock(void)
 	}
 #ifdef CONFIG_ARM_CORE_CM4
 	/* Sent IPC to KM0 */
-	Flash_Write_Lock_IPC(WRITE_SYNC_LOCK);
+	if (Flash_Write_Lock_IPC(WRITE_SYNC_LOCK) != RTK_SUCCESS) {
+		IPC_SEMFree(IPC_SEM_FLASH);
+		rtos_sched_resume();
+		return RTK_FAIL;
+	}
 #endif
 	/* disable irq */
 	PrevIrqStatus = irq_disable_save();
+
+	return RTK_SUCCESS;
 }
 
 /**
   * @brief  This function is used to unlock CPU after write or erase flash under XIP.
   * @note
   *		- all interrupt will be restored.
+  *		- if KM0 does not answer the unlock request, only its tick compensation is lost and
+  *		the lock is released anyway.
   * @retval none
   */
 void FLASH_Write_Unlock(void)
 {
+	/* restore irq, flash is back in auto mode, so KM4 waits for KM0 with irq enabled */
+	irq_enable_restore(PrevIrqStatus);
 #ifdef CONFIG_ARM_CORE_CM4
 	/* Sent IPC to KM0 */
-	Flash_Write_Lock_IPC(WRITE_SYNC_UNLOCK);
+	(void) Flash_Write_Lock_IPC(WRITE_SYNC_UNLOCK);
 #endif
-	/* restore irq */
-	irq_enable_restore(PrevIrqStatus);
 
 	IPC_SEMFree(IPC_SEM_FLASH);
 
@@ -173,7 +305,9 @@ void FLASH_Write_Unlock(void)
 */
 void FLASH_RxCmdXIP(u8 cmd, u32 read_len, u8 *read_data)
 {
-	FLASH_Write_Lock();
+	if (FLASH_Write_Lock() != RTK_SUCCESS) {
+		return;
+	}
 
 	FLASH_RxCmd(cmd, read_len, read_data);
 
@@ -190,7 +324,9 @@ void FLASH_RxCmdXIP(u8 cmd, u32 read_len, u8 *read_data)
   */
 void FLASH_SetStatusXIP(u8 Cmd, u32 Len, u8 *Status)
 {
-	FLASH_Write_Lock();
+	if (FLASH_Write_Lock() != RTK_SUCCESS) {
+		return;
+	}
 
 	FLASH_SetStatus(Cmd, Len, Status);
 
@@ -205,7 +341,9 @@ void FLASH_SetStatusXIP(u8 Cmd, u32 Len, u8 *Status)
   */
 void FLASH_SetStatusBitsXIP(u32 SetBits, u32 NewState)
 {
-	FLASH_Write_Lock();
+	if (FLASH_Write_Lock() != RTK_SUCCESS) {
+		return;
+	}
 
 	FLASH_SetStatusBits(SetBits, NewState);
 
@@ -224,7 +362,9 @@ void FLASH_SetStatusBitsXIP(u32 SetBits, u32 NewState)
   */
 void FLASH_EraseXIP(u32 EraseType, u32 Address)
 {
-	FLASH_Write_Lock();
+	if (FLASH_Write_Lock() != RTK_SUCCESS) {
+		return;
+	}
 
 	FLASH_Erase(EraseType, Address);
 	if (EraseType == EraseSector) {
@@ -264,6 +404,228 @@ int  FLASH_ReadStream(u32 address, u32 len, u8 *pbuf)
 	return 1;
 }
 
+static FLASH_ReadStatTypeDef FLASH_ReadStat;
+
+struct flash_bulk_read_s {
+	u8 ch_num;
+	volatile u32 dma_done;
+	u32 isr_type;
+};
+
+static u32 FLASH_BulkRead_DmaIrq(void *pData)
+{
+	struct flash_bulk_read_s *ctx = (struct flash_bulk_read_s *)pData;
+
+	ctx->isr_type = GDMA_ClearINT(0, ctx->ch_num);
+	GDMA_Cmd(0, ctx->ch_num, DISABLE);
+
+	ctx->dma_done = 1;
+	return 0;
+}
+
+/**
+  * @brief  Read flash by GDMA from the SPIC auto mode address space, data never goes through D-Cache.
+  * @param  ctx: per call context, its GDMA channel is allocated with ctx as irq data.
+  * @param  address: flash offset.
+  * @param  len: length to read, multiple of cache line size.
+  * @param  pbuf: destination buffer, cache line aligned, must not be a flash address.
+  * @note   IPC_SEM_FLASH is held while each chunk is moved, so FLASH_Write_Lock on either
+  *		core can not switch SPIC to user mode under the GDMA.
+  * @retval TRUE: done, FALSE: GDMA error or timeout.
+  */
+static u32 FLASH_BulkRead_Dma(struct flash_bulk_read_s *ctx, u32 address, u32 len, u8 *pbuf)
+{
+	GDMA_InitTypeDef GDMA_InitStruct;
+	u32 src_shift = (address & 0x03) ? 0 : 2;
+	u32 start;
+	u32 size;
+
+	GDMA_StructInit(&GDMA_InitStruct);
+	GDMA_InitStruct.GDMA_Index = 0;
+	GDMA_InitStruct.GDMA_ChNum = ctx->ch_num;
+	GDMA_InitStruct.GDMA_DIR = TTFCMemToMem;
+	GDMA_InitStruct.GDMA_IsrType = (TransferType | ErrType);
+	GDMA_InitStruct.GDMA_SrcMsize = MsizeEight;
+	GDMA_InitStruct.GDMA_DstMsize = MsizeEight;
+	GDMA_InitStruct.GDMA_SrcDataWidth = src_shift ? TrWidthFourBytes : TrWidthOneByte;
+	GDMA_InitStruct.GDMA_DstDataWidth = TrWidthFourBytes;
+
+	/* dirty lines of pbuf must not be written back over DMA data */
+	DCache_CleanInvalidate((u32)pbuf, len);
+
+	while (len) {
+		/* same number of source items per block whatever the source width */
+		size = MIN(len, (FLASH_BULK_READ_DMA_CHUNK >> 2) << src_shift);
+
+		/* BlockSize is counted in source items */
+		GDMA_InitStruct.GDMA_BlockSize = size >> src_shift;
+		GDMA_InitStruct.GDMA_SrcAddr = SPI_FLASH_BASE + address;
+		GDMA_InitStruct.GDMA_DstAddr = (u32)pbuf;
+
+		/* scheduler is suspended first like FLASH_Write_Lock, so a writer on this core can not
+		preempt us and spin on the sema we hold */
+		rtos_sched_suspend();
+		while (IPC_SEMTake(IPC_SEM_FLASH, 1000) != TRUE) {
+			RTK_LOGS(TAG, RTK_LOG_ERROR, "FLASH_ReadStreamBulk get hw sema fail\n");
+		}
+
+		ctx->dma_done = 0;
+		ctx->isr_type = 0;
+		GDMA_Init(0, ctx->ch_num, &GDMA_InitStruct);
+		GDMA_Cmd(0, ctx->ch_num, ENABLE);
+
+		start = DTimestamp_Get();
+		while (ctx->dma_done == 0) {
+			if (DTimestamp_Get() - start > FLASH_BULK_READ_TIMEOUT_US) {
+				/* a late interrupt must not reach ctx once the caller's stack is gone */
+				GDMA_INTConfig(0, ctx->ch_num, TransferType | ErrType, DISABLE);
+				GDMA_Abort(0, ctx->ch_num);
+				GDMA_ClearINT(0, ctx->ch_num);
+				break;
+			}
+		}
+
+		IPC_SEMFree(IPC_SEM_FLASH);
+		rtos_sched_resume();
+
+		/* drop lines speculatively fetched during the transfer */
+		DCache_Invalidate((u32)pbuf, size);
+
+		if ((ctx->dma_done == 0) || (ctx->isr_type & ErrType)) {
+			RTK_LOGS(TAG, RTK_LOG_ERROR, "FLASH_ReadStreamBulk GDMA %s at %08x\n",
+					 ctx->dma_done ? "error" : "timeout", address);
+			return FALSE;
+		}
+
+		address += size;
+		pbuf += size;
+		len -= size;
+	}
+
+	return TRUE;
+}
+
+/**
+  * @brief  Read flash in SPIC user mode, used when no GDMA channel is free.
+  * @param  address: flash offset.
+  * @param  len: length to read.
+  * @param  pbuf: destination buffer, must not be a flash address.
+  * @note   XIP is forbidden in user mode, so the CPU is locked for every FLASH_BULK_READ_USER_CHUNK bytes.
+  * @retval TRUE: done, FALSE: FLASH_Write_Lock failed.
+  */
+static u32 FLASH_BulkRead_UserMode(u32 address, u32 len, u8 *pbuf)
+{
+	u32 size;
+
+	while (len) {
+		size = (len > FLASH_BULK_READ_USER_CHUNK) ? FLASH_BULK_READ_USER_CHUNK : len;
+
+		if (FLASH_Write_Lock() != RTK_SUCCESS) {
+			return FALSE;
+		}
+		FLASH_RxData((u8)flash_init_para.FLASH_cur_cmd, address, size, pbuf);
+		FLASH_Write_Unlock();
+
+		address += size;
+		pbuf += size;
+		len -= size;
+	}
+
+	return TRUE;
+}
+
+/**
+  * @brief  Read a stream of data from specified address, large reads bypass the flash cache.
+  * @param  address: Specifies the starting address to read from.
+  * @param  len: Specifies the length of the data to read.
+  * @param  pbuf: Specified the address to save the readback data.
+  * @note   Reads shorter than FLASH_BULK_READ_THRESHOLD are the same as FLASH_ReadStream. Longer ones are
+  *		moved by GDMA (or SPIC user mode if no channel is free), so OTA verification or asset loading
+  *		do not evict hot code and data from cache.
+  * @note   Must be called in task context.
+  * @retval   status: Success:1 or Failure: 0 (GDMA error or timeout, or FLASH_Write_Lock failed, pbuf is
+  *		partly filled).
+  */
+int FLASH_ReadStreamBulk(u32 address, u32 len, u8 *pbuf)
+{
+	struct flash_bulk_read_s ctx;
+	u32 start = SYSTIMER_TickGet();
+	u32 head, body;
+	int ret = 1;
+
+	assert_param(pbuf != NULL);
+
+	if (IS_FLASH_ADDR((u32)pbuf)) {
+		RTK_LOGE(NOTAG, "function %s, dest address(%08x) can not be flash address\r\n", __func__, pbuf);
+		assert_param(0);
+	}
+
+	if (len < FLASH_BULK_READ_THRESHOLD) {
+		_memcpy(pbuf, (const void *)(SPI_FLASH_BASE + address), len);
+
+		FLASH_ReadStat.xip_read_cnt++;
+		FLASH_ReadStat.xip_read_bytes += len;
+		FLASH_ReadStat.xip_line_fills += (CACHE_LINE_ALIGNMENT(address + len) - (address & CACHE_LINE_ADDR_MSK)) / CACHE_LINE_SIZE;
+		FLASH_ReadStat.xip_read_ticks += SYSTIMER_GetPassTick(start);
+		return 1;
+	}
+
+	/* the direct read only fills whole cache lines of pbuf, so invalidating them never drops
+	data next to pbuf, the partial lines at both ends are read by XIP */
+	head = CACHE_LINE_ALIGNMENT(pbuf) - (u32)pbuf;
+	body = (len - head) & CACHE_LINE_ADDR_MSK;
+
+	_memcpy(pbuf, (const void *)(SPI_FLASH_BASE + address), head);
+
+	ctx.ch_num = GDMA_ChnlAlloc(0, (IRQ_FUN)FLASH_BulkRead_DmaIrq, (u32)&ctx, INT_PRI_MIDDLE);
+	if (ctx.ch_num == 0xFF) {
+		if (FLASH_BulkRead_UserMode(address + head, body, pbuf + head) == FALSE) {
+			ret = 0;
+		}
+		FLASH_ReadStat.user_mode_fallback++;
+	} else {
+		if (FLASH_BulkRead_Dma(&ctx, address + head, body, pbuf + head) == FALSE) {
+			ret = 0;
+		}
+		GDMA_ChnlFree(0, ctx.ch_num);
+	}
+
+	if (ret == 0) {
+		/* pbuf is partly filled, a failed read is not throughput */
+		return 0;
+	}
+
+	_memcpy(pbuf + head + body, (const void *)(SPI_FLASH_BASE + address + head + body), len - head - body);
+
+	FLASH_ReadStat.direct_read_cnt++;
+	FLASH_ReadStat.direct_read_bytes += len;
+	FLASH_ReadStat.direct_read_ticks += SYSTIMER_GetPassTick(start);
+
+	return 1;
+}
+
+/**
+  * @brief  Get the statistics of FLASH_ReadStreamBulk.
+  * @param  stats: pointer to a FLASH_ReadStatTypeDef to save the counters.
+  * @note   Throughput of each path is xxx_read_bytes / (xxx_read_ticks * 31us).
+  * @retval none
+  */
+void FLASH_GetReadStats(FLASH_ReadStatTypeDef *stats)
+{
+	assert_param(stats != NULL);
+
+	_memcpy(stats, &FLASH_ReadStat, sizeof(FLASH_ReadStatTypeDef));
+}
+
+/**
+  * @brief  Clear the statistics of FLASH_ReadStreamBulk.
+  * @retval none
+  */
+void FLASH_ClearReadStats(void)
+{
+	_memset(&FLASH_ReadStat, 0, sizeof(FLASH_ReadStatTypeDef));
+}
+
 /**
   * @brief  Write a stream of data to specified address
   * @param  address: Specifies the starting address to write to.
@@ -292,7 +654,9 @@ int  FLASH_WriteStream(u32 address, u32 len, u8 *pbuf)
 		assert_param(0);
 	}
 
-	FLASH_Write_Lock();
+	if (FLASH_Write_Lock() != RTK_SUCCESS) {
+		return 0;
+	}
 	while (page_cnt) {
 		FLASH_TxData(addr_begin, size, pbuf);
 		pbuf += size;
@@ -315,6 +679,336 @@ exit:
   * @}
   */
 
+/** @defgroup FLASH_WriteBuffer_Functions FLASH Write Buffer Functions
+  * @note Coalesce small sequential writes in a RAM page buffer, so that FLASH_Write_Lock is
+  *		taken once per page instead of once per write.
+  * @{
+  */
+
+struct flash_write_buf_s {
+	u8 buf[FLASH_WB_PAGE_SIZE];
+	u32 page_addr;
+	u32 lo;
+	u32 hi;
+	u32 timeout_ms;
+	u32 put_tick;			/* SYSTIMER tick of the oldest pending byte */
+	rtos_sema_t lock;
+#ifdef __ZEPHYR__
+	struct k_work_delayable work;
+#endif
+	void (*flush_hook)(u32 address, u32 len);
+	FLASH_WriteBufStatTypeDef stat;
+};
+
+static struct flash_write_buf_s flash_wb;
+
+/* caller holds flash_wb.lock */
+static int FLASH_WriteBuffer_Flush(u32 *counter)
+{
+	u32 address;
+	u32 len;
+	int ret;
+
+	if (flash_wb.hi == flash_wb.lo) {
+		return 1;
+	}
+
+#ifdef __ZEPHYR__
+	k_work_cancel_delayable(&flash_wb.work);
+#endif
+
+	address = flash_wb.page_addr + flash_wb.lo;
+	len = flash_wb.hi - flash_wb.lo;
+
+	ret = FLASH_WriteStream(address, len, flash_wb.buf + flash_wb.lo);
+
+	flash_wb.stat.flush_cnt++;
+	(*counter)++;
+
+	/* bytes not written are 0xFF, programming them is a no-op */
+	_memset(flash_wb.buf, 0xFF, FLASH_WB_PAGE_SIZE);
+	flash_wb.lo = flash_wb.hi = 0;
+
+	if ((ret == 1) && flash_wb.flush_hook) {
+		flash_wb.flush_hook(address, len);
+	}
+
+	return ret;
+}
+
+/* caller holds flash_wb.lock */
+static int FLASH_WriteBuffer_Expired(void)
+{
+	return (flash_wb.hi != flash_wb.lo) && (SYSTIMER_GetPassTime(flash_wb.put_tick) >= flash_wb.timeout_ms);
+}
+
+#ifdef __ZEPHYR__
+/* runs in the system work queue thread, never in interrupt context */
+static void FLASH_WriteBuffer_Timeout(struct k_work *work)
+{
+	(void) work;
+
+	rtos_sema_take(flash_wb.lock, FLASH_WB_MAX_DELAY);
+	if (FLASH_WriteBuffer_Flush(&flash_wb.stat.flush_timeout) != 1) {
+		RTK_LOGS(TAG, RTK_LOG_ERROR, "flash write buffer timeout flush fail\n");
+	}
+	rtos_sema_give(flash_wb.lock);
+}
+#endif
+
+/**
+  * @brief  Init the flash write buffer.
+  * @param  timeout_ms: buffered data is flushed at most timeout_ms after it is written.
+  * @param  flush_hook: called with address and length after each flush, can be NULL.
+  *		It can be used to commit a journal entry once data really lands in flash.
+  * @note   The timeout flush runs in the Zephyr system work queue. Other builds flush expired
+  *		data on the next FLASH_WriteStreamBuffered or FLASH_WriteBufferPoll.
+  * @note   Can be called once, a second call fails and leaves the buffer as it is.
+  * @retval RTK_SUCCESS or RTK_FAIL.
+  */
+int FLASH_WriteBufferInit(u32 timeout_ms, void (*flush_hook)(u32 address, u32 len))
+{
+	assert_param(timeout_ms != 0);
+
+	if (flash_wb.lock != NULL) {
+		RTK_LOGE(NOTAG, "function %s, write buffer already initialized\r\n", __func__);
+		return RTK_FAIL;
+	}
+
+	_memset(&flash_wb, 0, sizeof(flash_wb));
+	_memset(flash_wb.buf, 0xFF, FLASH_WB_PAGE_SIZE);
+	flash_wb.timeout_ms = timeout_ms;
+	flash_wb.flush_hook = flush_hook;
+
+	/* binary semaphore given once is used as the buffer lock */
+	if (rtos_sema_create_binary(&flash_wb.lock) != RTK_SUCCESS) {
+		return RTK_FAIL;
+	}
+	rtos_sema_give(flash_wb.lock);
+
+#ifdef __ZEPHYR__
+	k_work_init_delayable(&flash_wb.work, FLASH_WriteBuffer_Timeout);
+#endif
+
+	return RTK_SUCCESS;
+}
+
+/* caller holds flash_wb.lock, [address, address + len) is inside one page */
+static int FLASH_WriteBuffer_Put(u32 address, u32 len, u8 *pbuf)
+{
+	u32 page_addr = address & ~(FLASH_WB_PAGE_SIZE - 1);
+	u32 offset = address - page_addr;
+	int ret = 1;
+	u32 i;
+
+	flash_wb.stat.put_cnt++;
+
+	if ((flash_wb.hi != flash_wb.lo) && (flash_wb.page_addr != page_addr)) {
+		ret = FLASH_WriteBuffer_Flush(&flash_wb.stat.flush_switch);
+	}
+
+	if (flash_wb.hi == flash_wb.lo) {
+		flash_wb.page_addr = page_addr;
+		flash_wb.lo = offset;
+		flash_wb.hi = offset + len;
+		flash_wb.put_tick = SYSTIMER_TickGet();
+#ifdef __ZEPHYR__
+		k_work_schedule(&flash_wb.work, K_MSEC(flash_wb.timeout_ms));
+#endif
+	} else {
+		flash_wb.lo = (offset < flash_wb.lo) ? offset : flash_wb.lo;
+		flash_wb.hi = (offset + len > flash_wb.hi) ? (offset + len) : flash_wb.hi;
+	}
+
+	/* same result as programming flash twice */
+	for (i = 0; i < len; i++) {
+		flash_wb.buf[offset + i] &= pbuf[i];
+	}
+	flash_wb.stat.bytes_buffered += len;
+
+	if ((flash_wb.lo == 0) && (flash_wb.hi == FLASH_WB_PAGE_SIZE)) {
+		if (FLASH_WriteBuffer_Flush(&flash_wb.stat.flush_full) != 1) {
+			ret = 0;
+		}
+	}
+
+	return ret;
+}
+
+/**
+  * @brief  Write a stream of data through the page buffer.
+  * @param  address: Specifies the starting address to write to.
+  * @param  len: Specifies the length of the data to write.
+  * @param  pbuf: Pointer to a byte array that is to be written.
+  * @note   The page is written when it is full, when another page is written, on
+  *		FLASH_WriteBufferSync or once the timeout has expired. Writes of one page or more bypass
+  *		the buffer. Call FLASH_WriteBufferSync before reading back or erasing the area.
+  * @note   Must be called in task context.
+  * @retval   status: Success:1 or Failure: 0, a failed flush of earlier buffered data is
+  *		reported by the write that triggered it.
+  */
+int FLASH_WriteStreamBuffered(u32 address, u32 len, u8 *pbuf)
+{
+	int expired = 1;
+	u32 first;
+	int ret;
+
+	assert_param(flash_wb.lock != NULL);
+
+	if (len == 0) {
+		return 1;
+	}
+
+	if (IS_FLASH_ADDR((u32)pbuf)) {
+		RTK_LOGE(NOTAG, "function %s, source address(%08x) can not be flash address\r\n", __func__, pbuf);
+		assert_param(0);
+	}
+
+	if (CPU_InInterrupt()) {
+		RTK_LOGE(NOTAG, "function %s, can not be called in interrupt\r\n", __func__);
+		assert_param(0);
+		return 0;
+	}
+
+	rtos_sema_take(flash_wb.lock, FLASH_WB_MAX_DELAY);
+
+	flash_wb.stat.write_cnt++;
+
+	if (FLASH_WriteBuffer_Expired()) {
+		expired = FLASH_WriteBuffer_Flush(&flash_wb.stat.flush_timeout);
+	}
+
+	if (len >= FLASH_WB_PAGE_SIZE) {
+		/* keep program order, then write directly */
+		ret = FLASH_WriteBuffer_Flush(&flash_wb.stat.flush_bypass);
+		if (FLASH_WriteStream(address, len, pbuf) != 1) {
+			ret = 0;
+		}
+		flash_wb.stat.put_cnt++;
+		flash_wb.stat.flush_cnt++;
+	} else {
+		first = FLASH_WB_PAGE_SIZE - (address & (FLASH_WB_PAGE_SIZE - 1));
+		if (first >= len) {
+			ret = FLASH_WriteBuffer_Put(address, len, pbuf);
+		} else {
+			ret = FLASH_WriteBuffer_Put(address, first, pbuf);
+			if (FLASH_WriteBuffer_Put(address + first, len - first, pbuf + first) != 1) {
+				ret = 0;
+			}
+		}
+	}
+
+	rtos_sema_give(flash_wb.lock);
+
+	return ((ret == 1) && (expired == 1)) ? 1 : 0;
+}
+
+/**
+  * @brief  Write buffered data to flash now.
+  * @note   Must be called in task context.
+  * @retval   status: Success:1 or Failure: 0.
+  */
+int FLASH_WriteBufferSync(void)
+{
+	int ret;
+
+	if (flash_wb.lock == NULL) {
+		return 1;
+	}
+
+	if (CPU_InInterrupt()) {
+		RTK_LOGE(NOTAG, "function %s, can not be called in interrupt\r\n", __func__);
+		assert_param(0);
+		return 0;
+	}
+
+	rtos_sema_take(flash_wb.lock, FLASH_WB_MAX_DELAY);
+	ret = FLASH_WriteBuffer_Flush(&flash_wb.stat.flush_sync);
+	rtos_sema_give(flash_wb.lock);
+
+	return ret;
+}
+
+/**
+  * @brief  Write buffered data to flash if its timeout has expired.
+  * @note   Without the Zephyr work queue nothing flushes an idle buffer, call it periodically
+  *		from a task, e.g. the idle hook or a housekeeping task.
+  * @note   Must be called in task context.
+  * @retval   status: Success:1 or Failure: 0.
+  */
+int FLASH_WriteBufferPoll(void)
+{
+	int ret = 1;
+
+	if (flash_wb.lock == NULL) {
+		return 1;
+	}
+
+	if (CPU_InInterrupt()) {
+		RTK_LOGE(NOTAG, "function %s, can not be called in interrupt\r\n", __func__);
+		assert_param(0);
+		return 0;
+	}
+
+	rtos_sema_take(flash_wb.lock, FLASH_WB_MAX_DELAY);
+	if (FLASH_WriteBuffer_Expired()) {
+		ret = FLASH_WriteBuffer_Flush(&flash_wb.stat.flush_timeout);
+	}
+	rtos_sema_give(flash_wb.lock);
+
+	return ret;
+}
+
+/**
+  * @brief  Get number of bytes in the write buffer which are not in flash yet.
+  * @param  address: if not NULL, return the flash address of the first pending byte.
+  * @note   Must be called in task context.
+  * @retval pending length.
+  */
+u32 FLASH_WriteBufferPending(u32 *address)
+{
+	u32 pending;
+
+	if (address) {
+		*address = 0;
+	}
+
+	if (flash_wb.lock == NULL) {
+		return 0;
+	}
+
+	if (CPU_InInterrupt()) {
+		RTK_LOGE(NOTAG, "function %s, can not be called in interrupt\r\n", __func__);
+		assert_param(0);
+		return 0;
+	}
+
+	rtos_sema_take(flash_wb.lock, FLASH_WB_MAX_DELAY);
+	pending = flash_wb.hi - flash_wb.lo;
+	if (address) {
+		*address = flash_wb.page_addr + flash_wb.lo;
+	}
+	rtos_sema_give(flash_wb.lock);
+
+	return pending;
+}
+
+/**
+  * @brief  Get the statistics of the flash write buffer.
+  * @param  stats: pointer to a FLASH_WriteBufStatTypeDef to save the counters.
+  * @note   FLASH_Write_Lock acquisitions saved = put_cnt - flush_cnt.
+  * @retval none
+  */
+void FLASH_WriteBufferGetStats(FLASH_WriteBufStatTypeDef *stats)
+{
+	assert_param(stats != NULL);
+
+	_memcpy(stats, &flash_wb.stat, sizeof(FLASH_WriteBufStatTypeDef));
+}
+/**
+  * @}
+  */
+
 /**
   * @}
   */
@@ -546,14 +546,29 @@ u8 I2C_ReceiveData(I2C_TypeDef *I2Cx)
 u32 I2C_MasterWrite(I2C_TypeDef *I2Cx, u8 *pBuf, u32 len)
 {
 	u32 cnt = 0;
+	u32 room;
+
+	/* Write in the DR register the data to be sent, as many as the TX FIFO can hold */
+	room = I2C_TRX_BUFFER_DEPTH - (I2Cx->IC_TXFLR & I2C_MASK_TXFLR);
+	while (cnt < len) {
+		if (room == 0) {
+			/* full, TFNF frees one entry, about all the bus sends while polling */
+			if (I2C_PollFlagRawINT(I2Cx, I2C_BIT_TFNF, 0, I2C_POLL_TIMEOUT_MS) != RTK_SUCCESS) {
+				return cnt;
+			}
+			room = 1;
+		}
 
-	/* Write in the DR register the data to be sent */
-	for (cnt = 0; cnt < len; cnt++) {
-		if (I2C_PollFlagRawINT(I2Cx, I2C_BIT_TFNF, 0, I2C_POLL_TIMEOUT_MS) != RTK_SUCCESS) {
-			return cnt;
+		if (room > len - cnt) {
+			room = len - cnt;
 		}
+		cnt += room;
 
-		if (cnt >= len - 1) {
+		while (--room) {
+			I2Cx->IC_DATA_CMD = (*pBuf++);
+		}
+
+		if (cnt == len) {
 			/*generate stop signal*/
 			I2Cx->IC_DATA_CMD = (*pBuf++) | (1 << 9);
 		} else {
@@ -616,6 +631,8 @@ u32 I2C_MasterReadDW(I2C_TypeDef *I2Cx, u8 *pBuf, u32 len)
 
 /**
   * @brief  Read data with special length in master mode through the I2Cx peripheral under in-house IP.
+  * @note   Read commands are issued ahead of the data, at most I2C_TRX_BUFFER_DEPTH
+  *		bytes are outstanding so the RX FIFO can always hold them.
   * @param  I2Cx: where I2Cx can be I2C0_DEV, I2C1_DEV and I2C2_DEV.
   * @param  pBuf: point to the buffer to hold the received data.
   * @param  len: the length of data that to be received.
@@ -624,30 +641,44 @@ u32 I2C_MasterReadDW(I2C_TypeDef *I2Cx, u8 *pBuf, u32 len)
 u32 I2C_MasterRead(I2C_TypeDef *I2Cx, u8 *pBuf, u32 len)
 {
 	u32 cnt = 0;
-	u32 skip_cnt = 0;
-	s32 poll_state;
+	u32 cmd_cnt = 0;
+	u32 room;
+	u32 level;
+
+	while (cnt < len) {
+		/* queue read commands, each command in the TX FIFO is outstanding, so bounding
+		   the outstanding bytes by the RX FIFO depth bounds the TX FIFO entries too */
+		room = I2C_TRX_BUFFER_DEPTH - (cmd_cnt - cnt);
+		if (room > len - cmd_cnt) {
+			room = len - cmd_cnt;
+		}
 
-	/* read in the DR register the data to be received */
-	for (cnt = 0; cnt < len; cnt++) {
+		while (room--) {
+			cmd_cnt++;
+			if (cmd_cnt == len) {
+				/* generate stop singal */
+				I2Cx->IC_DATA_CMD = 0x0003 << 8;
+			} else {
+				I2Cx->IC_DATA_CMD = 0x0001 << 8;
+			}
+		}
 
-		if (cnt >= len - 1) {
-			/* generate stop singal */
-			I2Cx->IC_DATA_CMD = 0x0003 << 8;
-		} else {
-			I2Cx->IC_DATA_CMD = 0x0001 << 8;
+		/* wait for I2C_FLAG_RFNE flag, then drain what has arrived */
+		if (I2C_PollFlagRawINT(I2Cx, I2C_BIT_RFNE, 0, I2C_POLL_TIMEOUT_MS) != RTK_SUCCESS) {
+			return cnt;
 		}
 
-		/* wait for I2C_FLAG_RFNE flag */
-		poll_state = I2C_PollFlagRawINT(I2Cx, I2C_BIT_RFNE, 0, I2C_POLL_TIMEOUT_MS);
-		if (poll_state == RTK_ERR_TIMEOUT) {
-			skip_cnt++;
-		} else if (poll_state == RTK_FAIL) {
-			return cnt - skip_cnt;
-		} else {
+		level = I2Cx->IC_RXFLR & I2C_MASK_RXFLR;
+		if (level > len - cnt) {
+			level = len - cnt;
+		}
+		cnt += level;
+		while (level--) {
 			*pBuf++ = (u8)I2Cx->IC_DATA_CMD;
 		}
 	}
-	return cnt - skip_cnt;
+
+	return cnt;
 }
 
 /**
@@ -949,38 +980,22 @@ void I2C_DmaMode2Config(I2C_TypeDef *I2Cx, u32 I2C_DmaCmd, u32 I2C_DmaBLen)
 }
 
 /**
-  * @brief    Init and Enable I2C TX GDMA.
+  * @brief  Fill GDMA_InitStruct for an I2C TX transfer on an allocated channel.
   * @param  Index: 0 .
-  * @param  GDMA_InitStruct: pointer to a GDMA_InitTypeDef structure that contains
-  *         the configuration information for the GDMA peripheral.
-  * @param  CallbackData: GDMA callback data.
-  * @param  CallbackFunc: GDMA callback function.
+  * @param  GDMA_InitStruct: pointer to a GDMA_InitTypeDef structure to fill.
+  * @param  GdmaChnl: GDMA channel already allocated by the caller.
   * @param  pTxBuf: Tx Buffer.
   * @param  TxCount: Tx Count.
-  * @retval   TRUE/FLASE
-  * @note can not support legacy DMA mode
+  * @retval None
   */
-bool I2C_TXGDMA_Init(
+static void I2C_TXGDMA_Config(
 	u8 Index,
 	GDMA_InitTypeDef *GDMA_InitStruct,
-	void *CallbackData,
-	IRQ_FUN CallbackFunc,
+	u8 GdmaChnl,
 	u8 *pTxBuf,
 	int TxCount
 )
 {
-	u8 GdmaChnl;
-
-	assert_param(GDMA_InitStruct != NULL);
-
-	DCache_CleanInvalidate((u32) pTxBuf, TxCount);
-
-	GdmaChnl = GDMA_ChnlAlloc(0, (IRQ_FUN)CallbackFunc, (u32)CallbackData, 5);
-	if (GdmaChnl == 0xFF) {
-		/*  No Available DMA channel */
-		return FALSE;
-	}
-
 	_memset((void *)GDMA_InitStruct, 0, sizeof(GDMA_InitTypeDef));
 
 	GDMA_InitStruct->MuliBlockCunt     = 0;
@@ -1014,46 +1029,66 @@ bool I2C_TXGDMA_Init(
 	assert_param(GDMA_InitStruct->GDMA_BlockSize <= 4096);
 
 	GDMA_InitStruct->GDMA_SrcAddr = (u32)(pTxBuf);
-
-	GDMA_Init(GDMA_InitStruct->GDMA_Index, GDMA_InitStruct->GDMA_ChNum, GDMA_InitStruct);
-	GDMA_Cmd(GDMA_InitStruct->GDMA_Index, GDMA_InitStruct->GDMA_ChNum, ENABLE);
-
-	return TRUE;
 }
 
 /**
-  * @brief    Init and Enable I2C RX GDMA.
-  * @param  I2C Index: 0.
+  * @brief    Init and Enable I2C TX GDMA.
+  * @param  Index: 0 .
   * @param  GDMA_InitStruct: pointer to a GDMA_InitTypeDef structure that contains
   *         the configuration information for the GDMA peripheral.
   * @param  CallbackData: GDMA callback data.
   * @param  CallbackFunc: GDMA callback function.
-  * @param  pRxBuf: Rx Buffer.
-  * @param  RxCount: Rx Count.
+  * @param  pTxBuf: Tx Buffer.
+  * @param  TxCount: Tx Count.
   * @retval   TRUE/FLASE
-  * @note support Master or Slave RXDMA
+  * @note can not support legacy DMA mode
   */
-bool I2C_RXGDMA_Init(
+bool I2C_TXGDMA_Init(
 	u8 Index,
 	GDMA_InitTypeDef *GDMA_InitStruct,
 	void *CallbackData,
 	IRQ_FUN CallbackFunc,
-	u8 *pRxBuf,
-	int RxCount
+	u8 *pTxBuf,
+	int TxCount
 )
 {
 	u8 GdmaChnl;
 
 	assert_param(GDMA_InitStruct != NULL);
 
-	DCache_CleanInvalidate((u32) pRxBuf, RxCount);
+	DCache_CleanInvalidate((u32) pTxBuf, TxCount);
 
 	GdmaChnl = GDMA_ChnlAlloc(0, (IRQ_FUN)CallbackFunc, (u32)CallbackData, 5);
 	if (GdmaChnl == 0xFF) {
-		/* No Available DMA channel */
+		/*  No Available DMA channel */
 		return FALSE;
 	}
 
+	I2C_TXGDMA_Config(Index, GDMA_InitStruct, GdmaChnl, pTxBuf, TxCount);
+
+	GDMA_Init(GDMA_InitStruct->GDMA_Index, GDMA_InitStruct->GDMA_ChNum, GDMA_InitStruct);
+	GDMA_Cmd(GDMA_InitStruct->GDMA_Index, GDMA_InitStruct->GDMA_ChNum, ENABLE);
+
+	return TRUE;
+}
+
+/**
+  * @brief  Fill GDMA_InitStruct for an I2C RX transfer on an allocated channel.
+  * @param  I2C Index: 0.
+  * @param  GDMA_InitStruct: pointer to a GDMA_InitTypeDef structure to fill.
+  * @param  GdmaChnl: GDMA channel already allocated by the caller.
+  * @param  pRxBuf: Rx Buffer.
+  * @param  RxCount: Rx Count.
+  * @retval None
+  */
+static void I2C_RXGDMA_Config(
+	u8 Index,
+	GDMA_InitTypeDef *GDMA_InitStruct,
+	u8 GdmaChnl,
+	u8 *pRxBuf,
+	int RxCount
+)
+{
 	_memset((void *)GDMA_InitStruct, 0, sizeof(GDMA_InitTypeDef));
 
 	GDMA_InitStruct->GDMA_DIR      = TTFCPeriToMem;
@@ -1087,6 +1122,42 @@ bool I2C_RXGDMA_Init(
 	GDMA_InitStruct->MuliBlockCunt     = 0;
 	GDMA_InitStruct->GDMA_ReloadSrc = 0;
 	GDMA_InitStruct->MaxMuliBlock = 1;
+}
+
+/**
+  * @brief    Init and Enable I2C RX GDMA.
+  * @param  I2C Index: 0.
+  * @param  GDMA_InitStruct: pointer to a GDMA_InitTypeDef structure that contains
+  *         the configuration information for the GDMA peripheral.
+  * @param  CallbackData: GDMA callback data.
+  * @param  CallbackFunc: GDMA callback function.
+  * @param  pRxBuf: Rx Buffer.
+  * @param  RxCount: Rx Count.
+  * @retval   TRUE/FLASE
+  * @note support Master or Slave RXDMA
+  */
+bool I2C_RXGDMA_Init(
+	u8 Index,
+	GDMA_InitTypeDef *GDMA_InitStruct,
+	void *CallbackData,
+	IRQ_FUN CallbackFunc,
+	u8 *pRxBuf,
+	int RxCount
+)
+{
+	u8 GdmaChnl;
+
+	assert_param(GDMA_InitStruct != NULL);
+
+	DCache_CleanInvalidate((u32) pRxBuf, RxCount);
+
+	GdmaChnl = GDMA_ChnlAlloc(0, (IRQ_FUN)CallbackFunc, (u32)CallbackData, 5);
+	if (GdmaChnl == 0xFF) {
+		/* No Available DMA channel */
+		return FALSE;
+	}
+
+	I2C_RXGDMA_Config(Index, GDMA_InitStruct, GdmaChnl, pRxBuf, RxCount);
 
 	GDMA_Init(GDMA_InitStruct->GDMA_Index, GDMA_InitStruct->GDMA_ChNum, GDMA_InitStruct);
 	GDMA_Cmd(GDMA_InitStruct->GDMA_Index, GDMA_InitStruct->GDMA_ChNum, ENABLE);
@@ -1217,6 +1288,396 @@ u32 I2C_MasterReadInt(I2C_TypeDef *I2Cx, I2C_IntModeCtrl *I2C_SemStruct, u8 *pBu
 	}
 	return rcvd;
 }
+
+/* Transaction queue: a transaction is a list of messages joined by RESTART and
+ * closed by STOP. Short messages are pumped through the FIFOs from the I2C
+ * interrupt, long ones are moved by GDMA in DMA register mode. GDMA completion
+ * of a write only means the data reached the TX FIFO, so the message ends on
+ * TX_EMPTY, or STOP_DET if it is the last one to this slave. A transaction
+ * completes on STOP_DET, then the next queued one is started from the ISR.
+ */
+#define I2C_QUEUE_FIFO		0
+#define I2C_QUEUE_DMA		1
+#define I2C_QUEUE_WAIT_STOP	2
+#define I2C_QUEUE_WAIT_TX	3
+
+static void I2C_Queue_Begin(I2C_QueueTypeDef *Queue);
+
+static u32 I2C_Queue_EndCmd(I2C_XferTypeDef *Xfer, u32 MsgIdx)
+{
+	/* the controller can only change target address while the bus is idle */
+	if ((MsgIdx + 1 == Xfer->MsgNum) || (Xfer->Msgs[MsgIdx + 1].Addr != Xfer->Msgs[MsgIdx].Addr)) {
+		return I2C_BIT_CMD_STOP;
+	}
+
+	return I2C_BIT_CMD_RESTART;
+}
+
+static u32 I2C_Queue_UseDma(I2C_QueueTypeDef *Queue, I2C_MsgTypeDef *Msg)
+{
+	return (Queue->DmaThreshold != 0) && (Msg->Len >= Queue->DmaThreshold) && (Msg->Len <= I2C_QUEUE_DMA_MAX);
+}
+
+static void I2C_Queue_Finish(I2C_QueueTypeDef *Queue, s32 Status)
+{
+	I2C_XferTypeDef *Xfer = Queue->Head;
+	u32 PrevIrqStatus = irq_disable_save();
+
+	Queue->Head = Xfer->Next;
+	if (Queue->Head == NULL) {
+		Queue->Tail = NULL;
+	}
+	irq_enable_restore(PrevIrqStatus);
+
+	if (Xfer->Callback != NULL) {
+		Xfer->Callback(Xfer->CbData, Status);
+	}
+
+	I2C_Queue_Begin(Queue);
+}
+
+static void I2C_Queue_StartDma(I2C_QueueTypeDef *Queue, I2C_MsgTypeDef *Msg, u32 End)
+{
+	I2C_TypeDef *I2Cx = Queue->I2Cx;
+	u32 DmaCmd = I2C_BIT_DMODE_ENABLE;
+
+	DmaCmd |= (End == I2C_BIT_CMD_STOP) ? I2C_BIT_DMODE_STOP : I2C_BIT_DMODE_RESTART;
+
+	if (Msg->Flags & I2C_MSG_RD) {
+		DCache_CleanInvalidate((u32)Msg->Buf, Msg->Len);
+		I2C_RXGDMA_Config(Queue->Index, &Queue->Gdma, Queue->GdmaChnl, Msg->Buf, Msg->Len);
+		DmaCmd |= I2C_BIT_DMODE_CMD;
+	} else {
+		DCache_Clean((u32)Msg->Buf, Msg->Len);
+		I2C_TXGDMA_Config(Queue->Index, &Queue->Gdma, Queue->GdmaChnl, Msg->Buf, Msg->Len);
+	}
+
+	GDMA_Init(0, Queue->GdmaChnl, &Queue->Gdma);
+	GDMA_Cmd(0, Queue->GdmaChnl, ENABLE);
+
+	I2C_DMAControl(I2Cx, (Msg->Flags & I2C_MSG_RD) ? I2C_BIT_RDMAE : I2C_BIT_TDMAE, ENABLE);
+	I2C_DmaMode1Config(I2Cx, DmaCmd, Msg->Len);
+
+	Queue->State = I2C_QUEUE_DMA;
+	Queue->DmaPrev = 1;
+}
+
+/**
+  * @brief  Push the current transaction as far as the FIFOs allow, then arm the
+  *		interrupt that resumes it.
+  * @param  Queue: queue with a transaction in progress.
+  * @retval None
+  */
+static void I2C_Queue_Pump(I2C_QueueTypeDef *Queue)
+{
+	I2C_TypeDef *I2Cx = Queue->I2Cx;
+	I2C_XferTypeDef *Xfer = Queue->Head;
+	I2C_MsgTypeDef *Msg;
+	u32 Wait = 0;
+	u32 End;
+	u32 Room;
+	u32 Level;
+	u32 Pending;
+
+	I2C_INTConfig(I2Cx, I2C_BIT_M_TX_EMPTY | I2C_BIT_M_RX_FULL | I2C_BIT_M_STOP_DET, DISABLE);
+
+	while ((Queue->State == I2C_QUEUE_FIFO) && (Queue->MsgIdx < Xfer->MsgNum)) {
+		Msg = &Xfer->Msgs[Queue->MsgIdx];
+		End = I2C_Queue_EndCmd(Xfer, Queue->MsgIdx);
+
+		if ((Queue->TxPos == 0) && (Queue->DmaPrev || I2C_Queue_UseDma(Queue, Msg))) {
+			/* do not mix DMA mode and CPU commands in the TX FIFO */
+			if (I2Cx->IC_TXFLR & I2C_MASK_TXFLR) {
+				I2Cx->IC_TX_TL = 0;
+				Wait = I2C_BIT_M_TX_EMPTY;
+				break;
+			}
+			Queue->DmaPrev = 0;
+
+			if (I2C_Queue_UseDma(Queue, Msg)) {
+				I2C_Queue_StartDma(Queue, Msg, End);
+				break;
+			}
+		}
+
+		if (Msg->Flags & I2C_MSG_RD) {
+			Level = I2Cx->IC_RXFLR & I2C_MASK_RXFLR;
+			if (Level > Queue->TxPos - Queue->RxPos) {
+				Level = Queue->TxPos - Queue->RxPos;
+			}
+			while (Level--) {
+				Msg->Buf[Queue->RxPos++] = (u8)I2Cx->IC_DATA_CMD;
+			}
+
+			/* read commands ahead of data, never more than the RX FIFO can hold */
+			Room = I2C_TRX_BUFFER_DEPTH - (I2Cx->IC_TXFLR & I2C_MASK_TXFLR);
+			if (Room > I2C_TRX_BUFFER_DEPTH - (Queue->TxPos - Queue->RxPos)) {
+				Room = I2C_TRX_BUFFER_DEPTH - (Queue->TxPos - Queue->RxPos);
+			}
+			if (Room > Msg->Len - Queue->TxPos) {
+				Room = Msg->Len - Queue->TxPos;
+			}
+			while (Room--) {
+				Queue->TxPos++;
+				I2Cx->IC_DATA_CMD = I2C_BIT_CMD_RW | ((Queue->TxPos == Msg->Len) ? End : 0);
+			}
+
+			if (Queue->RxPos < Msg->Len) {
+				Pending = Queue->TxPos - Queue->RxPos;
+				if (Pending == 0) {
+					/* TX FIFO is full of earlier commands, no read is queued yet */
+					I2Cx->IC_TX_TL = 0;
+					Wait = I2C_BIT_M_TX_EMPTY;
+					break;
+				}
+				/* refill at half way, or wait for the whole tail */
+				I2Cx->IC_RX_TL = ((Queue->TxPos == Msg->Len) || (Pending < 2)) ? (Pending - 1) : (Pending / 2 - 1);
+				Wait = I2C_BIT_M_RX_FULL;
+				break;
+			}
+		} else {
+			Room = I2C_TRX_BUFFER_DEPTH - (I2Cx->IC_TXFLR & I2C_MASK_TXFLR);
+			if (Room > Msg->Len - Queue->TxPos) {
+				Room = Msg->Len - Queue->TxPos;
+			}
+			while (Room--) {
+				Queue->TxPos++;
+				I2Cx->IC_DATA_CMD = Msg->Buf[Queue->TxPos - 1] | ((Queue->TxPos == Msg->Len) ? End : 0);
+			}
+
+			if (Queue->TxPos < Msg->Len) {
+				I2Cx->IC_TX_TL = I2C_TRX_BUFFER_DEPTH / 2;
+				Wait = I2C_BIT_M_TX_EMPTY;
+				break;
+			}
+		}
+
+		/* message fully handed to the controller */
+		Queue->MsgIdx++;
+		Queue->TxPos = 0;
+		Queue->RxPos = 0;
+		if (End == I2C_BIT_CMD_STOP) {
+			Queue->State = I2C_QUEUE_WAIT_STOP;
+		}
+	}
+
+	if (Queue->State == I2C_QUEUE_WAIT_STOP) {
+		Wait = I2C_BIT_M_STOP_DET;
+	} else if (Queue->State == I2C_QUEUE_WAIT_TX) {
+		I2Cx->IC_TX_TL = 0;
+		Wait = I2C_BIT_M_TX_EMPTY;
+	}
+
+	I2C_INTConfig(I2Cx, Wait | I2C_BIT_M_TX_ABRT, ENABLE);
+}
+
+static void I2C_Queue_Begin(I2C_QueueTypeDef *Queue)
+{
+	I2C_XferTypeDef *Xfer;
+	u32 PrevIrqStatus = irq_disable_save();
+
+	Xfer = Queue->Head;
+	if (Xfer == NULL) {
+		Queue->Busy = 0;
+	}
+	irq_enable_restore(PrevIrqStatus);
+
+	if (Xfer == NULL) {
+		I2C_INTConfig(Queue->I2Cx, I2C_BIT_M_TX_ABRT | I2C_BIT_M_TX_EMPTY | I2C_BIT_M_RX_FULL | I2C_BIT_M_STOP_DET, DISABLE);
+		return;
+	}
+
+	Queue->MsgIdx = 0;
+	Queue->TxPos = 0;
+	Queue->RxPos = 0;
+	Queue->DmaPrev = 0;
+	Queue->State = I2C_QUEUE_FIFO;
+
+	I2C_ClearAllINT(Queue->I2Cx);
+	I2C_SetSlaveAddress(Queue->I2Cx, Xfer->Msgs[0].Addr);
+	I2C_Queue_Pump(Queue);
+}
+
+static u32 I2C_Queue_DmaIrq(void *Data)
+{
+	I2C_QueueTypeDef *Queue = (I2C_QueueTypeDef *)Data;
+	I2C_XferTypeDef *Xfer = Queue->Head;
+
+	GDMA_ClearINT(0, Queue->GdmaChnl);
+	GDMA_Cmd(0, Queue->GdmaChnl, DISABLE);
+	I2C_DMAControl(Queue->I2Cx, I2C_BIT_RDMAE, DISABLE);
+
+	if ((Xfer == NULL) || (Queue->State != I2C_QUEUE_DMA)) {
+		return 0;
+	}
+
+	if (I2C_Queue_EndCmd(Xfer, Queue->MsgIdx) == I2C_BIT_CMD_STOP) {
+		Queue->State = I2C_QUEUE_WAIT_STOP;
+		Queue->MsgIdx++;
+	} else if ((Xfer->Msgs[Queue->MsgIdx].Flags & I2C_MSG_RD) == 0) {
+		/* the written bytes are still in the TX FIFO */
+		Queue->State = I2C_QUEUE_WAIT_TX;
+	} else {
+		Queue->State = I2C_QUEUE_FIFO;
+		Queue->MsgIdx++;
+	}
+	I2C_Queue_Pump(Queue);
+
+	return 0;
+}
+
+static u32 I2C_Queue_Irq(void *Data)
+{
+	I2C_QueueTypeDef *Queue = (I2C_QueueTypeDef *)Data;
+	I2C_TypeDef *I2Cx = Queue->I2Cx;
+	I2C_XferTypeDef *Xfer = Queue->Head;
+
+	if (Xfer == NULL) {
+		I2C_ClearAllINT(I2Cx);
+		return 0;
+	}
+
+	if (I2C_GetRawINT(I2Cx) & I2C_BIT_TX_ABRT) {
+		RTK_LOGD(TAG, "queue TX_ABRT: 0x%x\n", I2Cx->IC_TX_ABRT_SOURCE);
+		if (Queue->DmaPrev) {
+			GDMA_Cmd(0, Queue->GdmaChnl, DISABLE);
+			GDMA_ClearINT(0, Queue->GdmaChnl);
+			I2C_DMAControl(I2Cx, I2C_BIT_TDMAE | I2C_BIT_RDMAE, DISABLE);
+			I2Cx->IC_DMA_CMD = 0;
+		}
+		I2C_ClearAllINT(I2Cx);
+		I2C_Queue_Finish(Queue, RTK_FAIL);
+		return 0;
+	}
+
+	if (Queue->State == I2C_QUEUE_WAIT_TX) {
+		if (I2Cx->IC_TXFLR & I2C_MASK_TXFLR) {
+			return 0;
+		}
+		I2C_DMAControl(I2Cx, I2C_BIT_TDMAE, DISABLE);
+		Queue->State = I2C_QUEUE_FIFO;
+		Queue->MsgIdx++;
+	}
+
+	if (Queue->State == I2C_QUEUE_WAIT_STOP) {
+		if ((I2C_GetINT(I2Cx) & I2C_BIT_R_STOP_DET) == 0) {
+			return 0;
+		}
+		I2C_ClearINT(I2Cx, I2C_BIT_R_STOP_DET);
+		I2C_DMAControl(I2Cx, I2C_BIT_TDMAE | I2C_BIT_RDMAE, DISABLE);
+
+		if (Queue->MsgIdx == Xfer->MsgNum) {
+			I2C_Queue_Finish(Queue, RTK_SUCCESS);
+			return 0;
+		}
+
+		/* next message goes to another slave */
+		I2C_SetSlaveAddress(I2Cx, Xfer->Msgs[Queue->MsgIdx].Addr);
+		Queue->State = I2C_QUEUE_FIFO;
+	}
+
+	I2C_Queue_Pump(Queue);
+
+	return 0;
+}
+
+/**
+  * @brief  Init an I2C master transaction queue.
+  * @param  Queue: queue to init.
+  * @param  Index: I2C index, I2C must be already initialized as master by I2C_Init.
+  * @param  DmaThreshold: messages of at least this many bytes use GDMA, 0 never uses GDMA.
+  * @param  IrqPriority: I2C interrupt priority, the queue owns the I2C interrupt.
+  * @retval   TRUE/FLASE
+  */
+bool I2C_QueueInit(I2C_QueueTypeDef *Queue, u32 Index, u32 DmaThreshold, u32 IrqPriority)
+{
+	assert_param(Queue != NULL);
+	assert_param(DmaThreshold <= I2C_QUEUE_DMA_MAX);
+
+	_memset(Queue, 0, sizeof(I2C_QueueTypeDef));
+	Queue->Index = Index;
+	Queue->I2Cx = I2C_DEV_TABLE[Index].I2Cx;
+	Queue->DmaThreshold = DmaThreshold;
+	Queue->GdmaChnl = 0xFF;
+
+	if (DmaThreshold != 0) {
+		Queue->GdmaChnl = GDMA_ChnlAlloc(0, (IRQ_FUN)I2C_Queue_DmaIrq, (u32)Queue, 5);
+		if (Queue->GdmaChnl == 0xFF) {
+			return FALSE;
+		}
+	}
+
+	I2C_INTConfig(Queue->I2Cx, 0xFFFFFFFF, DISABLE);
+	I2C_ClearAllINT(Queue->I2Cx);
+	InterruptRegister((IRQ_FUN)I2C_Queue_Irq, I2C_DEV_TABLE[Index].IrqNum, (u32)Queue, IrqPriority);
+	InterruptEn(I2C_DEV_TABLE[Index].IrqNum, IrqPriority);
+
+	return TRUE;
+}
+
+/**
+  * @brief  Release the interrupt and GDMA channel of an idle I2C transaction queue.
+  * @param  Queue: queue to deinit.
+  * @retval None
+  */
+void I2C_QueueDeInit(I2C_QueueTypeDef *Queue)
+{
+	assert_param(Queue->Busy == 0);
+
+	InterruptDis(I2C_DEV_TABLE[Queue->Index].IrqNum);
+	InterruptUnRegister(I2C_DEV_TABLE[Queue->Index].IrqNum);
+
+	if (Queue->GdmaChnl != 0xFF) {
+		GDMA_ChnlFree(0, Queue->GdmaChnl);
+	}
+}
+
+/**
+  * @brief  Append a transaction to the queue, start it if the queue is idle.
+  * @param  Queue: queue initialized by I2C_QueueInit.
+  * @param  Xfer: transaction, must stay valid until its callback is called.
+  * @retval RTK_SUCCESS
+  * @note  Consecutive messages to the same address are joined by RESTART. When the
+  *		address changes, the previous message ends with STOP instead, since the
+  *		target address can only be changed while the bus is idle.
+  */
+u32 I2C_QueueSubmit(I2C_QueueTypeDef *Queue, I2C_XferTypeDef *Xfer)
+{
+	u32 PrevIrqStatus;
+	u32 Start;
+
+	assert_param(Xfer->MsgNum > 0);
+
+	Xfer->Next = NULL;
+
+	PrevIrqStatus = irq_disable_save();
+	if (Queue->Tail != NULL) {
+		Queue->Tail->Next = Xfer;
+	} else {
+		Queue->Head = Xfer;
+	}
+	Queue->Tail = Xfer;
+
+	Start = (Queue->Busy == 0) ? 1 : 0;
+	Queue->Busy = 1;
+	irq_enable_restore(PrevIrqStatus);
+
+	if (Start) {
+		I2C_Queue_Begin(Queue);
+	}
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Check whether an I2C transaction queue still has work in flight.
+  * @param  Queue: queue initialized by I2C_QueueInit.
+  * @retval 1: busy, 0: idle
+  */
+u32 I2C_QueueBusy(I2C_QueueTypeDef *Queue)
+{
+	return Queue->Busy;
+}
 /**
   * @}
   */
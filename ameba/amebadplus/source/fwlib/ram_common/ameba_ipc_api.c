@@ -89,15 +89,34 @@ void IPC_TXHandler(void *Data, u32 IrqStatus, u32 ChanNum)
 }
 
 
+/* per tx channel wait time histogram and moving average of peer response time, in us */
+static u32 ipc_wait_hist[IPC_TX_CHANNEL_NUM][IPC_WAIT_HIST_NUM];
+static u32 ipc_wait_avg[IPC_TX_CHANNEL_NUM];
+
+static void IPC_wait_record(u32 IPC_ChNum, u32 start)
+{
+	u32 wait = DTimestamp_Get() - start;
+
+	ipc_wait_hist[IPC_ChNum][IPC_HistBucket(wait, IPC_WAIT_HIST_NUM)]++;
+
+	/* avg += (wait - avg) / 8 */
+	ipc_wait_avg[IPC_ChNum] = ipc_wait_avg[IPC_ChNum] - (ipc_wait_avg[IPC_ChNum] >> 3) + (wait >> 3);
+}
+
 /**
   * @brief  Processing functions when the IPC channel is occupied
   * @param  IPCx: where IPCx can be IPCKM0_DEV for KM0, IPCKM4_DEV for CM4.
   * @param  IPC_ChNum: IPC_ChNum
+  * @note   In task context with a tx handler, it first spins for twice the average peer
+  *		response time of this channel (bounded by IPC_WAIT_SPIN_MIN_US/IPC_WAIT_SPIN_MAX_US),
+  *		and only blocks on the semaphore if the peer is slower than that.
   * @retval IPC_REQ_TIMEOUT or IPC_SEMA_TIMEOUT or SUCCESS
   */
 u32 IPC_wait_idle(IPC_TypeDef *IPCx, u32 IPC_ChNum)
 {
 	u32 timeout;
+	u32 start = DTimestamp_Get();
+	u32 spin_us;
 
 	timeout = 10000000;
 
@@ -110,21 +129,56 @@ u32 IPC_wait_idle(IPC_TypeDef *IPCx, u32 IPC_ChNum)
 			}
 		}
 	} else {
-		if (ipc_Semaphore[IPC_ChNum] == NULL) {
-			rtos_sema_create_binary(&ipc_Semaphore[IPC_ChNum]);
+		spin_us = ipc_wait_avg[IPC_ChNum] << 1;
+		if (spin_us < IPC_WAIT_SPIN_MIN_US) {
+			spin_us = IPC_WAIT_SPIN_MIN_US;
+		} else if (spin_us > IPC_WAIT_SPIN_MAX_US) {
+			spin_us = IPC_WAIT_SPIN_MAX_US;
+		}
+
+		while (IPCx->IPC_DATA & (BIT(IPC_ChNum + IPC_TX_CHANNEL_SHIFT))) {
+			if (DTimestamp_Get() - start > spin_us) {
+				break;
+			}
 		}
 
-		IPC_INTConfig(IPCx, IPC_ChNum + IPC_TX_CHANNEL_SHIFT, ENABLE);
+		if (IPCx->IPC_DATA & (BIT(IPC_ChNum + IPC_TX_CHANNEL_SHIFT))) {
+			if (ipc_Semaphore[IPC_ChNum] == NULL) {
+				rtos_sema_create_binary(&ipc_Semaphore[IPC_ChNum]);
+			}
 
-		if (rtos_sema_take(ipc_Semaphore[IPC_ChNum], IPC_SEMA_MAX_DELAY) != RTK_SUCCESS) {
-			RTK_LOGS(TAG, RTK_LOG_ERROR, " IPC Get Semaphore Timeout\r\n");
-			IPC_INTConfig(IPCx, IPC_ChNum + IPC_TX_CHANNEL_SHIFT, DISABLE);
-			return IPC_SEMA_TIMEOUT;
+			IPC_INTConfig(IPCx, IPC_ChNum + IPC_TX_CHANNEL_SHIFT, ENABLE);
+
+			if (rtos_sema_take(ipc_Semaphore[IPC_ChNum], IPC_SEMA_MAX_DELAY) != RTK_SUCCESS) {
+				RTK_LOGS(TAG, RTK_LOG_ERROR, " IPC Get Semaphore Timeout\r\n");
+				IPC_INTConfig(IPCx, IPC_ChNum + IPC_TX_CHANNEL_SHIFT, DISABLE);
+				return IPC_SEMA_TIMEOUT;
+			}
 		}
 	}
+
+	IPC_wait_record(IPC_ChNum, start);
 	return 0;
 }
 
+/**
+  * @brief  Get wait time statistics of a IPC tx channel.
+  * @param  IPC_ChNum: the IPC channel number.
+  * @param  Hist: array of IPC_WAIT_HIST_NUM words, can be NULL. Hist[0] counts waits shorter
+  *		than 8us, Hist[i] counts [8us << (i - 1), 8us << i), the last bucket counts all longer ones.
+  * @retval moving average of peer response time in us.
+  */
+u32 IPC_wait_idle_GetStat(u8 IPC_ChNum, u32 *Hist)
+{
+	assert_param(IS_IPC_VALID_CHNUM(IPC_ChNum));
+
+	if (Hist) {
+		_memcpy(Hist, ipc_wait_hist[IPC_ChNum], sizeof(ipc_wait_hist[IPC_ChNum]));
+	}
+
+	return ipc_wait_avg[IPC_ChNum];
+}
+
 /**
   * @brief  exchange messages between KM0 and KM4.
   * @param  IPC_Dir: Specifies core to core direction
@@ -181,4 +235,505 @@ PIPC_MSG_STRUCT ipc_get_message(u32 IPC_Dir, u8 IPC_ChNum)
 	DCache_Invalidate((u32)&IPC_MSG[msg_idx], sizeof(IPC_MSG_STRUCT));
 
 	return &IPC_MSG[msg_idx];
-}
\ No newline at end of file
+}
+
+/**
+  * @brief  init a multi-slot message ring for one IPC channel, called by the sender.
+  * @param  IPC_Ring: shared memory of IPC_RING_SIZE(Depth) bytes, cache line aligned.
+  * @param  Depth: number of message slots, must be power of 2.
+  * @retval   None
+  */
+void ipc_ring_init(PIPC_RING_STRUCT IPC_Ring, u32 Depth)
+{
+	assert_param(IS_CACHE_LINE_ALIGNED_ADDR((u32)IPC_Ring));
+	assert_param((Depth != 0) && ((Depth & (Depth - 1)) == 0));
+
+	IPC_Ring->head = 0;
+	IPC_Ring->depth = Depth;
+	IPC_Ring->tail = 0;
+	DCache_Clean((u32)IPC_Ring, sizeof(IPC_RING_STRUCT));
+}
+
+/**
+  * @brief  queue a message to the channel ring, ring the doorbell only when the ring was empty.
+  * @param  IPC_Dir: Specifies core to core direction
+  *          This parameter can be one of the following values:
+  *		 		@arg IPC_KM0_TO_KM4: KM0 send request to KM4
+  *		 		@arg IPC_KM4_TO_KM0: KM4 send request to KM0
+  * @param  IPC_ChNum: the IPC channel number.
+  * @param  IPC_Ring: ring inited by ipc_ring_init.
+  * @param  IPC_Msg: message to be copied into the ring.
+  * @note   The doorbell message carries the ring address, the receiver gets it by ipc_ring_get.
+  *		All senders of a ring must be on the same core, the slot is claimed with interrupts
+  *		off so tasks and interrupt handlers can share it.
+  * @retval IPC_SEND_SUCCESS, IPC_RING_FULL or IPC_SEND_TIMEOUT
+  */
+u32 ipc_ring_send(u32 IPC_Dir, u8 IPC_ChNum, PIPC_RING_STRUCT IPC_Ring, PIPC_MSG_STRUCT IPC_Msg)
+{
+	IPC_MSG_STRUCT ipc_msg_temp;
+	u32 PrevIrqStatus;
+	u32 head;
+	u32 tail;
+	u32 slot;
+
+	PrevIrqStatus = irq_disable_save();
+
+	head = IPC_Ring->head;
+	DCache_Invalidate((u32)&IPC_Ring->tail, sizeof(u32));
+	if (head - IPC_Ring->tail >= IPC_Ring->depth) {
+		irq_enable_restore(PrevIrqStatus);
+		return IPC_RING_FULL;
+	}
+
+	slot = head & (IPC_Ring->depth - 1);
+	_memcpy(&IPC_Ring->msg[slot], IPC_Msg, sizeof(IPC_MSG_STRUCT));
+	DCache_Clean((u32)&IPC_Ring->msg[slot], sizeof(IPC_MSG_STRUCT));
+
+	IPC_Ring->head = head + 1;
+	DCache_Clean((u32)&IPC_Ring->head, sizeof(u32));
+	__DMB();
+
+	/* tail is read after head is published, so receiver either sees the new head before it
+	stops, or it had already drained up to head and needs the doorbell */
+	DCache_Invalidate((u32)&IPC_Ring->tail, sizeof(u32));
+	tail = IPC_Ring->tail;
+	irq_enable_restore(PrevIrqStatus);
+	if (tail != head) {
+		return IPC_SEND_SUCCESS;
+	}
+
+	/* rung outside the lock, ipc_send_message may block until the peer is idle */
+	ipc_msg_temp.msg_type = IPC_USER_POINT;
+	ipc_msg_temp.msg = (u32)IPC_Ring;
+	ipc_msg_temp.msg_len = IPC_RING_SIZE(IPC_Ring->depth);
+	ipc_msg_temp.rsvd = 0;
+
+	return ipc_send_message(IPC_Dir, IPC_ChNum, &ipc_msg_temp);
+}
+
+/**
+  * @brief  get the message ring of a channel in its rx interrupt handler.
+  * @param  IPC_Dir: Specifies core to core direction
+  * @param  IPC_ChNum: the IPC channel number.
+  * @retval  ring sent by ipc_ring_send.
+  */
+PIPC_RING_STRUCT ipc_ring_get(u32 IPC_Dir, u8 IPC_ChNum)
+{
+	PIPC_MSG_STRUCT ipc_msg = ipc_get_message(IPC_Dir, IPC_ChNum);
+
+	return (PIPC_RING_STRUCT)ipc_msg->msg;
+}
+
+/**
+  * @brief  take one message from the ring.
+  * @param  IPC_Ring: ring got by ipc_ring_get.
+  * @param  IPC_Msg: buffer to save the message.
+  * @note   Call it in a loop in the rx handler until it returns 0, so no message is left
+  *		behind after the last doorbell.
+  * @retval  1: got one message, 0: ring is empty.
+  */
+u32 ipc_ring_recv(PIPC_RING_STRUCT IPC_Ring, PIPC_MSG_STRUCT IPC_Msg)
+{
+	u32 tail = IPC_Ring->tail;
+	u32 slot;
+
+	DCache_Invalidate((u32)&IPC_Ring->head, CACHE_LINE_SIZE);
+	if (IPC_Ring->head == tail) {
+		return 0;
+	}
+
+	slot = tail & (IPC_Ring->depth - 1);
+	DCache_Invalidate((u32)&IPC_Ring->msg[slot], sizeof(IPC_MSG_STRUCT));
+	_memcpy(IPC_Msg, &IPC_Ring->msg[slot], sizeof(IPC_MSG_STRUCT));
+
+	IPC_Ring->tail = tail + 1;
+	DCache_Clean((u32)&IPC_Ring->tail, sizeof(u32));
+	__DMB();
+
+	return 1;
+}
+
+/* irq is masked while the lock is held, so the rx handler of this core can not run into a
+task holding it (which would spin forever) or drop its dirty owner[] line, and the pool
+functions are safe in interrupt context */
+static u32 ipc_pool_lock(PIPC_POOL_STRUCT IPC_Pool)
+{
+	u32 PrevIrqStatus = irq_disable_save();
+
+	while (IPC_SEMTake(IPC_SEM_POOL, 1000) != TRUE) {
+		RTK_LOGS(TAG, RTK_LOG_ERROR, "ipc pool get hw sema fail\r\n");
+	}
+
+	/* both cores write owner[], always work on the latest line */
+	DCache_Invalidate((u32)IPC_Pool, sizeof(IPC_POOL_STRUCT));
+
+	return PrevIrqStatus;
+}
+
+static void ipc_pool_unlock(PIPC_POOL_STRUCT IPC_Pool, u32 PrevIrqStatus)
+{
+	DCache_Clean((u32)IPC_Pool, sizeof(IPC_POOL_STRUCT));
+	IPC_SEMFree(IPC_SEM_POOL);
+	irq_enable_restore(PrevIrqStatus);
+}
+
+/* return buffer index, or BufNum if Buf is not a buffer of the pool */
+static u32 ipc_pool_index(PIPC_POOL_STRUCT IPC_Pool, void *Buf)
+{
+	u32 offset = (u32)Buf - ((u32)IPC_Pool + sizeof(IPC_POOL_STRUCT));
+
+	if (((u32)Buf < (u32)IPC_Pool + sizeof(IPC_POOL_STRUCT)) || (offset % IPC_Pool->buf_size)) {
+		return IPC_Pool->buf_num;
+	}
+
+	offset /= IPC_Pool->buf_size;
+	return (offset < IPC_Pool->buf_num) ? offset : IPC_Pool->buf_num;
+}
+
+static void *ipc_pool_buf(PIPC_POOL_STRUCT IPC_Pool, u32 Idx)
+{
+	return (void *)((u32)IPC_Pool + sizeof(IPC_POOL_STRUCT) + Idx * IPC_Pool->buf_size);
+}
+
+static void ipc_pool_violation(PIPC_POOL_STRUCT IPC_Pool, void *Buf)
+{
+	IPC_Pool->violation++;
+	RTK_LOGS(TAG, RTK_LOG_ERROR, "CPU %lu does not own ipc pool buffer %p\r\n", SYS_CPUID(), Buf);
+}
+
+/**
+  * @brief  init a shared memory pool of fixed size buffers for zero-copy transfer between cores.
+  * @param  IPC_Pool: shared memory of IPC_POOL_SIZE(BufSize, BufNum) bytes, cache line aligned.
+  * @param  BufSize: size of each buffer, multiple of CACHE_LINE_SIZE.
+  * @param  BufNum: number of buffers, no more than IPC_POOL_MAX_BUF.
+  * @note   Called once by one core before the pool is used by either side.
+  * @retval   None
+  */
+void ipc_pool_init(PIPC_POOL_STRUCT IPC_Pool, u32 BufSize, u32 BufNum)
+{
+	assert_param(IS_CACHE_LINE_ALIGNED_ADDR((u32)IPC_Pool));
+	assert_param((BufSize != 0) && IS_CACHE_LINE_ALIGNED_ADDR(BufSize));
+	assert_param((BufNum != 0) && (BufNum <= IPC_POOL_MAX_BUF));
+
+	_memset(IPC_Pool, 0, sizeof(IPC_POOL_STRUCT));
+	IPC_Pool->buf_size = BufSize;
+	IPC_Pool->buf_num = BufNum;
+	DCache_Clean((u32)IPC_Pool, sizeof(IPC_POOL_STRUCT));
+}
+
+/**
+  * @brief  get a free buffer from the pool, the calling core becomes its owner.
+  * @param  IPC_Pool: pool inited by ipc_pool_init.
+  * @retval  buffer address, or NULL if the pool is empty.
+  */
+void *ipc_pool_alloc(PIPC_POOL_STRUCT IPC_Pool)
+{
+	u32 PrevIrqStatus;
+	void *Buf = NULL;
+	u32 i;
+
+	PrevIrqStatus = ipc_pool_lock(IPC_Pool);
+	for (i = 0; i < IPC_Pool->buf_num; i++) {
+		if (IPC_Pool->owner[i] == IPC_POOL_FREE) {
+			IPC_Pool->owner[i] = IPC_POOL_OWNER(SYS_CPUID());
+			Buf = ipc_pool_buf(IPC_Pool, i);
+			break;
+		}
+	}
+	ipc_pool_unlock(IPC_Pool, PrevIrqStatus);
+
+	return Buf;
+}
+
+/**
+  * @brief  hand a buffer over to the other core without copying it.
+  * @param  IPC_Dir: Specifies core to core direction
+  *          This parameter can be one of the following values:
+  *		 		@arg IPC_KM0_TO_KM4: KM0 send request to KM4
+  *		 		@arg IPC_KM4_TO_KM0: KM4 send request to KM0
+  * @param  IPC_ChNum: the IPC channel number.
+  * @param  IPC_Pool: pool the buffer belongs to.
+  * @param  Buf: buffer owned by the calling core.
+  * @param  Len: valid data length in the buffer.
+  * @note   The whole buffer is cleaned and invalidated from D-Cache and ownership moves to the
+  *		peer before the message is sent, the caller must not touch Buf afterwards.
+  * @retval IPC_SEND_SUCCESS, IPC_SEND_TIMEOUT or IPC_POOL_NOT_OWNER
+  */
+u32 ipc_pool_send(u32 IPC_Dir, u8 IPC_ChNum, PIPC_POOL_STRUCT IPC_Pool, void *Buf, u32 Len)
+{
+	IPC_MSG_STRUCT ipc_msg_temp;
+	u32 peer = (IPC_Dir == IPC_KM4_TO_KM0) ? 0 : 1;
+	u32 PrevIrqStatus;
+	u32 idx;
+
+	PrevIrqStatus = ipc_pool_lock(IPC_Pool);
+	idx = ipc_pool_index(IPC_Pool, Buf);
+	if ((idx == IPC_Pool->buf_num) || (IPC_Pool->owner[idx] != IPC_POOL_OWNER(SYS_CPUID())) || (Len > IPC_Pool->buf_size)) {
+		ipc_pool_violation(IPC_Pool, Buf);
+		ipc_pool_unlock(IPC_Pool, PrevIrqStatus);
+		return IPC_POOL_NOT_OWNER;
+	}
+
+	/* no line of the buffer may stay in this cache, a later eviction would overwrite the peer's data */
+	DCache_CleanInvalidate((u32)Buf, IPC_Pool->buf_size);
+	IPC_Pool->owner[idx] = IPC_POOL_OWNER(peer);
+	ipc_pool_unlock(IPC_Pool, PrevIrqStatus);
+
+	ipc_msg_temp.msg_type = IPC_USER_POINT;
+	ipc_msg_temp.msg = (u32)IPC_Pool;
+	ipc_msg_temp.msg_len = Len;
+	ipc_msg_temp.rsvd = idx;
+
+	return ipc_send_message(IPC_Dir, IPC_ChNum, &ipc_msg_temp);
+}
+
+/**
+  * @brief  get the buffer handed over by ipc_pool_send in the rx interrupt handler.
+  * @param  IPC_Dir: Specifies core to core direction
+  * @param  IPC_ChNum: the IPC channel number.
+  * @param  IPC_Pool: return the pool the buffer belongs to, needed by ipc_pool_free.
+  * @param  Len: return valid data length.
+  * @note   The whole buffer is invalidated from D-Cache, return it by ipc_pool_free or pass it on
+  *		by ipc_pool_send.
+  * @retval  buffer address, or NULL if the message breaks the ownership protocol.
+  */
+void *ipc_pool_recv(u32 IPC_Dir, u8 IPC_ChNum, PIPC_POOL_STRUCT *IPC_Pool, u32 *Len)
+{
+	PIPC_MSG_STRUCT ipc_msg = ipc_get_message(IPC_Dir, IPC_ChNum);
+	PIPC_POOL_STRUCT pool = (PIPC_POOL_STRUCT)ipc_msg->msg;
+	u32 idx = ipc_msg->rsvd;
+	u32 PrevIrqStatus;
+	void *Buf;
+
+	/* owner[idx] can only be changed by this core now, but a task of this core may be in the
+	middle of updating another entry, so the header line is only touched under the lock */
+	PrevIrqStatus = ipc_pool_lock(pool);
+	if ((idx >= pool->buf_num) || (pool->owner[idx] != IPC_POOL_OWNER(SYS_CPUID()))) {
+		ipc_pool_unlock(pool, PrevIrqStatus);
+		RTK_LOGS(TAG, RTK_LOG_ERROR, "CPU %lu got ipc pool buffer %lu it does not own\r\n", SYS_CPUID(), idx);
+		return NULL;
+	}
+	ipc_pool_unlock(pool, PrevIrqStatus);
+
+	Buf = ipc_pool_buf(pool, idx);
+	DCache_Invalidate((u32)Buf, pool->buf_size);
+
+	*IPC_Pool = pool;
+	*Len = ipc_msg->msg_len;
+
+	return Buf;
+}
+
+/**
+  * @brief  return a buffer to the pool.
+  * @param  IPC_Pool: pool the buffer belongs to.
+  * @param  Buf: buffer owned by the calling core.
+  * @retval RTK_SUCCESS or IPC_POOL_NOT_OWNER
+  */
+u32 ipc_pool_free(PIPC_POOL_STRUCT IPC_Pool, void *Buf)
+{
+	u32 PrevIrqStatus;
+	u32 idx;
+
+	PrevIrqStatus = ipc_pool_lock(IPC_Pool);
+	idx = ipc_pool_index(IPC_Pool, Buf);
+	if ((idx == IPC_Pool->buf_num) || (IPC_Pool->owner[idx] != IPC_POOL_OWNER(SYS_CPUID()))) {
+		ipc_pool_violation(IPC_Pool, Buf);
+		ipc_pool_unlock(IPC_Pool, PrevIrqStatus);
+		return IPC_POOL_NOT_OWNER;
+	}
+
+	/* the next owner may be the peer, leave no line of the buffer behind */
+	DCache_CleanInvalidate((u32)Buf, IPC_Pool->buf_size);
+	IPC_Pool->owner[idx] = IPC_POOL_FREE;
+	ipc_pool_unlock(IPC_Pool, PrevIrqStatus);
+
+	return RTK_SUCCESS;
+}
+
+static const IPC_RPC_ENTRY *ipc_rpc_table;
+static u32 ipc_rpc_table_num;
+
+/**
+  * @brief  register the functions this core serves to the other core.
+  * @param  Table: function ID table, must stay valid.
+  * @param  Num: number of entries.
+  * @retval   None
+  */
+void ipc_rpc_register(const IPC_RPC_ENTRY *Table, u32 Num)
+{
+	ipc_rpc_table = Table;
+	ipc_rpc_table_num = Num;
+}
+
+/**
+  * @brief  init a RPC channel on the calling side.
+  * @param  IPC_Rpc: RPC channel.
+  * @param  IPC_Dir: direction of requests, IPC_KM0_TO_KM4 or IPC_KM4_TO_KM0.
+  * @param  IPC_ChNum: the IPC channel number, the peer calls ipc_rpc_serve in its rx handler.
+  * @param  IPC_Ring: shared memory of IPC_RING_SIZE(Depth) bytes for queued requests.
+  * @param  Depth: max number of requests in flight, must be power of 2.
+  * @retval   None
+  */
+void ipc_rpc_init(PIPC_RPC_STRUCT IPC_Rpc, u32 IPC_Dir, u8 IPC_ChNum, PIPC_RING_STRUCT IPC_Ring, u32 Depth)
+{
+	_memset(IPC_Rpc, 0, sizeof(IPC_RPC_STRUCT));
+	IPC_Rpc->IPC_Dir = IPC_Dir;
+	IPC_Rpc->IPC_ChNum = IPC_ChNum;
+	IPC_Rpc->IPC_Ring = IPC_Ring;
+
+	ipc_ring_init(IPC_Ring, Depth);
+}
+
+/**
+  * @brief  submit calls without waiting for them.
+  * @param  IPC_Rpc: RPC channel.
+  * @param  Calls: array of call frames, cache line aligned, func_id/argc/args filled.
+  * @param  Num: number of calls.
+  * @note   Calls queued while the peer is still busy share one doorbell, so a batch costs
+  *		one peer interrupt. Completion is checked by ipc_rpc_poll.
+  * @retval  number of calls submitted, less than Num if the ring is full.
+  */
+u32 ipc_rpc_submit(PIPC_RPC_STRUCT IPC_Rpc, PIPC_RPC_CALL Calls, u32 Num)
+{
+	IPC_MSG_STRUCT ipc_msg_temp;
+	u32 ret;
+	u32 i;
+
+	/* each frame is cleaned and invalidated as one whole cache line */
+	assert_param(IS_CACHE_LINE_ALIGNED_ADDR((u32)Calls));
+
+	for (i = 0; i < Num; i++) {
+		assert_param(Calls[i].argc <= IPC_RPC_MAX_ARGS);
+
+		Calls[i].state = IPC_RPC_PENDING;
+		Calls[i].issue_time = DTimestamp_Get();
+		DCache_Clean((u32)&Calls[i], sizeof(IPC_RPC_CALL));
+
+		ipc_msg_temp.msg_type = IPC_USER_POINT;
+		ipc_msg_temp.msg = (u32)&Calls[i];
+		ipc_msg_temp.msg_len = sizeof(IPC_RPC_CALL);
+		ipc_msg_temp.rsvd = 0;
+
+		ret = ipc_ring_send(IPC_Rpc->IPC_Dir, IPC_Rpc->IPC_ChNum, IPC_Rpc->IPC_Ring, &ipc_msg_temp);
+		if (ret == IPC_RING_FULL) {
+			Calls[i].state = IPC_RPC_IDLE;
+			IPC_Rpc->stat.ring_full++;
+			break;
+		}
+
+		/* the call is in the ring already, the peer still owes an interrupt for the doorbell
+		that timed out and drains the whole ring then, so the call stays submitted */
+		if (ret != IPC_SEND_SUCCESS) {
+			IPC_Rpc->stat.doorbell_timeout++;
+		}
+	}
+
+	return i;
+}
+
+/**
+  * @brief  check whether a submitted call is finished.
+  * @param  IPC_Rpc: RPC channel.
+  * @param  Call: call frame submitted by ipc_rpc_submit.
+  * @retval  IPC_RPC_PENDING, IPC_RPC_DONE (ret is valid) or IPC_RPC_NO_FUNC.
+  */
+u32 ipc_rpc_poll(PIPC_RPC_STRUCT IPC_Rpc, PIPC_RPC_CALL Call)
+{
+	u32 latency;
+
+	DCache_Invalidate((u32)Call, sizeof(IPC_RPC_CALL));
+	if (Call->state == IPC_RPC_PENDING) {
+		return IPC_RPC_PENDING;
+	}
+
+	/* issue_time is cleared once the call is accounted, so polling again does not count twice */
+	if ((Call->state != IPC_RPC_IDLE) && (Call->issue_time != 0)) {
+		latency = DTimestamp_Get() - Call->issue_time;
+		IPC_Rpc->stat.calls++;
+		IPC_Rpc->stat.latency_total += latency;
+		if (latency > IPC_Rpc->stat.latency_max) {
+			IPC_Rpc->stat.latency_max = latency;
+		}
+
+		Call->issue_time = 0;
+		DCache_Clean((u32)Call, sizeof(IPC_RPC_CALL));
+	}
+
+	return Call->state;
+}
+
+/**
+  * @brief  call a function on the other core and wait for the result.
+  * @param  IPC_Rpc: RPC channel.
+  * @param  Call: call frame, cache line aligned, func_id/argc/args filled.
+  * @param  Ret: return value of the remote function.
+  * @param  Timeout: max time to wait in us, for the ring to have room and for the result.
+  * @note   If IPC_RPC_PENDING is returned the peer still owns Call, it must not be reused or
+  *		freed until ipc_rpc_poll returns another state.
+  * @retval  IPC_RPC_DONE, IPC_RPC_NO_FUNC, IPC_RPC_IDLE if the ring stayed full (not submitted)
+  *		or IPC_RPC_PENDING if the peer did not finish in time.
+  */
+u32 ipc_rpc_call(PIPC_RPC_STRUCT IPC_Rpc, PIPC_RPC_CALL Call, u32 *Ret, u32 Timeout)
+{
+	u32 start = DTimestamp_Get();
+	u32 state;
+
+	while (ipc_rpc_submit(IPC_Rpc, Call, 1) == 0) {
+		if (DTimestamp_Get() - start > Timeout) {
+			return IPC_RPC_IDLE;
+		}
+	}
+
+	do {
+		state = ipc_rpc_poll(IPC_Rpc, Call);
+		if (DTimestamp_Get() - start > Timeout) {
+			break;
+		}
+	} while (state == IPC_RPC_PENDING);
+
+	if (state == IPC_RPC_PENDING) {
+		RTK_LOGS(TAG, RTK_LOG_ERROR, " IPC RPC %d Timeout\r\n", Call->func_id);
+		return IPC_RPC_PENDING;
+	}
+
+	*Ret = Call->ret;
+	return state;
+}
+
+/**
+  * @brief  run all queued calls, used in the rx interrupt handler of the RPC channel.
+  * @param  IPC_Dir: direction of requests.
+  * @param  IPC_ChNum: the IPC channel number.
+  * @retval   None
+  */
+void ipc_rpc_serve(u32 IPC_Dir, u8 IPC_ChNum)
+{
+	PIPC_RING_STRUCT ring = ipc_ring_get(IPC_Dir, IPC_ChNum);
+	IPC_MSG_STRUCT ipc_msg_temp;
+	PIPC_RPC_CALL call;
+	u32 state;
+	u32 ret;
+	u32 i;
+
+	while (ipc_ring_recv(ring, &ipc_msg_temp)) {
+		call = (PIPC_RPC_CALL)ipc_msg_temp.msg;
+		DCache_Invalidate((u32)call, sizeof(IPC_RPC_CALL));
+
+		/* the caller may poll the frame at any time, so state becomes final only after func
+		returned, written once with ret just before the clean */
+		state = IPC_RPC_NO_FUNC;
+		ret = 0;
+		for (i = 0; i < ipc_rpc_table_num; i++) {
+			if (ipc_rpc_table[i].func_id == call->func_id) {
+				ret = ipc_rpc_table[i].func(call->args, call->argc);
+				state = IPC_RPC_DONE;
+				break;
+			}
+		}
+
+		call->ret = ret;
+		call->state = state;
+		DCache_Clean((u32)call, sizeof(IPC_RPC_CALL));
+	}
+}
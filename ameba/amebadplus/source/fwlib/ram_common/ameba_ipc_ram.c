@@ -11,6 +11,37 @@ IPC_IRQ_FUN IPC_IrqHandler[IPC_CHANNEL_NUM];
 
 void *IPC_IrqData[IPC_CHANNEL_NUM];
 
+/* per channel interrupt count and max handler time, in CPU cycles on KM4 and
+ * in us (debug timer) on KM0, whose ARMv8-M baseline core has no cycle counter.
+ * IPC_INTGetStat reports us on both. */
+static u32 IPC_IrqCnt[IPC_CHANNEL_NUM];
+static u32 IPC_IrqMaxTime[IPC_CHANNEL_NUM];
+static u32 IPC_StatEn;
+
+#if defined (CONFIG_ARM_CORE_CM0)
+#define IPC_STAT_TIME()		DTimestamp_Get()
+#define IPC_STAT_US(t)		(t)
+#else
+#define IPC_STAT_TIME()		DWT->CYCCNT
+#define IPC_STAT_US(t)		((t) / (SystemCoreClock / 1000000))
+#endif
+
+/* Return the lowest set bit of *Pending and clear it. */
+static inline u32 IPC_PendingPop(u32 *Pending)
+{
+	u32 i;
+
+#if defined (CONFIG_ARM_CORE_CM0)
+	/* no CLZ/RBIT on ARMv8-M baseline, CMSIS emulates them with a loop anyway */
+	for (i = 0; (*Pending & BIT(i)) == 0; i++);
+#else
+	i = __CLZ(__RBIT(*Pending));
+#endif
+	*Pending &= *Pending - 1;
+
+	return i;
+}
+
 /** @addtogroup Ameba_Periph_Driver
   * @{
   */
@@ -110,23 +141,82 @@ u32 IPC_INTHandler(void *Data)
 {
 	IPC_TypeDef *IPCx = (IPC_TypeDef *)Data;
 	u32 IrqStatus;
+	u32 Pending;
+	u32 Unhandled = 0;
+	u32 start, cost;
 	u32 i;
 	IrqStatus = IPCx->IPC_ISR;
 
-	for (i = 0; i < 32; i++) {
-		if (IrqStatus & BIT(i)) {
-			if (IPC_IrqHandler[i] != NULL) {
-				IPC_IrqHandler[i](IPC_IrqData[i], IrqStatus, i);
-				IPCx->IPC_ISR = BIT(i);
-			} else {
-				IPCx->IPC_ISR = BIT(i);
+	/* visit set bits only, lowest channel first as before */
+	Pending = IrqStatus;
+	while (Pending) {
+		i = IPC_PendingPop(&Pending);
+
+		IPC_IrqCnt[i]++;
+		if (IPC_IrqHandler[i] != NULL) {
+			start = IPC_StatEn ? IPC_STAT_TIME() : 0;
+			IPC_IrqHandler[i](IPC_IrqData[i], IrqStatus, i);
+			/* clear after the handler, clearing rx full is what releases the sender */
+			IPCx->IPC_ISR = BIT(i);
+
+			if (IPC_StatEn) {
+				cost = IPC_STAT_TIME() - start;
+				if (cost > IPC_IrqMaxTime[i]) {
+					IPC_IrqMaxTime[i] = cost;
+				}
 			}
+		} else {
+			Unhandled |= BIT(i);
 		}
 	}
 
+	/* nobody waits for these, clear them with one write */
+	if (Unhandled) {
+		IPCx->IPC_ISR = Unhandled;
+	}
+
 	return 0;
 }
 
+/**
+  * @brief  Enable or disable timing of IPC interrupt handlers for IPC_INTGetStat.
+  * @param  NewState: ENABLE or DISABLE.
+  * @note   On KM4 enabling also starts the DWT cycle counter, which debug tools may own too.
+  * @retval None
+  */
+void IPC_INTStatCmd(u32 NewState)
+{
+#if !defined (CONFIG_ARM_CORE_CM0)
+	if (NewState == ENABLE) {
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+#endif
+
+	IPC_StatEn = (NewState == ENABLE);
+}
+
+/**
+  * @brief  Get interrupt statistics of a IPC channel.
+  * @param  IPC_Shiftbit: 0 ~ 31.
+  * @param  Count: return number of interrupts of this channel, can be NULL.
+  * @param  MaxTime: return the longest handler time in us, can be NULL. Stays 0 unless
+  *         IPC_INTStatCmd enabled the timing.
+  * @retval None
+  */
+void IPC_INTGetStat(u8 IPC_Shiftbit, u32 *Count, u32 *MaxTime)
+{
+	assert_param(IPC_Shiftbit < IPC_CHANNEL_NUM);
+
+	if (Count) {
+		*Count = IPC_IrqCnt[IPC_Shiftbit];
+	}
+
+	if (MaxTime) {
+		*MaxTime = IPC_STAT_US(IPC_IrqMaxTime[IPC_Shiftbit]);
+	}
+}
+
 /**
   * @brief  To register a user interrupt handler for a specified IPC channel
   * @param  where IPCx can be IPCKM0_DEV for KM0, IPCKM4_DEV for CM4.
@@ -144,6 +234,7 @@ void IPC_INTUserHandler(IPC_TypeDef *IPCx, u8 IPC_Shiftbit, void *IrqHandler, vo
 
 	IPC_IrqHandler[IPC_Shiftbit] = (IPC_IRQ_FUN)IrqHandler;
 	IPC_IrqData[IPC_Shiftbit] = IrqData;
+
 	if (IS_IPC_RX_CHNUM(IPC_Shiftbit)) {
 		IPC_INTConfig(IPCx, IPC_Shiftbit, ENABLE);
 	}
@@ -436,38 +436,24 @@ void SSI_SetDmaLevel(SPI_TypeDef *spi_dev, u32 TxLevel, u32 RxLevel)
 }
 
 /**
-  * @brief    Init and Enable SPI TX GDMA.
+  * @brief  Fill GDMA_InitStruct for a SPI TX transfer on an allocated channel.
   * @param  Index: 0 or 1.
-  * @param  GDMA_InitStruct: pointer to a GDMA_InitTypeDef structure that contains
-  *         the configuration information for the GDMA peripheral.
-  * @param  CallbackData: GDMA callback data.
-  * @param  CallbackFunc: GDMA callback function.
+  * @param  GDMA_InitStruct: pointer to a GDMA_InitTypeDef structure to fill.
+  * @param  GdmaChnl: GDMA channel already allocated by the caller.
   * @param  pTxData: Tx Buffer.
   * @param  Length: Tx Count.
   * @retval   TRUE/FLASE
   */
-
-bool SSI_TXGDMA_Init(
+static bool SSI_TXGDMA_Config(
 	u32 Index,
 	PGDMA_InitTypeDef GDMA_InitStruct,
-	void *CallbackData,
-	IRQ_FUN CallbackFunc,
+	u8 GdmaChnl,
 	u8 *pTxData,
 	u32 Length
 )
 {
 	SPI_TypeDef *SPIx = SPI_DEV_TABLE[Index].SPIx;
 	u32 DataFrameSize = SSI_GetDataFrameSize(SPIx);
-	u8 GdmaChnl;
-
-	assert_param(GDMA_InitStruct != NULL);
-
-	DCache_CleanInvalidate((u32) pTxData, Length);
-
-	GdmaChnl = GDMA_ChnlAlloc(0, CallbackFunc, (u32)CallbackData, INT_PRI_MIDDLE);
-	if (GdmaChnl == 0xFF) {
-		return FALSE;
-	}
 
 	GDMA_StructInit(GDMA_InitStruct);
 	GDMA_InitStruct->GDMA_DIR     = TTFCMemToPeri;
@@ -526,49 +512,72 @@ bool SSI_TXGDMA_Init(
 
 	GDMA_InitStruct->GDMA_SrcAddr = (u32)pTxData;
 
-	/*  Enable GDMA for TX */
-	GDMA_Init(GDMA_InitStruct->GDMA_Index, GDMA_InitStruct->GDMA_ChNum, GDMA_InitStruct);
-	GDMA_Cmd(GDMA_InitStruct->GDMA_Index, GDMA_InitStruct->GDMA_ChNum, ENABLE);
-
 	return TRUE;
 }
 
 /**
-  * @brief    Init and Enable SPI RX GDMA.
+  * @brief    Init and Enable SPI TX GDMA.
   * @param  Index: 0 or 1.
   * @param  GDMA_InitStruct: pointer to a GDMA_InitTypeDef structure that contains
   *         the configuration information for the GDMA peripheral.
   * @param  CallbackData: GDMA callback data.
   * @param  CallbackFunc: GDMA callback function.
-  * @param  pRxData: Rx Buffer.
-  * @param  Length: Rx Count.
+  * @param  pTxData: Tx Buffer.
+  * @param  Length: Tx Count.
   * @retval   TRUE/FLASE
   */
 
-bool
-SSI_RXGDMA_Init(
-	u8 Index,
-	GDMA_InitTypeDef *GDMA_InitStruct,
+bool SSI_TXGDMA_Init(
+	u32 Index,
+	PGDMA_InitTypeDef GDMA_InitStruct,
 	void *CallbackData,
 	IRQ_FUN CallbackFunc,
-	u8  *pRxData,
+	u8 *pTxData,
 	u32 Length
 )
 {
-	SPI_TypeDef *SPIx = SPI_DEV_TABLE[Index].SPIx;
-	u32 DataFrameSize = SSI_GetDataFrameSize(SPIx);
 	u8 GdmaChnl;
 
 	assert_param(GDMA_InitStruct != NULL);
 
-	DCache_CleanInvalidate((u32) pRxData, Length);
+	DCache_CleanInvalidate((u32) pTxData, Length);
 
 	GdmaChnl = GDMA_ChnlAlloc(0, CallbackFunc, (u32)CallbackData, INT_PRI_MIDDLE);
 	if (GdmaChnl == 0xFF) {
-		// No Available DMA channel
 		return FALSE;
 	}
 
+	if (SSI_TXGDMA_Config(Index, GDMA_InitStruct, GdmaChnl, pTxData, Length) == FALSE) {
+		return FALSE;
+	}
+
+	/*  Enable GDMA for TX */
+	GDMA_Init(GDMA_InitStruct->GDMA_Index, GDMA_InitStruct->GDMA_ChNum, GDMA_InitStruct);
+	GDMA_Cmd(GDMA_InitStruct->GDMA_Index, GDMA_InitStruct->GDMA_ChNum, ENABLE);
+
+	return TRUE;
+}
+
+/**
+  * @brief  Fill GDMA_InitStruct for a SPI RX transfer on an allocated channel.
+  * @param  Index: 0 or 1.
+  * @param  GDMA_InitStruct: pointer to a GDMA_InitTypeDef structure to fill.
+  * @param  GdmaChnl: GDMA channel already allocated by the caller.
+  * @param  pRxData: Rx Buffer.
+  * @param  Length: Rx Count.
+  * @retval   TRUE/FLASE
+  */
+static bool SSI_RXGDMA_Config(
+	u8 Index,
+	GDMA_InitTypeDef *GDMA_InitStruct,
+	u8 GdmaChnl,
+	u8  *pRxData,
+	u32 Length
+)
+{
+	SPI_TypeDef *SPIx = SPI_DEV_TABLE[Index].SPIx;
+	u32 DataFrameSize = SSI_GetDataFrameSize(SPIx);
+
 	GDMA_StructInit(GDMA_InitStruct);
 	GDMA_InitStruct->GDMA_DIR       = TTFCPeriToMem;
 	GDMA_InitStruct->GDMA_ReloadSrc = 0;
@@ -624,6 +633,47 @@ SSI_RXGDMA_Init(
 
 	GDMA_InitStruct->GDMA_DstAddr = (u32)pRxData;
 
+	return TRUE;
+}
+
+/**
+  * @brief    Init and Enable SPI RX GDMA.
+  * @param  Index: 0 or 1.
+  * @param  GDMA_InitStruct: pointer to a GDMA_InitTypeDef structure that contains
+  *         the configuration information for the GDMA peripheral.
+  * @param  CallbackData: GDMA callback data.
+  * @param  CallbackFunc: GDMA callback function.
+  * @param  pRxData: Rx Buffer.
+  * @param  Length: Rx Count.
+  * @retval   TRUE/FLASE
+  */
+
+bool
+SSI_RXGDMA_Init(
+	u8 Index,
+	GDMA_InitTypeDef *GDMA_InitStruct,
+	void *CallbackData,
+	IRQ_FUN CallbackFunc,
+	u8  *pRxData,
+	u32 Length
+)
+{
+	u8 GdmaChnl;
+
+	assert_param(GDMA_InitStruct != NULL);
+
+	DCache_CleanInvalidate((u32) pRxData, Length);
+
+	GdmaChnl = GDMA_ChnlAlloc(0, CallbackFunc, (u32)CallbackData, INT_PRI_MIDDLE);
+	if (GdmaChnl == 0xFF) {
+		// No Available DMA channel
+		return FALSE;
+	}
+
+	if (SSI_RXGDMA_Config(Index, GDMA_InitStruct, GdmaChnl, pRxData, Length) == FALSE) {
+		return FALSE;
+	}
+
 	/*  Enable GDMA for RX */
 	GDMA_Init(GDMA_InitStruct->GDMA_Index, GDMA_InitStruct->GDMA_ChNum, GDMA_InitStruct);
 	GDMA_Cmd(GDMA_InitStruct->GDMA_Index, GDMA_InitStruct->GDMA_ChNum, ENABLE);
@@ -631,6 +681,479 @@ SSI_RXGDMA_Init(
 	return TRUE;
 }
 
+/* Queued transactions: the queue owns one TX and one RX GDMA channel for its
+ * whole life, transactions are chained from the RX GDMA completion ISR.
+ * Completion is always signalled by RX, Tx-only transactions receive into a
+ * dummy word, so the RX FIFO never overflows and no busy wait is needed.
+ */
+static void SSI_Queue_Start(SSI_QueueTypeDef *Queue);
+
+static void SSI_Queue_CsSet(SSI_QueueTypeDef *Queue, u32 Assert)
+{
+	if (Queue->CsActive == Assert) {
+		return;
+	}
+
+	Queue->CsActive = Assert;
+	if (Queue->CsCtrl != NULL) {
+		Queue->CsCtrl(Queue->Index, Assert);
+	}
+}
+
+static void SSI_Queue_Done(SSI_QueueTypeDef *Queue, SSI_XferTypeDef *Xfer, u32 Status)
+{
+	u32 PrevIrqStatus = irq_disable_save();
+
+	Queue->Head = Xfer->Next;
+	if (Queue->Head == NULL) {
+		Queue->Tail = NULL;
+	}
+	irq_enable_restore(PrevIrqStatus);
+
+	if (Xfer->CsHold == 0) {
+		SSI_Queue_CsSet(Queue, 0);
+	}
+
+	if (Xfer->Callback != NULL) {
+		Xfer->Callback(Xfer->CbData, Status);
+	}
+}
+
+static void SSI_Queue_Header(SPI_TypeDef *SPIx, SSI_XferTypeDef *Xfer, u32 Wide)
+{
+	u16 Hdr16[5];
+	u8 Hdr8[5];
+	u32 Len = 0;
+	u32 Frame;
+	u32 i;
+
+	for (i = 0; i < (u32)Xfer->CmdLen + Xfer->AddrLen; i++) {
+		if (i < Xfer->CmdLen) {
+			Frame = Xfer->Cmd;
+		} else {
+			Frame = (Xfer->Addr >> ((Xfer->CmdLen + Xfer->AddrLen - 1 - i) * 8)) & 0xFF;
+		}
+		Hdr16[Len] = (u16)Frame;
+		Hdr8[Len] = (u8)Frame;
+		Len++;
+	}
+
+	if (Len) {
+		SSI_TransferFullDuplex(SPIx, Wide ? (void *)Hdr16 : (void *)Hdr8, NULL, Len);
+	}
+}
+
+static void SSI_Queue_Finish(SSI_QueueTypeDef *Queue, u32 Status)
+{
+	SPI_TypeDef *SPIx = SPI_DEV_TABLE[Queue->Index].SPIx;
+
+	SSI_SetDmaEnable(SPIx, DISABLE, SPI_BIT_TDMAE | SPI_BIT_RDMAE);
+
+	/* frames a failed transfer left in the FIFOs would go to the next one */
+	if (Status != RTK_SUCCESS) {
+		SSI_Cmd(SPIx, DISABLE);
+		SSI_Cmd(SPIx, ENABLE);
+	}
+
+	SSI_Queue_Done(Queue, Queue->Head, Status);
+	SSI_Queue_Start(Queue);
+}
+
+static u32 SSI_Queue_TxIrq(void *Data)
+{
+	SSI_QueueTypeDef *Queue = (SSI_QueueTypeDef *)Data;
+	u32 IsrType;
+
+	IsrType = GDMA_ClearINT(0, Queue->TxChnl);
+	GDMA_Cmd(0, Queue->TxChnl, DISABLE);
+
+	/* RX would wait forever for the frames TX failed to send */
+	if (IsrType & ErrType) {
+		GDMA_Abort(0, Queue->RxChnl);
+		GDMA_ClearINT(0, Queue->RxChnl);
+		SSI_Queue_Finish(Queue, RTK_FAIL);
+	}
+
+	return 0;
+}
+
+static u32 SSI_Queue_RxIrq(void *Data)
+{
+	SSI_QueueTypeDef *Queue = (SSI_QueueTypeDef *)Data;
+	u32 IsrType;
+
+	IsrType = GDMA_ClearINT(0, Queue->RxChnl);
+	GDMA_Cmd(0, Queue->RxChnl, DISABLE);
+
+	if (IsrType & ErrType) {
+		GDMA_Abort(0, Queue->TxChnl);
+		GDMA_ClearINT(0, Queue->TxChnl);
+		SSI_Queue_Finish(Queue, RTK_FAIL);
+	} else {
+		SSI_Queue_Finish(Queue, RTK_SUCCESS);
+	}
+
+	return 0;
+}
+
+/**
+  * @brief  Start queued transactions until one is handed to GDMA or the queue is empty.
+  * @param  Queue: queue whose Busy flag is owned by the caller.
+  * @retval None
+  */
+static void SSI_Queue_Start(SSI_QueueTypeDef *Queue)
+{
+	SPI_TypeDef *SPIx = SPI_DEV_TABLE[Queue->Index].SPIx;
+	SSI_XferTypeDef *Xfer;
+	u32 PrevIrqStatus;
+	u32 Wide;
+	u8 *RxBuf;
+
+	while (1) {
+		PrevIrqStatus = irq_disable_save();
+		Xfer = Queue->Head;
+		if (Xfer == NULL) {
+			Queue->Busy = 0;
+		}
+		irq_enable_restore(PrevIrqStatus);
+
+		if (Xfer == NULL) {
+			return;
+		}
+
+		if ((Xfer->DataFrameSize != 0) && (Xfer->DataFrameSize != SSI_GetDataFrameSize(SPIx) - 1)) {
+			SSI_SetDataFrameSize(SPIx, Xfer->DataFrameSize);
+		}
+		Wide = (SSI_GetDataFrameSize(SPIx) > 8) ? 1 : 0;
+
+		SSI_Queue_CsSet(Queue, 1);
+		SSI_Queue_Header(SPIx, Xfer, Wide);
+
+		if (Xfer->Length < Queue->PollThreshold) {
+			SSI_TransferFullDuplex(SPIx, Xfer->TxData, Xfer->RxData, Wide ? (Xfer->Length >> 1) : Xfer->Length);
+			SSI_Queue_Done(Queue, Xfer, RTK_SUCCESS);
+			continue;
+		}
+
+		RxBuf = (Xfer->RxData != NULL) ? Xfer->RxData : (u8 *)&Queue->RxDummy;
+		if ((SSI_RXGDMA_Config(Queue->Index, &Queue->RxGdma, Queue->RxChnl, RxBuf, Xfer->Length) == FALSE) ||
+			(SSI_TXGDMA_Config(Queue->Index, &Queue->TxGdma, Queue->TxChnl,
+							   (Xfer->TxData != NULL) ? Xfer->TxData : (u8 *)&Queue->TxDummy, Xfer->Length) == FALSE)) {
+			SSI_Queue_Done(Queue, Xfer, RTK_FAIL);
+			continue;
+		}
+
+		if (Xfer->RxData != NULL) {
+			DCache_CleanInvalidate((u32)Xfer->RxData, Xfer->Length);
+		} else {
+			Queue->RxGdma.GDMA_DstInc = NoChange;
+		}
+
+		if (Xfer->TxData != NULL) {
+			DCache_Clean((u32)Xfer->TxData, Xfer->Length);
+		} else {
+			Queue->TxDummy = 0;
+			DCache_Clean((u32)&Queue->TxDummy, sizeof(Queue->TxDummy));
+			Queue->TxGdma.GDMA_SrcInc = NoChange;
+		}
+
+		/* RX first, so nothing is lost once TX starts clocking */
+		GDMA_Init(0, Queue->RxChnl, &Queue->RxGdma);
+		GDMA_Cmd(0, Queue->RxChnl, ENABLE);
+		GDMA_Init(0, Queue->TxChnl, &Queue->TxGdma);
+		GDMA_Cmd(0, Queue->TxChnl, ENABLE);
+		SSI_SetDmaEnable(SPIx, ENABLE, SPI_BIT_TDMAE | SPI_BIT_RDMAE);
+
+		return;
+	}
+}
+
+/**
+  * @brief  Init a SPI transaction queue and allocate its GDMA channels.
+  * @param  Queue: queue to init.
+  * @param  Index: 0 or 1, SPI must be already initialized as master by SSI_Init.
+  * @param  PollThreshold: data phases shorter than this many bytes are done by polling.
+  * @param  CsCtrl: optional GPIO CS control, called with Assert 1/0. When NULL the
+  *		hardware SS is used, which may toggle between the header and data phases.
+  * @retval   TRUE/FLASE
+  */
+bool SSI_QueueInit(SSI_QueueTypeDef *Queue, u32 Index, u32 PollThreshold, void (*CsCtrl)(u32 Index, u32 Assert))
+{
+	assert_param(Queue != NULL);
+	assert_param(Index < 2);
+
+	_memset(Queue, 0, sizeof(SSI_QueueTypeDef));
+	Queue->Index = Index;
+	Queue->PollThreshold = PollThreshold;
+	Queue->CsCtrl = CsCtrl;
+
+	Queue->TxChnl = GDMA_ChnlAlloc(0, (IRQ_FUN)SSI_Queue_TxIrq, (u32)Queue, INT_PRI_MIDDLE);
+	if (Queue->TxChnl == 0xFF) {
+		return FALSE;
+	}
+
+	Queue->RxChnl = GDMA_ChnlAlloc(0, (IRQ_FUN)SSI_Queue_RxIrq, (u32)Queue, INT_PRI_MIDDLE);
+	if (Queue->RxChnl == 0xFF) {
+		GDMA_ChnlFree(0, Queue->TxChnl);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/**
+  * @brief  Release the GDMA channels of an idle SPI transaction queue.
+  * @param  Queue: queue to deinit.
+  * @retval None
+  */
+void SSI_QueueDeInit(SSI_QueueTypeDef *Queue)
+{
+	assert_param(Queue->Busy == 0);
+
+	GDMA_ChnlFree(0, Queue->TxChnl);
+	GDMA_ChnlFree(0, Queue->RxChnl);
+}
+
+/**
+  * @brief  Append a transaction to the queue, start it if the queue is idle.
+  * @param  Queue: queue initialized by SSI_QueueInit.
+  * @param  Xfer: transaction, must stay valid until its callback is called.
+  * @retval RTK_SUCCESS
+  * @note  Polled transactions started here run in the caller context, the rest
+  *		run back to back from the GDMA ISR, so callbacks must be ISR safe.
+  * @note  For 9~16 bits frames, Length and buffers must be 2 bytes aligned.
+  */
+u32 SSI_QueueSubmit(SSI_QueueTypeDef *Queue, SSI_XferTypeDef *Xfer)
+{
+	u32 PrevIrqStatus;
+	u32 Start;
+
+	assert_param(Xfer->CmdLen <= 1);
+	assert_param(Xfer->AddrLen <= 4);
+
+	Xfer->Next = NULL;
+
+	PrevIrqStatus = irq_disable_save();
+	if (Queue->Tail != NULL) {
+		Queue->Tail->Next = Xfer;
+	} else {
+		Queue->Head = Xfer;
+	}
+	Queue->Tail = Xfer;
+
+	Start = (Queue->Busy == 0) ? 1 : 0;
+	Queue->Busy = 1;
+	irq_enable_restore(PrevIrqStatus);
+
+	if (Start) {
+		SSI_Queue_Start(Queue);
+	}
+
+	return RTK_SUCCESS;
+}
+
+/**
+  * @brief  Check whether a SPI transaction queue still has work in flight.
+  * @param  Queue: queue initialized by SSI_QueueInit.
+  * @retval 1: busy, 0: idle
+  */
+u32 SSI_QueueBusy(SSI_QueueTypeDef *Queue)
+{
+	return Queue->Busy;
+}
+
+/* Slave Rx ring: one GDMA channel runs a cyclic LLI chain over all buffers, so
+ * nothing has to be re-armed between buffers. Done/Taken/Freed only grow, the
+ * buffer of a counter is Buf[counter % BufNum].
+ */
+static u32 SSI_RxRing_Irq(void *Data)
+{
+	SSI_SlaveRxRingTypeDef *Ring = (SSI_SlaveRxRingTypeDef *)Data;
+	SPI_TypeDef *SPIx = SPI_DEV_TABLE[Ring->Index].SPIx;
+	u32 DstAddr;
+	u32 Cur;
+	u32 Idx;
+	u8 *Buf;
+
+	GDMA_ClearINT(0, Ring->Gdma.GDMA_ChNum);
+
+	if (SSI_GetRawIsr(SPIx) & SPI_BIT_RXOIR) {
+		SSI_SetIsrClean(SPIx, SPI_BIT_RXOIS);
+		Ring->OverrunCnt++;
+	}
+
+	/* find the buffer GDMA is filling now, several blocks may have completed
+	 * if this ISR was delayed */
+	DstAddr = GDMA_GetDstAddr(0, Ring->Gdma.GDMA_ChNum);
+	for (Cur = 0; Cur < Ring->BufNum; Cur++) {
+		if ((DstAddr >= (u32)Ring->Buf[Cur]) && (DstAddr < (u32)Ring->Buf[Cur] + Ring->BufSize)) {
+			break;
+		}
+	}
+	if (Cur == Ring->BufNum) {
+		Cur = (Ring->Done + 1) % Ring->BufNum;
+	}
+
+	while ((Ring->Done % Ring->BufNum) != Cur) {
+		Idx = Ring->Done % Ring->BufNum;
+		Ring->Done++;
+
+		/* GDMA has wrapped onto a buffer that is still not released */
+		if (Ring->Done - Ring->Freed >= Ring->BufNum) {
+			Ring->LateCnt++;
+			if (Ring->Taken == Ring->Freed) {
+				Ring->Taken++;
+				Ring->Freed++;
+			}
+		}
+
+		Buf = Ring->Buf[Idx];
+		DCache_Invalidate((u32)Buf, Ring->BufSize);
+
+		if (Ring->Callback != NULL) {
+			Ring->Taken++;
+			Ring->Callback(Ring->CbData, Buf, Ring->BufSize);
+		}
+	}
+
+	return 0;
+}
+
+/**
+  * @brief  Start continuous slave reception into a ring of buffers by GDMA LLP.
+  * @param  Ring: ring control block.
+  * @param  Index: 0 or 1, SPI must be already initialized as slave by SSI_Init.
+  * @param  Buf: array of BufNum buffer pointers, buffers should be cache line aligned.
+  * @param  BufNum: number of buffers, at least 2.
+  * @param  BufSize: buffer size in bytes, multiple of 2 for 9~16 bits frames.
+  * @param  Lli: array of BufNum LLI nodes, must stay valid until the ring is stopped.
+  * @param  Callback: called from ISR with each filled buffer, the buffer belongs to
+  *		the application until SSI_SlaveRxRingRelease. NULL to poll by SSI_SlaveRxRingGet.
+  * @param  CbData: Callback argument.
+  * @retval   TRUE/FLASE
+  * @note  Buffers must be released in order, and before GDMA wraps back onto them,
+  *		otherwise they are overwritten and counted in LateCnt.
+  */
+bool SSI_SlaveRxRingInit(SSI_SlaveRxRingTypeDef *Ring, u32 Index, u8 **Buf, u32 BufNum, u32 BufSize,
+						 struct GDMA_CH_LLI *Lli, SSI_RX_RING_CB Callback, void *CbData)
+{
+	SPI_TypeDef *SPIx = SPI_DEV_TABLE[Index].SPIx;
+	GDMA_InitTypeDef *GDMA_InitStruct = &Ring->Gdma;
+	u8 GdmaChnl;
+	u32 i;
+
+	assert_param(Index < 2);
+	assert_param(BufNum >= 2);
+
+	_memset(Ring, 0, sizeof(SSI_SlaveRxRingTypeDef));
+	Ring->Index = Index;
+	Ring->Buf = Buf;
+	Ring->BufNum = BufNum;
+	Ring->BufSize = BufSize;
+	Ring->Lli = Lli;
+	Ring->Callback = Callback;
+	Ring->CbData = CbData;
+
+	if (SSI_RXGDMA_Config(Index, GDMA_InitStruct, 0, Buf[0], BufSize) == FALSE) {
+		return FALSE;
+	}
+	assert_param(GDMA_InitStruct->GDMA_BlockSize <= BIT_CTLX_UP_BLOCK_BS);
+
+	GdmaChnl = GDMA_ChnlAlloc(0, (IRQ_FUN)SSI_RxRing_Irq, (u32)Ring, INT_PRI_MIDDLE);
+	if (GdmaChnl == 0xFF) {
+		return FALSE;
+	}
+
+	GDMA_InitStruct->GDMA_ChNum = GdmaChnl;
+	GDMA_InitStruct->GDMA_IsrType = (BlockType | ErrType);
+	GDMA_InitStruct->MuliBlockCunt = 0;
+	GDMA_InitStruct->MaxMuliBlock = BufNum;
+	GDMA_InitStruct->GDMA_LlpSrcEn = 1;
+	GDMA_InitStruct->GDMA_LlpDstEn = 1;
+
+	for (i = 0; i < BufNum; i++) {
+		Lli[i].LliEle.Sarx = (u32)&SPIx->SPI_DRx;
+		Lli[i].LliEle.Darx = (u32)Buf[i];
+		Lli[i].BlockSize = GDMA_InitStruct->GDMA_BlockSize;
+		Lli[i].pNextLli = &Lli[(i + 1) % BufNum];
+		DCache_CleanInvalidate((u32)Buf[i], BufSize);
+	}
+
+	GDMA_Init(0, GdmaChnl, GDMA_InitStruct);
+	GDMA_SetLLP(0, GdmaChnl, BufNum, Lli, 1);
+	DCache_CleanInvalidate((u32)Lli, BufNum * sizeof(*Lli));
+	GDMA_Cmd(0, GdmaChnl, ENABLE);
+
+	SSI_SetIsrClean(SPIx, SPI_BIT_RXOIS);
+	SSI_SetDmaEnable(SPIx, ENABLE, SPI_BIT_RDMAE);
+
+	return TRUE;
+}
+
+/**
+  * @brief  Stop slave ring reception and release its GDMA channel.
+  * @param  Ring: ring started by SSI_SlaveRxRingInit.
+  * @retval None
+  */
+void SSI_SlaveRxRingStop(SSI_SlaveRxRingTypeDef *Ring)
+{
+	SPI_TypeDef *SPIx = SPI_DEV_TABLE[Ring->Index].SPIx;
+
+	SSI_SetDmaEnable(SPIx, DISABLE, SPI_BIT_RDMAE);
+	GDMA_Cmd(0, Ring->Gdma.GDMA_ChNum, DISABLE);
+	GDMA_ClearINT(0, Ring->Gdma.GDMA_ChNum);
+	GDMA_ChnlFree(0, Ring->Gdma.GDMA_ChNum);
+}
+
+/**
+  * @brief  Take the oldest filled buffer without copying.
+  * @param  Ring: ring started by SSI_SlaveRxRingInit with no Callback.
+  * @note   When GDMA has come round onto the oldest filled buffer (LateCnt grew) while the
+  *		application holds buffers, it fails until they are all released, then the
+  *		overwritten buffers are skipped.
+  * @retval filled buffer of BufSize bytes, or NULL if none is ready.
+  */
+u8 *SSI_SlaveRxRingGet(SSI_SlaveRxRingTypeDef *Ring)
+{
+	u32 PrevIrqStatus = irq_disable_save();
+	u8 *Buf = NULL;
+
+	/* only the BufNum - 1 buffers behind the one GDMA is filling are intact */
+	if (Ring->Done - Ring->Taken >= Ring->BufNum) {
+		if (Ring->Taken != Ring->Freed) {
+			irq_enable_restore(PrevIrqStatus);
+			return NULL;
+		}
+		Ring->Taken = Ring->Done - (Ring->BufNum - 1);
+		Ring->Freed = Ring->Taken;
+	}
+
+	if (Ring->Taken != Ring->Done) {
+		Buf = Ring->Buf[Ring->Taken % Ring->BufNum];
+		Ring->Taken++;
+	}
+	irq_enable_restore(PrevIrqStatus);
+
+	return Buf;
+}
+
+/**
+  * @brief  Give the oldest taken buffer back to GDMA.
+  * @param  Ring: ring started by SSI_SlaveRxRingInit.
+  * @retval None
+  */
+void SSI_SlaveRxRingRelease(SSI_SlaveRxRingTypeDef *Ring)
+{
+	u32 PrevIrqStatus = irq_disable_save();
+
+	if (Ring->Freed != Ring->Taken) {
+		/* drop lines the application may have dirtied, before GDMA refills it */
+		DCache_Invalidate((u32)Ring->Buf[Ring->Freed % Ring->BufNum], Ring->BufSize);
+		Ring->Freed++;
+	}
+	irq_enable_restore(PrevIrqStatus);
+}
+
 /**
   * @brief Clear SPIx interrupt status.
   * @param  spi_dev: where spi_dev can be SPI0_DEV or SPI1_DEV.
@@ -892,6 +1415,101 @@ u32 SSI_SendData(SPI_TypeDef *spi_dev,
 	return (Length - TxLength);
 }
 
+/* Full-duplex FIFO pump, specialized per frame width and per NULL buffer case
+ * so that the inner loops carry no per-frame branch. TX is refilled only up
+ * to what the RX FIFO can still absorb, so the RX FIFO can never overflow.
+ */
+#define SSI_FDX_PUMP(name, type, TX_FETCH, RX_STORE)					\
+static u32 name(SPI_TypeDef *spi_dev, const type *tx, type *rx, u32 Length)		\
+{											\
+	u32 TxLeft = Length;								\
+	u32 RxLeft = Length;								\
+	u32 Cnt;									\
+	u32 Room;									\
+	u32 Data;									\
+											\
+	(void)tx;									\
+	(void)rx;									\
+	(void)Data;									\
+											\
+	while (RxLeft) {								\
+		/* drain whatever has arrived */					\
+		Cnt = spi_dev->SPI_RXFLR & SPI_MASK_RXTFL;				\
+		if (Cnt > RxLeft) {							\
+			Cnt = RxLeft;							\
+		}									\
+		RxLeft -= Cnt;								\
+		while (Cnt--) {								\
+			Data = spi_dev->SPI_DRx[0];					\
+			RX_STORE;							\
+		}									\
+											\
+		/* top up TX, bounded by TX room and free RX space */			\
+		Cnt = SSI_TX_FIFO_DEPTH - (spi_dev->SPI_TXFLR & SPI_MASK_TXTFL);	\
+		Room = SSI_RX_FIFO_DEPTH - (RxLeft - TxLeft);				\
+		if (Cnt > Room) {							\
+			Cnt = Room;							\
+		}									\
+		if (Cnt > TxLeft) {							\
+			Cnt = TxLeft;							\
+		}									\
+		TxLeft -= Cnt;								\
+		while (Cnt--) {								\
+			spi_dev->SPI_DRx[0] = TX_FETCH;					\
+		}									\
+	}										\
+											\
+	return Length;									\
+}
+
+SSI_FDX_PUMP(SSI_FDX_Pump8, u8, *tx++, *rx++ = (u8)Data)
+SSI_FDX_PUMP(SSI_FDX_Pump8_TxOnly, u8, *tx++, (void)0)
+SSI_FDX_PUMP(SSI_FDX_Pump8_RxOnly, u8, 0, *rx++ = (u8)Data)
+SSI_FDX_PUMP(SSI_FDX_Pump16, u16, *tx++, *rx++ = (u16)Data)
+SSI_FDX_PUMP(SSI_FDX_Pump16_TxOnly, u16, *tx++, (void)0)
+SSI_FDX_PUMP(SSI_FDX_Pump16_RxOnly, u16, 0, *rx++ = (u16)Data)
+SSI_FDX_PUMP(SSI_FDX_PumpDummy, u8, 0, (void)0)
+
+/**
+  * @brief  Exchange data with the peer in full-duplex polling mode.
+  * @param  spi_dev: where spi_dev can be SPI0_DEV or SPI1_DEV.
+  * @param  TxData: data to send, or NULL to clock out zero frames.
+  * @param  RxData: buffer for received data, or NULL to drop it.
+  * @param  Length: number of data frames to exchange.
+  * @retval transfer len
+  * @note  Frames of 9~16 bits use u16 buffers, frames of 4~8 bits use u8 buffers.
+  * @note  The TX FIFO is kept topped up while RX is drained, and no IRQ mask
+  *		is touched, so SPI interrupts should be masked by the caller.
+  * @note  The call blocks until all frames are received. In slave mode the
+  *		peer master must clock out all Length frames.
+  */
+u32 SSI_TransferFullDuplex(SPI_TypeDef *spi_dev, const void *TxData, void *RxData, u32 Length)
+{
+	if (Length == 0) {
+		return 0;
+	}
+
+	if (SSI_GetDataFrameSize(spi_dev) > 8) {
+		if (TxData == NULL && RxData == NULL) {
+			return SSI_FDX_PumpDummy(spi_dev, NULL, NULL, Length);
+		} else if (TxData == NULL) {
+			return SSI_FDX_Pump16_RxOnly(spi_dev, NULL, (u16 *)RxData, Length);
+		} else if (RxData == NULL) {
+			return SSI_FDX_Pump16_TxOnly(spi_dev, (const u16 *)TxData, NULL, Length);
+		}
+		return SSI_FDX_Pump16(spi_dev, (const u16 *)TxData, (u16 *)RxData, Length);
+	}
+
+	if (TxData == NULL && RxData == NULL) {
+		return SSI_FDX_PumpDummy(spi_dev, NULL, NULL, Length);
+	} else if (TxData == NULL) {
+		return SSI_FDX_Pump8_RxOnly(spi_dev, NULL, (u8 *)RxData, Length);
+	} else if (RxData == NULL) {
+		return SSI_FDX_Pump8_TxOnly(spi_dev, (const u8 *)TxData, NULL, Length);
+	}
+	return SSI_FDX_Pump8(spi_dev, (const u8 *)TxData, (u8 *)RxData, Length);
+}
+
 /**
   * @brief  Get Masks or unmasks SPIx interrupt.
   * @param  spi_dev: where spi_dev can be SPI0_DEV or SPI1_DEV.
@@ -1602,6 +1602,235 @@ bool AUDIO_SP_LLPRXGDMA_Init(
 	return TRUE;
 }
 
+/* Stream: the LLIs form a circle over PeriodNum periods and GDMA never stops.
+ * The block ISR only advances HwCnt, the application only advances SwCnt.
+ * TX periods are zeroed by the ISR once played, so an underrun plays silence
+ * instead of repeating old audio. The ISR takes the period GDMA works on from
+ * its current address, so interrupts merged under load are not lost.
+ */
+static u32 AUDIO_SP_Stream_Irq(void *Data)
+{
+	AUDIO_SP_StreamTypeDef *Stream = (AUDIO_SP_StreamTypeDef *)Data;
+	u8 GdmaChnl = Stream->Gdma.GDMA_ChNum;
+	u32 Addr;
+	u32 Cur;
+	u32 Slot;
+	u32 HwCnt = Stream->HwCnt;
+
+	GDMA_ClearINT(0, GdmaChnl);
+
+	if (Stream->Direction == SP_DIR_TX) {
+		Addr = GDMA_GetSrcAddr(0, GdmaChnl);
+	} else {
+		Addr = GDMA_GetDstAddr(0, GdmaChnl);
+	}
+	Cur = (Addr - (u32)Stream->Buf) / Stream->PeriodBytes;
+	if (Cur >= Stream->PeriodNum) {
+		Cur = Stream->PeriodNum - 1;
+	}
+
+	while ((HwCnt % Stream->PeriodNum) != Cur) {
+		Slot = HwCnt % Stream->PeriodNum;
+
+		if (Stream->Direction == SP_DIR_TX) {
+			/* nothing committed yet is start up silence, not an underrun */
+			if ((Stream->SwCnt != 0) && ((s32)(Stream->SwCnt - HwCnt) <= 0)) {
+				Stream->XrunCnt++;
+			}
+			_memset(Stream->Buf + Slot * Stream->PeriodBytes, 0, Stream->PeriodBytes);
+			DCache_Clean((u32)(Stream->Buf + Slot * Stream->PeriodBytes), Stream->PeriodBytes);
+		} else {
+			if (HwCnt + 1 - Stream->SwCnt >= Stream->PeriodNum) {
+				Stream->XrunCnt++;
+			}
+		}
+
+		HwCnt++;
+	}
+
+	__DMB();
+	Stream->HwCnt = HwCnt;
+
+	if (Stream->Callback != NULL) {
+		Stream->Callback(Stream->CbData, HwCnt);
+	}
+
+	return 0;
+}
+
+/* Skip periods the application fell behind on, it runs in application context only. */
+static void AUDIO_SP_Stream_Sync(AUDIO_SP_StreamTypeDef *Stream)
+{
+	u32 HwCnt = Stream->HwCnt;
+
+	if (Stream->Direction == SP_DIR_TX) {
+		/* the period in progress can not be written any more */
+		if ((s32)(Stream->SwCnt - (HwCnt + 1)) < 0) {
+			Stream->SwCnt = HwCnt + 1;
+		}
+	} else {
+		if (HwCnt - Stream->SwCnt >= Stream->PeriodNum) {
+			Stream->SwCnt = HwCnt - (Stream->PeriodNum - 1);
+		}
+	}
+}
+
+/**
+  * @brief  Start a continuous SPORT stream over a ring of periods in GDMA LLP mode.
+  * @param  Stream: stream control block.
+  * @param  Index: select SPORT.
+  * @param  Direction: SP_DIR_TX or SP_DIR_RX.
+  * @param  SelGDMA: GDMA Int or Ext.
+  * @param  Buf: PeriodNum * PeriodBytes ring buffer, cache line aligned.
+  * @param  PeriodBytes: period size in bytes, multiple of cache line size.
+  * @param  PeriodNum: number of periods, at least 2.
+  * @param  Lli: PeriodNum LLIs for GDMA, cache line aligned.
+  * @param  Callback: period elapsed callback in GDMA ISR, can be NULL.
+  * @param  CbData: callback argument.
+  * @note   The ring starts as silence. SPORT should be started by AUDIO_SP_TXStart/AUDIO_SP_RXStart
+  *         after this function. The application then moves data with AUDIO_SP_StreamGetPeriod
+  *         and AUDIO_SP_StreamCommit from one task, without disabling interrupts.
+  * @retval TRUE/FLASE
+  */
+bool AUDIO_SP_StreamInit(
+	AUDIO_SP_StreamTypeDef *Stream,
+	u32 Index,
+	u32 Direction,
+	u32 SelGDMA,
+	u8 *Buf,
+	u32 PeriodBytes,
+	u32 PeriodNum,
+	struct GDMA_CH_LLI *Lli,
+	AUDIO_SP_STREAM_CB Callback,
+	void *CbData
+)
+{
+	u32 i;
+	bool ret;
+
+	assert_param(IS_SP_SET_DIR(Direction));
+	assert_param((PeriodNum >= 2) && ((PeriodBytes & 0x03) == 0));
+
+	_memset((void *)Stream, 0, sizeof(AUDIO_SP_StreamTypeDef));
+	Stream->Index = Index;
+	Stream->Direction = Direction;
+	Stream->Buf = Buf;
+	Stream->PeriodBytes = PeriodBytes;
+	Stream->PeriodNum = PeriodNum;
+	Stream->Lli = Lli;
+	Stream->Callback = Callback;
+	Stream->CbData = CbData;
+
+	_memset(Buf, 0, PeriodBytes * PeriodNum);
+	DCache_CleanInvalidate((u32)Buf, PeriodBytes * PeriodNum);
+
+	for (i = 0; i < PeriodNum; i++) {
+		if (Direction == SP_DIR_TX) {
+			Lli[i].LliEle.Sarx = (u32)(Buf + i * PeriodBytes);
+		} else {
+			Lli[i].LliEle.Darx = (u32)(Buf + i * PeriodBytes);
+		}
+		Lli[i].pNextLli = &Lli[(i + 1) % PeriodNum];
+	}
+
+	if (Direction == SP_DIR_TX) {
+		ret = AUDIO_SP_LLPTXGDMA_Init(Index, SelGDMA, &Stream->Gdma, (void *)Stream, (IRQ_FUN)AUDIO_SP_Stream_Irq,
+									  PeriodBytes, PeriodNum, Lli);
+	} else {
+		ret = AUDIO_SP_LLPRXGDMA_Init(Index, SelGDMA, &Stream->Gdma, (void *)Stream, (IRQ_FUN)AUDIO_SP_Stream_Irq,
+									  PeriodBytes, PeriodNum, Lli);
+	}
+	if (ret == FALSE) {
+		return FALSE;
+	}
+
+	/* period complete is the only event needed, the chain never ends */
+	GDMA_INTConfig(0, Stream->Gdma.GDMA_ChNum, TransferType, DISABLE);
+
+	return TRUE;
+}
+
+/**
+  * @brief  Stop a SPORT stream and release its GDMA channel.
+  * @param  Stream: stream started by AUDIO_SP_StreamInit.
+  * @retval None
+  */
+void AUDIO_SP_StreamDeInit(AUDIO_SP_StreamTypeDef *Stream)
+{
+	GDMA_Abort(0, Stream->Gdma.GDMA_ChNum);
+	GDMA_ClearINT(0, Stream->Gdma.GDMA_ChNum);
+	GDMA_ChnlFree(0, Stream->Gdma.GDMA_ChNum);
+}
+
+/**
+  * @brief  Get the number of periods the application can handle now.
+  * @param  Stream: stream started by AUDIO_SP_StreamInit.
+  * @retval TX: periods that can be written. RX: periods that can be read.
+  */
+u32 AUDIO_SP_StreamAvail(AUDIO_SP_StreamTypeDef *Stream)
+{
+	AUDIO_SP_Stream_Sync(Stream);
+
+	if (Stream->Direction == SP_DIR_TX) {
+		return Stream->HwCnt + Stream->PeriodNum - Stream->SwCnt;
+	} else {
+		return Stream->HwCnt - Stream->SwCnt;
+	}
+}
+
+/**
+  * @brief  Get the ring fill level.
+  * @param  Stream: stream started by AUDIO_SP_StreamInit.
+  * @retval TX: periods queued for playback, including the one being played.
+  *         RX: periods captured but not read yet.
+  */
+u32 AUDIO_SP_StreamFill(AUDIO_SP_StreamTypeDef *Stream)
+{
+	u32 Avail = AUDIO_SP_StreamAvail(Stream);
+
+	if (Stream->Direction == SP_DIR_TX) {
+		return Stream->PeriodNum - Avail;
+	} else {
+		return Avail;
+	}
+}
+
+/**
+  * @brief  Get the next period to write (TX) or read (RX).
+  * @param  Stream: stream started by AUDIO_SP_StreamInit.
+  * @retval Period address, or NULL if no period is available.
+  */
+u8 *AUDIO_SP_StreamGetPeriod(AUDIO_SP_StreamTypeDef *Stream)
+{
+	u8 *Period;
+
+	if (AUDIO_SP_StreamAvail(Stream) == 0) {
+		return NULL;
+	}
+
+	Period = Stream->Buf + (Stream->SwCnt % Stream->PeriodNum) * Stream->PeriodBytes;
+	if (Stream->Direction == SP_DIR_RX) {
+		DCache_Invalidate((u32)Period, Stream->PeriodBytes);
+	}
+
+	return Period;
+}
+
+/**
+  * @brief  Hand the period returned by AUDIO_SP_StreamGetPeriod back to the stream.
+  * @param  Stream: stream started by AUDIO_SP_StreamInit.
+  * @retval None
+  */
+void AUDIO_SP_StreamCommit(AUDIO_SP_StreamTypeDef *Stream)
+{
+	if (Stream->Direction == SP_DIR_TX) {
+		DCache_Clean((u32)(Stream->Buf + (Stream->SwCnt % Stream->PeriodNum) * Stream->PeriodBytes), Stream->PeriodBytes);
+		__DMB();
+	}
+
+	Stream->SwCnt++;
+}
+
 /**
   * @brief  Enable or disable SPORT TX counter interrupt.
   * @param  index: select SPORT.
@@ -263,6 +263,432 @@ bool UART_RXGDMA_Init(
 	return TRUE;
 }
 
+/* RX ring: GDMA streams into the ring from the offset it was armed at up to
+ * the ring end. At the end it is re-armed at offset 0 from the block ISR.
+ * When the line goes idle, the RX timeout interrupt fires for the few bytes
+ * under one DMA burst that are still in the FIFO. The ISR then stops the
+ * channel, copies those bytes in behind the DMA data and re-arms after them.
+ * The 64-byte RX FIFO absorbs the short re-arm gap, so no byte is lost.
+ */
+static void UART_RxRing_Arm(UART_RxRingTypeDef *Ring, u32 Pos)
+{
+	GDMA_InitTypeDef *GDMA_InitStruct = &Ring->Gdma;
+
+	Ring->ArmPos = Pos;
+	Ring->ArmWr = Ring->Wr;
+
+	GDMA_InitStruct->GDMA_DstAddr = (u32)(Ring->Buf + Pos);
+	GDMA_InitStruct->GDMA_BlockSize = Ring->Size - Pos;
+
+	GDMA_Init(GDMA_InitStruct->GDMA_Index, GDMA_InitStruct->GDMA_ChNum, GDMA_InitStruct);
+	GDMA_Cmd(GDMA_InitStruct->GDMA_Index, GDMA_InitStruct->GDMA_ChNum, ENABLE);
+}
+
+/* GDMA does not stop at Rd: when it has come round past the application, the
+ * bytes it wrote over are lost. Count them and move Rd to the oldest byte left.
+ * Called with interrupts disabled.
+ */
+static void UART_RxRing_Overrun(UART_RxRingTypeDef *Ring)
+{
+	u32 Len = Ring->Wr - Ring->Rd;
+
+	if (Len > Ring->Size) {
+		Ring->OverflowCnt += Len - Ring->Size;
+		Ring->Rd = Ring->Wr - Ring->Size;
+	}
+}
+
+static u32 UART_RxRing_DmaIrq(void *Data)
+{
+	UART_RxRingTypeDef *Ring = (UART_RxRingTypeDef *)Data;
+	u32 PrevIrqStatus;
+	u32 IsrType;
+	u32 Wr;
+
+	PrevIrqStatus = irq_disable_save();
+	IsrType = GDMA_ClearINT(0, Ring->GdmaChnl);
+
+	if (IsrType & ErrType) {
+		/* the channel stopped, keep what it moved and re-arm behind it */
+		Ring->DmaErrCnt++;
+		GDMA_Abort(0, Ring->GdmaChnl);
+		Ring->Wr = Ring->ArmWr + (GDMA_GetDstAddr(0, Ring->GdmaChnl) - (u32)(Ring->Buf + Ring->ArmPos));
+		UART_RxRing_Overrun(Ring);
+		UART_RxRing_Arm(Ring, Ring->Wr % Ring->Size);
+	} else if (IsrType & (BlockType | TransferType)) {
+		GDMA_Cmd(0, Ring->GdmaChnl, DISABLE);
+		Ring->Wr = Ring->ArmWr + (Ring->Size - Ring->ArmPos);
+		UART_RxRing_Overrun(Ring);
+		UART_RxRing_Arm(Ring, 0);
+	} else {
+		/* already handled by the timeout ISR if the status is gone */
+		irq_enable_restore(PrevIrqStatus);
+		return 0;
+	}
+	Wr = Ring->Wr;
+	irq_enable_restore(PrevIrqStatus);
+
+	if (Ring->Callback != NULL) {
+		Ring->Callback(Ring->CbData, Wr);
+	}
+
+	return 0;
+}
+
+static u32 UART_RxRing_UartIrq(void *Data)
+{
+	UART_RxRingTypeDef *Ring = (UART_RxRingTypeDef *)Data;
+	UART_TypeDef *UARTx = UART_DEV_TABLE[Ring->UartIndex].UARTx;
+	u32 PrevIrqStatus;
+	u32 Pos;
+	u32 Start;
+	u8 Drop;
+	u32 Wr;
+
+	if ((UART_LineStatusGet(UARTx) & RUART_BIT_TIMEOUT_INT) == 0) {
+		return 0;
+	}
+
+	PrevIrqStatus = irq_disable_save();
+
+	UART_RXDMACmd(UARTx, DISABLE);
+	GDMA_Abort(0, Ring->GdmaChnl);
+	GDMA_ClearINT(0, Ring->GdmaChnl);
+
+	Ring->Wr = Ring->ArmWr + (GDMA_GetDstAddr(0, Ring->GdmaChnl) - (u32)(Ring->Buf + Ring->ArmPos));
+	UART_RxRing_Overrun(Ring);
+	Start = Ring->Wr % Ring->Size;
+	Pos = Start;
+
+	/* only lines CPU writes to are refreshed, DMA data already reached memory */
+	DCache_Invalidate((u32)(Ring->Buf + Start), UART_RX_RING_BURST);
+	while (UART_Readable(UARTx)) {
+		if (Ring->Wr - Ring->Rd >= Ring->Size) {
+			UART_CharGet(UARTx, &Drop);
+			Ring->OverflowCnt++;
+			continue;
+		}
+		UART_CharGet(UARTx, Ring->Buf + Pos);
+		Ring->Wr++;
+		if (++Pos == Ring->Size) {
+			DCache_Clean((u32)(Ring->Buf + Start), Pos - Start);
+			DCache_Invalidate((u32)Ring->Buf, UART_RX_RING_BURST);
+			Pos = 0;
+			Start = 0;
+		}
+	}
+	if (Pos > Start) {
+		DCache_Clean((u32)(Ring->Buf + Start), Pos - Start);
+	}
+
+	UART_RxRing_Arm(Ring, Pos);
+	UART_RXDMACmd(UARTx, ENABLE);
+	Wr = Ring->Wr;
+
+	irq_enable_restore(PrevIrqStatus);
+
+	if (Ring->Callback != NULL) {
+		Ring->Callback(Ring->CbData, Wr);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Start continuous UART RX into a ring buffer by GDMA, with idle line detection.
+ * @param Ring Ring control block.
+ * @param UartIndex UART index, which can be 0~2. UART must be already initialized by UART_Init.
+ * @param Buf Ring buffer, cache line aligned.
+ * @param Size Ring size in bytes, multiple of cache line size.
+ * @param Callback Called from ISR when the line goes idle and when GDMA wraps, with the
+ * 		current write count. Bytes up to this count can be taken by UART_RxRingPeek.
+ * @param CbData Callback argument.
+ * @param IrqPriority UART interrupt priority, the ring owns the UART interrupt.
+ * @retval TRUE or FALSE.
+ */
+bool UART_RxRingInit(UART_RxRingTypeDef *Ring, u8 UartIndex, u8 *Buf, u32 Size,
+					 void (*Callback)(void *CbData, u32 Wr), void *CbData, u32 IrqPriority)
+{
+	UART_TypeDef *UARTx = UART_DEV_TABLE[UartIndex].UARTx;
+	GDMA_InitTypeDef *GDMA_InitStruct = &Ring->Gdma;
+
+	assert_param(UartIndex < MAX_UART_INDEX);
+	assert_param((Size >= 2 * UART_RX_RING_BURST) && (Size <= 4095));
+
+	_memset((void *)Ring, 0, sizeof(UART_RxRingTypeDef));
+	Ring->UartIndex = UartIndex;
+	Ring->Buf = Buf;
+	Ring->Size = Size;
+	Ring->Callback = Callback;
+	Ring->CbData = CbData;
+
+	Ring->GdmaChnl = GDMA_ChnlAlloc(0, (IRQ_FUN)UART_RxRing_DmaIrq, (u32)Ring, INT_PRI_MIDDLE);
+	if (Ring->GdmaChnl == 0xFF) {
+		/* No Available DMA channel */
+		return FALSE;
+	}
+
+	GDMA_InitStruct->GDMA_DIR = TTFCPeriToMem;
+	UARTx->MISCR &= (~RUART_BIT_RXDMA_OWNER);
+
+	GDMA_InitStruct->GDMA_SrcHandshakeInterface = UART_DEV_TABLE[UartIndex].Rx_HandshakeInterface;
+	GDMA_InitStruct->GDMA_SrcAddr = (u32)&UARTx->RBR_OR_UART_THR;
+	GDMA_InitStruct->GDMA_Index   = 0;
+	GDMA_InitStruct->GDMA_ChNum   = Ring->GdmaChnl;
+	GDMA_InitStruct->GDMA_IsrType = (BlockType | TransferType | ErrType);
+	GDMA_InitStruct->GDMA_SrcMsize = MsizeSixteen;
+	GDMA_InitStruct->GDMA_SrcDataWidth = TrWidthOneByte;
+	/* any ring offset can be the start of a block */
+	GDMA_InitStruct->GDMA_DstMsize = MsizeSixteen;
+	GDMA_InitStruct->GDMA_DstDataWidth = TrWidthOneByte;
+	GDMA_InitStruct->GDMA_DstInc = IncType;
+	GDMA_InitStruct->GDMA_SrcInc = NoChange;
+	GDMA_InitStruct->MaxMuliBlock = 1;
+
+	DCache_CleanInvalidate((u32)Buf, Size);
+
+	UART_RXDMAConfig(UARTx, UART_RX_RING_BURST);
+	UART_RxRing_Arm(Ring, 0);
+	UART_RXDMACmd(UARTx, ENABLE);
+
+	InterruptRegister((IRQ_FUN)UART_RxRing_UartIrq, UART_DEV_TABLE[UartIndex].IrqNum, (u32)Ring, IrqPriority);
+	InterruptEn(UART_DEV_TABLE[UartIndex].IrqNum, IrqPriority);
+	UART_INTConfig(UARTx, RUART_BIT_ETOI, ENABLE);
+
+	return TRUE;
+}
+
+/**
+ * @brief Stop UART RX ring and release its GDMA channel and UART interrupt.
+ * @param Ring Ring started by UART_RxRingInit.
+ * @return None
+ */
+void UART_RxRingDeInit(UART_RxRingTypeDef *Ring)
+{
+	UART_TypeDef *UARTx = UART_DEV_TABLE[Ring->UartIndex].UARTx;
+
+	UART_INTConfig(UARTx, RUART_BIT_ETOI, DISABLE);
+	InterruptDis(UART_DEV_TABLE[Ring->UartIndex].IrqNum);
+	InterruptUnRegister(UART_DEV_TABLE[Ring->UartIndex].IrqNum);
+
+	UART_RXDMACmd(UARTx, DISABLE);
+	GDMA_Abort(0, Ring->GdmaChnl);
+	GDMA_ClearINT(0, Ring->GdmaChnl);
+	GDMA_ChnlFree(0, Ring->GdmaChnl);
+}
+
+/**
+ * @brief Get the oldest unconsumed bytes of the ring without copying.
+ * @param Ring Ring started by UART_RxRingInit.
+ * @param ppData Returns the address of the first unconsumed byte.
+ * @return Number of contiguous bytes at *ppData, which stops at the ring end.
+ */
+u32 UART_RxRingPeek(UART_RxRingTypeDef *Ring, u8 **ppData)
+{
+	u32 Rd = Ring->Rd;
+	u32 Pos = Rd % Ring->Size;
+	u32 Len = Ring->Wr - Rd;
+
+	if (Len > Ring->Size - Pos) {
+		Len = Ring->Size - Pos;
+	}
+
+	*ppData = Ring->Buf + Pos;
+	if (Len) {
+		DCache_Invalidate((u32)*ppData, Len);
+	}
+
+	return Len;
+}
+
+/**
+ * @brief Mark bytes returned by UART_RxRingPeek as consumed.
+ * @param Ring Ring started by UART_RxRingInit.
+ * @param Len Number of bytes consumed.
+ * @note If OverflowCnt changed since UART_RxRingPeek, GDMA overwrote the oldest bytes and the
+ * 		ring already skipped them, the peeked data may be partly newer than expected.
+ * @return None
+ */
+void UART_RxRingConsume(UART_RxRingTypeDef *Ring, u32 Len)
+{
+	u32 PrevIrqStatus;
+
+	PrevIrqStatus = irq_disable_save();
+	Ring->Rd += MIN(Len, Ring->Wr - Ring->Rd);
+	irq_enable_restore(PrevIrqStatus);
+}
+
+/* TX queue: each chain is one GDMA multi-block transfer whose LLIs point at
+ * the caller's segments, so header, payload and trailer need no staging copy.
+ * The next chain is started from the transfer-complete ISR while the TX FIFO
+ * still holds the tail of the previous one, so the line does not go idle.
+ */
+static void UART_TxQueue_Start(UART_TxQueueTypeDef *Queue, UART_TxChainTypeDef *Chain)
+{
+	GDMA_InitTypeDef *GDMA_InitStruct = &Queue->Gdma;
+	UART_TypeDef *UARTx = UART_DEV_TABLE[Queue->UartIndex].UARTx;
+	struct GDMA_CH_LLI *Lli = Chain->Lli;
+	u32 i;
+
+	for (i = 0; i < Chain->IovNum; i++) {
+		assert_param((Chain->Iov[i].Len != 0) && (Chain->Iov[i].Len <= UART_TX_SEG_MAX));
+
+		Lli[i].LliEle.Sarx = (u32)Chain->Iov[i].Base;
+		Lli[i].LliEle.Darx = (u32)&UARTx->RBR_OR_UART_THR;
+		Lli[i].BlockSize = Chain->Iov[i].Len;
+		Lli[i].pNextLli = &Lli[(i + 1) % Chain->IovNum];
+		DCache_Clean((u32)Chain->Iov[i].Base, Chain->Iov[i].Len);
+	}
+
+	GDMA_InitStruct->GDMA_SrcAddr = (u32)Chain->Iov[0].Base;
+	GDMA_InitStruct->GDMA_BlockSize = Chain->Iov[0].Len;
+	GDMA_InitStruct->MaxMuliBlock = Chain->IovNum;
+	GDMA_InitStruct->GDMA_LlpSrcEn = (Chain->IovNum > 1) ? 1 : 0;
+	GDMA_InitStruct->GDMA_LlpDstEn = GDMA_InitStruct->GDMA_LlpSrcEn;
+
+	GDMA_Init(0, Queue->GdmaChnl, GDMA_InitStruct);
+	if (Chain->IovNum > 1) {
+		GDMA_SetLLP(0, Queue->GdmaChnl, Chain->IovNum, Lli, 0);
+	}
+	GDMA_Cmd(0, Queue->GdmaChnl, ENABLE);
+}
+
+static u32 UART_TxQueue_DmaIrq(void *Data)
+{
+	UART_TxQueueTypeDef *Queue = (UART_TxQueueTypeDef *)Data;
+	UART_TxChainTypeDef *Done;
+	u32 PrevIrqStatus;
+	u32 IsrType;
+
+	PrevIrqStatus = irq_disable_save();
+	IsrType = GDMA_ClearINT(0, Queue->GdmaChnl);
+	if ((Queue->Head == NULL) || ((IsrType & (TransferType | ErrType)) == 0)) {
+		irq_enable_restore(PrevIrqStatus);
+		return 0;
+	}
+
+	GDMA_Cmd(0, Queue->GdmaChnl, DISABLE);
+
+	Done = Queue->Head;
+	Queue->Head = Done->Next;
+	if (Queue->Head != NULL) {
+		UART_TxQueue_Start(Queue, Queue->Head);
+	} else {
+		Queue->Tail = NULL;
+	}
+	irq_enable_restore(PrevIrqStatus);
+
+	if (Done->Callback != NULL) {
+		Done->Callback(Done->CbData);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Initialize a UART TX chain queue.
+ * @param Queue Queue control block.
+ * @param UartIndex UART index, which can be 0~2. UART must be already initialized by UART_Init.
+ * @note The queue owns one GDMA channel and the UART TX DMA handshake until UART_TxQueueDeInit.
+ * @retval TRUE or FALSE.
+ */
+bool UART_TxQueueInit(UART_TxQueueTypeDef *Queue, u8 UartIndex)
+{
+	UART_TypeDef *UARTx = UART_DEV_TABLE[UartIndex].UARTx;
+	GDMA_InitTypeDef *GDMA_InitStruct = &Queue->Gdma;
+
+	assert_param(UartIndex < MAX_UART_INDEX);
+
+	_memset((void *)Queue, 0, sizeof(UART_TxQueueTypeDef));
+	Queue->UartIndex = UartIndex;
+
+	Queue->GdmaChnl = GDMA_ChnlAlloc(0, (IRQ_FUN)UART_TxQueue_DmaIrq, (u32)Queue, INT_PRI_MIDDLE);
+	if (Queue->GdmaChnl == 0xFF) {
+		/* No Available DMA channel */
+		return FALSE;
+	}
+
+	GDMA_InitStruct->GDMA_DIR     = TTFCMemToPeri;
+	GDMA_InitStruct->GDMA_DstHandshakeInterface = UART_DEV_TABLE[UartIndex].Tx_HandshakeInterface;
+	GDMA_InitStruct->GDMA_DstAddr = (u32)&UARTx->RBR_OR_UART_THR;
+	GDMA_InitStruct->GDMA_Index   = 0;
+	GDMA_InitStruct->GDMA_ChNum   = Queue->GdmaChnl;
+	GDMA_InitStruct->GDMA_IsrType = (TransferType | ErrType);
+
+	/* segments have any alignment and length, so move 1 byte each transfer */
+	GDMA_InitStruct->GDMA_DstMsize = MsizeFour;
+	GDMA_InitStruct->GDMA_DstDataWidth = TrWidthOneByte;
+	GDMA_InitStruct->GDMA_SrcMsize = MsizeFour;
+	GDMA_InitStruct->GDMA_SrcDataWidth = TrWidthOneByte;
+	GDMA_InitStruct->GDMA_DstInc = NoChange;
+	GDMA_InitStruct->GDMA_SrcInc = IncType;
+
+	UART_TXDMAConfig(UARTx, 4);
+	UART_TXDMACmd(UARTx, ENABLE);
+
+	return TRUE;
+}
+
+/**
+ * @brief Abort queued chains and release the GDMA channel of a UART TX chain queue.
+ * @param Queue Queue started by UART_TxQueueInit.
+ * @note Callbacks of aborted chains are not called.
+ * @return None
+ */
+void UART_TxQueueDeInit(UART_TxQueueTypeDef *Queue)
+{
+	u32 PrevIrqStatus;
+
+	PrevIrqStatus = irq_disable_save();
+	GDMA_Abort(0, Queue->GdmaChnl);
+	GDMA_ClearINT(0, Queue->GdmaChnl);
+	Queue->Head = NULL;
+	Queue->Tail = NULL;
+	irq_enable_restore(PrevIrqStatus);
+
+	UART_TXDMACmd(UART_DEV_TABLE[Queue->UartIndex].UARTx, DISABLE);
+	GDMA_ChnlFree(0, Queue->GdmaChnl);
+}
+
+/**
+ * @brief Queue a chain of segments to be sent back to back.
+ * @param Queue Queue started by UART_TxQueueInit.
+ * @param Chain Chain to send. Chain, its segment list, segment data and LLI storage
+ * 		belong to the driver until Chain->Callback is called.
+ * @note Can be called from task or ISR context.
+ * @return None
+ */
+void UART_TxQueueSubmit(UART_TxQueueTypeDef *Queue, UART_TxChainTypeDef *Chain)
+{
+	u32 PrevIrqStatus;
+
+	assert_param((Chain->IovNum != 0) && (Chain->Lli != NULL));
+
+	Chain->Next = NULL;
+
+	PrevIrqStatus = irq_disable_save();
+	if (Queue->Tail != NULL) {
+		Queue->Tail->Next = Chain;
+		Queue->Tail = Chain;
+	} else {
+		Queue->Head = Chain;
+		Queue->Tail = Chain;
+		UART_TxQueue_Start(Queue, Chain);
+	}
+	irq_enable_restore(PrevIrqStatus);
+}
+
+/**
+ * @brief Check whether a UART TX chain queue still has chains to move.
+ * @param Queue Queue started by UART_TxQueueInit.
+ * @note Idle queue means all data reached TX FIFO, use UART_Writable/LSR to wait for the line.
+ * @retval TRUE or FALSE.
+ */
+bool UART_TxQueueBusy(UART_TxQueueTypeDef *Queue)
+{
+	return (Queue->Head != NULL) ? TRUE : FALSE;
+}
+
 /**
   * @brief Configure uart monitor parameters.
   * @param BitNumThres Configure bit number threshold of one monitor period.
@@ -383,6 +809,140 @@ u32 UART_RxMonitorSatusGet(UART_TypeDef *UARTx)
 	return UARTx->MON_BAUD_STS;
 }
 
+static const u32 UART_AutoBaudTable[] = {
+	1200, 2400, 4800, 9600, 14400, 19200, 38400, 57600, 76800, 115200, 128000,
+	153600, 230400, 460800, 500000, 921600, 1000000, 1500000, 2000000, 3000000,
+	4000000, 6000000
+};
+
+static s32 UART_AutoBaud_Ppm(u32 Measured, u32 Nominal)
+{
+	return (s32)(((s64)Measured - (s64)Nominal) * 1000000 / (s64)Nominal);
+}
+
+static void UART_AutoBaud_Apply(UART_AutoBaudTypeDef *AutoBaud, u32 BaudRate)
+{
+	UART_SetBaud(AutoBaud->UARTx, BaudRate);
+	UART_LPRxBaudSet(AutoBaud->UARTx, BaudRate, AutoBaud->RxIPClockHz);
+	AutoBaud->Applied = BaudRate;
+}
+
+/**
+ * @brief Start baud rate detection on the Low Power Rx Path monitor.
+ * @param AutoBaud Auto baud control block.
+ * @param UARTx UART device, where x can be 0~2. UART must be already initialized by UART_Init.
+ * @param RxIPClockHz UART rx clock in Hz.
+ * @param InitBaud Baud rate the rx path starts from, the peer rate should be within a few percent of it
+ * 		or the sync pattern should be sent until UART_AutoBaudUpdate returns non-zero.
+ * @note The peer should send a sync pattern with dense edges (0x55) until lock.
+ * 		UART_AutoBaudUpdate should be called from the UART ISR when RUART_BIT_MONITOR_DONE_INT is set in LSR.
+ * @return None
+ */
+void UART_AutoBaudStart(UART_AutoBaudTypeDef *AutoBaud, UART_TypeDef *UARTx, u32 RxIPClockHz, u32 InitBaud)
+{
+	_memset((void *)AutoBaud, 0, sizeof(UART_AutoBaudTypeDef));
+	AutoBaud->UARTx = UARTx;
+	AutoBaud->RxIPClockHz = RxIPClockHz;
+
+	UART_RxMonitorCmd(UARTx, DISABLE);
+	UART_MonitorParaConfig(UARTx, UART_AUTOBAUD_BIT_THRES, ENABLE);
+	UART_LPRxBaudSet(UARTx, InitBaud, RxIPClockHz);
+	AutoBaud->Applied = InitBaud;
+
+	/* release the rx path reset done by UART_MonitorParaConfig */
+	UARTx->RX_PATH_CTRL |= RUART_BIT_R_RST_NEWRX_N;
+
+	UART_INTConfig(UARTx, RUART_BIT_EMDI, ENABLE);
+	UART_RxMonitorCmd(UARTx, ENABLE);
+}
+
+/**
+ * @brief Stop baud rate tracking. The last programmed baud rate is kept.
+ * @param AutoBaud Auto baud control block started by UART_AutoBaudStart.
+ * @return None
+ */
+void UART_AutoBaudStop(UART_AutoBaudTypeDef *AutoBaud)
+{
+	UART_INTConfig(AutoBaud->UARTx, RUART_BIT_EMDI, DISABLE);
+	UART_RxMonitorCmd(AutoBaud->UARTx, DISABLE);
+}
+
+/**
+ * @brief Process one monitor result: lock to the peer rate, then track its drift.
+ * @param AutoBaud Auto baud control block started by UART_AutoBaudStart.
+ * @note Before lock, the measured rate is snapped to the nearest standard rate within
+ * 		UART_AUTOBAUD_LOCK_TOL, or used as is. After lock, results are low pass filtered and
+ * 		the divisor is reprogrammed only when the filtered drift moves by UART_AUTOBAUD_RETUNE_PPM,
+ * 		so a slow oscillator drift does not turn into framing errors. UART_AUTOBAUD_RELOCK_CNT
+ * 		outliers in a row drop the lock.
+ * @return Baud rate programmed in this call, or 0 if nothing changed.
+ */
+u32 UART_AutoBaudUpdate(UART_AutoBaudTypeDef *AutoBaud)
+{
+	UART_TypeDef *UARTx = AutoBaud->UARTx;
+	u32 Status;
+	u32 Bits;
+	u32 Cycles;
+	u32 Measured;
+	u32 Nominal;
+	s32 Ppm;
+	u32 i;
+
+	/* read clears the monitor done interrupt */
+	Status = UART_RxMonitorSatusGet(UARTx);
+	if ((Status & RUART_BIT_RO_MON_RDY) == 0) {
+		return 0;
+	}
+
+	Bits = RUART_GET_RO_MON_TOTAL_BIT(Status);
+	Cycles = RUART_GET_RO_MON_TOTAL_CYCLE(UARTx->MON_CYC_NUM);
+	if ((Bits == 0) || (Cycles == 0)) {
+		return 0;
+	}
+	Measured = (u32)(((u64)AutoBaud->RxIPClockHz * Bits + Cycles / 2) / Cycles);
+
+	if (AutoBaud->BaudRate == 0) {
+		Nominal = Measured;
+		for (i = 0; i < sizeof(UART_AutoBaudTable) / sizeof(UART_AutoBaudTable[0]); i++) {
+			Ppm = UART_AutoBaud_Ppm(Measured, UART_AutoBaudTable[i]);
+			if ((Ppm > -UART_AUTOBAUD_LOCK_TOL) && (Ppm < UART_AUTOBAUD_LOCK_TOL)) {
+				Nominal = UART_AutoBaudTable[i];
+				break;
+			}
+		}
+
+		AutoBaud->BaudRate = Nominal;
+		AutoBaud->DriftPpm = UART_AutoBaud_Ppm(Measured, Nominal);
+		AutoBaud->RejectCnt = 0;
+		UART_AutoBaud_Apply(AutoBaud, Measured);
+
+		return Measured;
+	}
+
+	Ppm = UART_AutoBaud_Ppm(Measured, AutoBaud->BaudRate);
+	if ((Ppm <= -UART_AUTOBAUD_TRACK_TOL) || (Ppm >= UART_AUTOBAUD_TRACK_TOL)) {
+		if (++AutoBaud->RejectCnt >= UART_AUTOBAUD_RELOCK_CNT) {
+			AutoBaud->BaudRate = 0;
+		}
+		return 0;
+	}
+	AutoBaud->RejectCnt = 0;
+
+	/* first order low pass, 1/8 weight for the new sample */
+	AutoBaud->DriftPpm += (Ppm - AutoBaud->DriftPpm) / 8;
+
+	Ppm = UART_AutoBaud_Ppm(AutoBaud->Applied, AutoBaud->BaudRate);
+	Ppm = AutoBaud->DriftPpm - Ppm;
+	if ((Ppm <= -UART_AUTOBAUD_RETUNE_PPM) || (Ppm >= UART_AUTOBAUD_RETUNE_PPM)) {
+		Measured = (u32)((s64)AutoBaud->BaudRate + (s64)AutoBaud->BaudRate * AutoBaud->DriftPpm / 1000000);
+		UART_AutoBaud_Apply(AutoBaud, Measured);
+
+		return Measured;
+	}
+
+	return 0;
+}
+
 /**
  * @brief Fill each IrDA_InitStruct member with its default value.
  * @param IrDA_InitStruct Pointer to a IrDA_InitTypeDef structure which will be initialized.
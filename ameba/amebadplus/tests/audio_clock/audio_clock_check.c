@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Audio_Clock_SportNiMi against the ni search it replaced: for ni = 1..32767 take the first
+ * ni where clock * ni is a multiple of bclk, fail if mi < 2 * ni, take it if mi <= 65535 and
+ * go on otherwise. The search here is done in 64 bit, the old one wrapped at 32 bit.
+ *
+ * Found, ni and mi must match on every SPORT setup (all clocks, rates, channel lengths and
+ * counts), on every bclk up to BCLK_SWEEP_MAX for each clock, on random full range inputs
+ * including bclk overflow and zero, and on the ni/mi limits.
+ *
+ *   audio_clock_check	exit status is non-zero on any failure
+ */
+
+#include <stdlib.h>
+#include <time.h>
+#include "clock_model.h"
+
+#define BCLK_SWEEP_MAX	16384
+#define RANDOM_NUM		8192
+
+static u32 fail;
+
+#define CHECK(expr)	do { \
+		if (!(expr)) { \
+			printf("audio_clock: %s:%d check failed: %s\n", __FILE__, __LINE__, #expr); \
+			fail++; \
+		} \
+	} while (0)
+
+/* the ni search, with clock * ni and bclk in 64 bit */
+static bool ref_ni_mi(u32 clock, u32 sr, u32 chn_len, u32 chn_cnt, u32 *ni, u32 *mi)
+{
+	unsigned __int128 prod = (unsigned __int128)chn_cnt * chn_len * sr;
+	u64 bclk;
+	u64 step;
+	u64 rem = 0;
+	u64 m;
+	u32 n;
+
+	if (prod == 0) {
+		return 0;
+	}
+
+	/* any bclk above clock * 32767 has no multiple in the search, so it behaves the same
+	as UINT64_MAX */
+	bclk = (prod > UINT64_MAX) ? UINT64_MAX : (u64)prod;
+
+	/* clock * n % bclk, stepped instead of divided */
+	step = clock % bclk;
+	for (n = 1; n <= 32767; n++) {
+		rem += step;
+		if (rem >= bclk) {
+			rem -= bclk;
+		}
+		if (rem != 0) {
+			continue;
+		}
+		m = (u64)clock * n / bclk;
+		if (m < 2 * (u64)n) {
+			break;
+		}
+		if (m <= 65535) {
+			*ni = n;
+			*mi = (u32)m;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static u32 checked;
+static u32 found;
+
+static void check_one(u32 clock, u32 sr, u32 chn_len, u32 chn_cnt)
+{
+	u32 ni = 0, mi = 0;
+	u32 ref_ni = 0, ref_mi = 0;
+	bool ret = Audio_Clock_SportNiMi(clock, sr, chn_len, chn_cnt, &ni, &mi);
+	bool ref = ref_ni_mi(clock, sr, chn_len, chn_cnt, &ref_ni, &ref_mi);
+
+	checked++;
+	found += ref;
+
+	if ((ret != ref) || (ret && ((ni != ref_ni) || (mi != ref_mi)))) {
+		printf("audio_clock: clock %u sr %u len %u cnt %u: %u ni %u mi %u, search %u ni %u mi %u\n",
+			   clock, sr, chn_len, chn_cnt, ret, ni, mi, ref, ref_ni, ref_mi);
+		fail++;
+	}
+
+	CHECK(is_sport_ni_mi_supported(clock, sr, chn_len, chn_cnt) == ret);
+}
+
+static u32 rand32(void)
+{
+	static u32 x = 0x12345678;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+
+	return x;
+}
+
+int main(void)
+{
+	static const u32 clocks[] = {PLL_CLOCK_98P304M, PLL_CLOCK_45P1584M, I2S_CLOCK_XTAL40M};
+	static const u32 rates[] = {SP_8K, SP_11P025K, SP_12K, SP_16K, SP_22P05K, SP_24K, SP_32K,
+								SP_44P1K, SP_48K, SP_88P2K, SP_96K, SP_176P4K, SP_192K, SP_384K
+							   };
+	static const u32 chn_lens[] = {8, 16, 20, 24, 32};
+	/* bclk, clock, found, ni, mi around the ni <= 32767, mi <= 65535 and mi >= 2 * ni limits */
+	static const u32 limits[][5] = {
+		{1, 2, 1, 1, 2}, {1, 1, 0}, {3, 5, 0}, {3, 6, 1, 1, 2}, {2, 4, 1, 1, 2},
+		{1, 65535, 1, 1, 65535}, {1, 65536, 0}, {2, 65537, 0}, {65535, 65535, 0},
+		{32767, 65535, 1, 32767, 65535}, {32766, 65533, 1, 32766, 65533}, {32767, 65533, 0},
+		{32768, 65536, 1, 1, 2}, {32769, 65539, 0},
+	};
+	clock_t start = clock();
+	u32 c, r, l, n, i;
+	u32 ni, mi;
+
+	for (c = 0; c < sizeof(clocks) / sizeof(clocks[0]); c++) {
+		for (r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+			for (l = 0; l < sizeof(chn_lens) / sizeof(chn_lens[0]); l++) {
+				for (n = 1; n <= 8; n++) {
+					check_one(clocks[c], rates[r], chn_lens[l], n);
+				}
+			}
+		}
+	}
+	printf("audio_clock: %u SPORT setups, %u with a divider\n", checked, found);
+
+	checked = found = 0;
+	for (c = 0; c < sizeof(clocks) / sizeof(clocks[0]); c++) {
+		for (i = 1; i <= BCLK_SWEEP_MAX; i++) {
+			check_one(clocks[c], i, 1, 1);
+		}
+	}
+	printf("audio_clock: bclk 1..%u on each clock, %u with a divider\n", BCLK_SWEEP_MAX, found);
+
+	checked = found = 0;
+	for (i = 0; i < RANDOM_NUM; i++) {
+		/* full range, then feasible bclk on any clock, then standard clocks */
+		check_one(rand32(), rand32(), rand32(), rand32());
+		check_one(rand32(), rand32() % 400000, rand32() % 33, rand32() % 17);
+		check_one(clocks[i % 3], rand32() % 400000, rand32() % 33, rand32() % 17);
+	}
+	printf("audio_clock: %u random inputs, %u with a divider\n", checked, found);
+
+	/* no bclk, bclk above 32 bit, no clock */
+	check_one(PLL_CLOCK_98P304M, 0, 32, 2);
+	check_one(PLL_CLOCK_98P304M, SP_48K, 0, 2);
+	check_one(PLL_CLOCK_98P304M, SP_48K, 32, 0);
+	check_one(PLL_CLOCK_98P304M, 0xFFFFFFFF, 1, 1);
+	check_one(PLL_CLOCK_98P304M, 0x80000000, 2, 1);
+	check_one(PLL_CLOCK_98P304M, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF);
+	check_one(0, SP_48K, 32, 2);
+	CHECK(!Audio_Clock_SportNiMi(PLL_CLOCK_98P304M, 0x80000000, 2, 1, NULL, NULL));
+
+	for (i = 0; i < sizeof(limits) / sizeof(limits[0]); i++) {
+		ni = mi = 0;
+		CHECK(Audio_Clock_SportNiMi(limits[i][1], limits[i][0], 1, 1, &ni, &mi) == limits[i][2]);
+		CHECK(!limits[i][2] || ((ni == limits[i][3]) && (mi == limits[i][4])));
+		check_one(limits[i][1], limits[i][0], 1, 1);
+	}
+
+	/* 48k stereo 32 bit on 98.304M: bclk 3.072M, 98.304M / 3.072M = 32 */
+	CHECK(Audio_Clock_SportNiMi(PLL_CLOCK_98P304M, SP_48K, 32, 2, &ni, &mi) && ni == 1 && mi == 32);
+	/* 44.1k stereo 16 bit on 40M: bclk 1.4112M = 40M * 441 / 12500 */
+	CHECK(Audio_Clock_SportNiMi(I2S_CLOCK_XTAL40M, SP_44P1K, 16, 2, &ni, &mi) && ni == 441 && mi == 12500);
+	/* 44.1k stereo 16 bit on 98.304M: gcd 9600 */
+	CHECK(Audio_Clock_SportNiMi(PLL_CLOCK_98P304M, SP_44P1K, 16, 2, &ni, &mi) && ni == 147 && mi == 10240);
+	/* 384k 8 channels 32 bit on 45.1584M: bclk 98.304M above the clock */
+	CHECK(!Audio_Clock_SportNiMi(PLL_CLOCK_45P1584M, SP_384K, 32, 8, NULL, NULL));
+
+	printf("audio_clock: %.2f s\n", (double)(clock() - start) / CLOCKS_PER_SEC);
+
+	if (fail) {
+		printf("audio_clock: FAIL (%u)\n", fail);
+		return 1;
+	}
+
+	printf("audio_clock: Audio_Clock_SportNiMi matches the ni search\n");
+	return 0;
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Closed loop of Audio_Clock_DriftUpdate on the SPORT and PLL of clock_model.c: the SPORT
+ * runs hw_ppm off, its 27 bit down counter wraps during the run, the reference is a 1MHz
+ * timestamp that wraps too and is taken up to REF_JITTER_US before the counter latch.
+ * One update per 10ms DMA period.
+ *
+ * Into the run go a 50ms SPORT stall, a counter restart, 3s without updates and a step of
+ * the clock error. The stall and the restart must be dropped as outliers, everything else
+ * must be tracked: the frames the SPORT is ahead of the reference stay within OFFSET_MAX
+ * once settled and within OFFSET_STEP_MAX over the step, the SPORT rate averages out to
+ * nominal and the trim stays within AUDIO_DRIFT_TRIM_MAX_PPM. On the XTAL clock only
+ * ResamplePpm follows hw_ppm.
+ *
+ *   audio_drift_check	exit status is non-zero on any failure
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include "clock_model.h"
+
+#define PERIOD_SEC		0.01
+#define SIM_SEC			400.0
+#define SETTLE_SEC		60.0
+#define REF_START		0xFFF00000U		/* wraps after a second */
+#define REF_JITTER_US	10
+
+/* events, in seconds */
+#define STALL_AT		100.0
+#define STALL_SEC		0.05
+#define RESTART_AT		150.0
+#define RESTART_FRAMES	100000
+#define SKIP_AT			200.0
+#define SKIP_SEC		3.0
+#define STEP_AT			250.0
+
+/* settled: the counter resolves a frame, plus the reference jitter and the trim steps */
+#define OFFSET_MAX(sr)		(2 + (sr) * 40e-6)
+/* over the step: the rate estimate needs a few windows to follow */
+#define OFFSET_STEP_MAX(sr)	((sr) * 2e-3)
+
+static u32 fail;
+
+#define CHECK(expr)	do { \
+		if (!(expr)) { \
+			printf("audio_drift: %s:%d check failed: %s\n", __FILE__, __LINE__, #expr); \
+			fail++; \
+		} \
+	} while (0)
+
+struct drift_case {
+	const char *name;
+	u32 clock;
+	u32 sr;
+	u32 dir;
+	double hw_ppm;
+	double step_ppm;		/* hw_ppm after STEP_AT */
+};
+
+static u32 rand32(void)
+{
+	static u32 x = 0x2545F491;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+
+	return x;
+}
+
+static void drift_run(const struct drift_case *dc)
+{
+	AUDIO_DriftTypeDef drift;
+	bool trimmable = (dc->clock != I2S_CLOCK_XTAL40M);
+	/* the counter wraps 30s into the run */
+	u32 cnt_start = dc->sr * 30;
+	double offset = 0;			/* frames ahead of the reference, stall and restart left out */
+	double offset_max = 0;
+	double step_max = 0;
+	double rate_sum = 0;		/* SPORT ppm over the last SETTLE_SEC */
+	u32 rate_num = 0;
+	double t = 0;
+	double ret = 0;
+	u32 ref;
+	u32 jitter;
+
+	model_sport_init(dc->clock, dc->sr, dc->hw_ppm, cnt_start);
+	Audio_Clock_DriftInit(&drift, 0, dc->dir, dc->clock, dc->sr, 1000000);
+	CHECK(model_sport.enabled);
+
+	while (t < SIM_SEC) {
+		if (t >= STEP_AT && model_sport.hw_ppm != dc->step_ppm) {
+			model_sport.hw_ppm = dc->step_ppm;
+		}
+
+		model_sport.stalled = (t >= STALL_AT && t < STALL_AT + STALL_SEC);
+		if (!model_sport.stalled) {
+			offset += PERIOD_SEC * dc->sr * model_sport_ppm() / 1e6;
+		}
+		model_sport_run(PERIOD_SEC);
+		t += PERIOD_SEC;
+		if (t >= SIM_SEC - SETTLE_SEC) {
+			rate_sum += model_sport_ppm();
+			rate_num++;
+		}
+
+		if (t >= RESTART_AT && model_sport.cnt_jump == 0) {
+			model_sport.cnt_jump = RESTART_FRAMES;
+		}
+		if (t >= SKIP_AT && t < SKIP_AT + SKIP_SEC) {
+			continue;
+		}
+
+		jitter = rand32() % (REF_JITTER_US + 1);
+		ref = REF_START + (u32)llround(t * 1e6) - jitter;
+		ret = Audio_Clock_DriftUpdate(&drift, ref);
+
+		CHECK(fabsf(drift.TrimPpm) <= AUDIO_DRIFT_TRIM_MAX_PPM + 1);
+		if (trimmable) {
+			CHECK(ret == drift.TrimPpm);
+			/* what the PLL runs at, not what was asked */
+			CHECK(drift.TrimPpm == (float)model_pll.trim_ppm);
+		} else {
+			CHECK(ret == drift.ResamplePpm);
+		}
+
+		if (t >= SETTLE_SEC && (t < STEP_AT || t >= STEP_AT + SETTLE_SEC)) {
+			offset_max = fmax(offset_max, fabs(offset));
+		} else if (t >= STEP_AT) {
+			step_max = fmax(step_max, fabs(offset));
+		}
+	}
+
+	printf("audio_drift: %-18s %6.1f -> %6.1f ppm | est %7.2f trim %7.2f resample %7.2f | rate %5.2f ppm, offset %5.2f, step %5.1f frames | %u rejected, %u PLL writes\n",
+		   dc->name, dc->hw_ppm, dc->step_ppm, drift.HwPpm, drift.TrimPpm, drift.ResamplePpm,
+		   rate_sum / rate_num, offset_max, step_max, drift.RejectCnt, model_pll.write_cnt);
+
+	/* the stall and the restart, and nothing else */
+	CHECK(drift.RejectCnt == 2);
+	CHECK(model_sport.read_unlatched == 0);
+	/* one frame in a window is 10ppm at 48k, filtered by 1/8 */
+	CHECK(fabs(drift.HwPpm - dc->step_ppm) < 3);
+
+	if (trimmable) {
+		CHECK(model_pll.other_pll == 0);
+		CHECK(fabs(rate_sum / rate_num) < 1);
+		CHECK(offset_max <= OFFSET_MAX(dc->sr));
+		CHECK(step_max <= OFFSET_STEP_MAX(dc->sr));
+		CHECK(drift.ResamplePpm == 0);
+	} else {
+		/* the SPORT keeps its rate, the stream is stretched for TX and shrunk for RX */
+		CHECK(model_pll.write_cnt == 0);
+		CHECK(fabs(drift.ResamplePpm - (dc->dir == SP_DIR_TX ? 1 : -1) * dc->step_ppm) < 3);
+	}
+
+	Audio_Clock_DriftDeInit(&drift);
+	CHECK(!model_sport.enabled);
+	CHECK(model_pll.f0f == model_pll.f0f_base);
+	CHECK(drift.TrimPpm == 0 && drift.ResamplePpm == 0 && drift.Started == 0);
+}
+
+/* a clock beyond the trim range: the trim holds at the limit */
+static void drift_clamp(void)
+{
+	AUDIO_DriftTypeDef drift;
+	u32 n;
+
+	model_sport_init(PLL_CLOCK_98P304M, SP_48K, 350, 1000);
+	Audio_Clock_DriftInit(&drift, 0, SP_DIR_TX, PLL_CLOCK_98P304M, SP_48K, 1000000);
+	for (n = 1; n <= 6000; n++) {
+		model_sport_run(PERIOD_SEC);
+		Audio_Clock_DriftUpdate(&drift, REF_START + n * 10000);
+	}
+	printf("audio_drift: 350 ppm on 98.304M, trim %.2f ppm, F0F %u\n", drift.TrimPpm, model_pll.f0f);
+	CHECK(drift.TrimPpm < -AUDIO_DRIFT_TRIM_MAX_PPM + 1 && drift.TrimPpm >= -AUDIO_DRIFT_TRIM_MAX_PPM - 1);
+	CHECK(drift.RejectCnt == 0);
+}
+
+int main(void)
+{
+	static const struct drift_case cases[] = {
+		{"48k on 98.304M",    PLL_CLOCK_98P304M,  SP_48K,    SP_DIR_TX,  120, -60},
+		{"96k RX on 98.304M", PLL_CLOCK_98P304M,  SP_96K,    SP_DIR_RX,  -40, 150},
+		{"44.1k on 45.1584M", PLL_CLOCK_45P1584M, SP_44P1K,  SP_DIR_TX,  -90,  30},
+		{"16k on 98.304M",    PLL_CLOCK_98P304M,  SP_16K,    SP_DIR_RX,    0, 100},
+		{"48k on XTAL40M",    I2S_CLOCK_XTAL40M,  SP_48K,    SP_DIR_TX,   80, -20},
+		{"48k RX on XTAL40M", I2S_CLOCK_XTAL40M,  SP_48K,    SP_DIR_RX,   80, -20},
+	};
+	u32 i;
+
+	for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		drift_run(&cases[i]);
+	}
+	drift_clamp();
+
+	if (fail) {
+		printf("audio_drift: FAIL (%u)\n", fail);
+		return 1;
+	}
+
+	printf("audio_drift: offset bounded through wraps, outliers and a clock step\n");
+	return 0;
+}
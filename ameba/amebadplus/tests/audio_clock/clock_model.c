@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host model of what ameba_audio_clock.c touches besides its own arithmetic: the 27 bit
+ * SPORT frame counter, which counts down and wraps, and the F0F trim of the I2S PLL,
+ * which moves the SPORT rate in steps of ~0.9ppm the way ameba_pll.c writes it.
+ */
+
+#include <assert.h>
+#include <math.h>
+#include "clock_model.h"
+
+int model_log_level = RTK_LOG_NONE;
+
+struct model_sport model_sport;
+struct model_pll model_pll;
+
+static u32 model_sport_clock;
+
+void model_sport_init(u32 clock, u32 sr, double hw_ppm, u32 cnt_start)
+{
+	memset(&model_sport, 0, sizeof(model_sport));
+	memset(&model_pll, 0, sizeof(model_pll));
+	model_sport_clock = clock;
+	model_sport.sr = sr;
+	model_sport.hw_ppm = hw_ppm;
+	model_sport.cnt_start = cnt_start;
+}
+
+double model_sport_ppm(void)
+{
+	double trim = (model_pll.clock == model_sport_clock) ? model_pll.trim_ppm : 0;
+
+	return ((1 + model_sport.hw_ppm / 1e6) * (1 + trim / 1e6) - 1) * 1e6;
+}
+
+void model_sport_run(double sec)
+{
+	if (!model_sport.stalled) {
+		model_sport.frames += sec * model_sport.sr * (1 + model_sport_ppm() / 1e6);
+	}
+}
+
+static u32 model_sport_count(void)
+{
+	return (model_sport.cnt_start - (u32)floor(model_sport.frames) - model_sport.cnt_jump) & (SP_MASK_TX_SPORT_COUNTER >> 5);
+}
+
+void AUDIO_SP_SetTXCounter(u32 index, u32 comp_val)
+{
+	(void)index;
+	model_sport.enabled = comp_val;
+}
+
+void AUDIO_SP_SetRXCounter(u32 index, u32 comp_val)
+{
+	(void)index;
+	model_sport.enabled = comp_val;
+}
+
+void AUDIO_SP_SetPhaseLatch(u32 index)
+{
+	(void)index;
+	model_sport.latched = model_sport_count();
+	model_sport.latch_cnt++;
+}
+
+static u32 model_sport_read(void)
+{
+	assert(model_sport.enabled);
+	if (model_sport.latch_cnt == 0) {
+		model_sport.read_unlatched++;
+	}
+	model_sport.latch_cnt = 0;
+
+	return model_sport.latched;
+}
+
+u32 AUDIO_SP_GetTXCounterVal(u32 index)
+{
+	(void)index;
+	return model_sport_read();
+}
+
+u32 AUDIO_SP_GetRXCounterVal(u32 index)
+{
+	(void)index;
+	return model_sport_read();
+}
+
+static float model_pll_tune(u32 clock, double step, u32 f0f_base, float ppm, u32 action)
+{
+	if (clock != model_sport_clock) {
+		model_pll.other_pll++;
+	}
+
+	model_pll.clock = clock;
+	model_pll.f0f_base = f0f_base;
+	model_pll.write_cnt++;
+
+	if (action == PLL_FASTER) {
+		model_pll.f0f = f0f_base + (u32)((double)ppm / step + 0.5);
+	} else if (action == PLL_SLOWER) {
+		model_pll.f0f = f0f_base - (u32)((double)ppm / step + 0.5);
+	} else {
+		model_pll.f0f = f0f_base;
+	}
+	assert(model_pll.f0f <= MODEL_F0F_MAX);
+
+	model_pll.trim_ppm = ((double)model_pll.f0f - f0f_base) * step;
+
+	return (float)model_pll.trim_ppm;
+}
+
+float PLL_I2S_98P304M_ClkTune(u32 pll_sel, float ppm, u32 action)
+{
+	(void)pll_sel;
+	return model_pll_tune(PLL_CLOCK_98P304M, MODEL_F0F_STEP_98P304M, 5125, ppm, action);
+}
+
+float PLL_I2S_45P158M_ClkTune(u32 pll_sel, float ppm, u32 action)
+{
+	(void)pll_sel;
+	return model_pll_tune(PLL_CLOCK_45P1584M, MODEL_F0F_STEP_45P158M, 3893, ppm, action);
+}
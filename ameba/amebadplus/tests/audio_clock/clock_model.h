@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _CLOCK_MODEL_H_
+#define _CLOCK_MODEL_H_
+
+#include "ameba_soc.h"
+#include "ameba_audio_clock.h"
+
+/* F0F steps of the I2S PLLs, as in ameba_pll.c */
+#define MODEL_F0F_STEP_98P304M	0.886973813872093
+#define MODEL_F0F_STEP_45P158M	0.901052699869257
+#define MODEL_F0F_MAX			8191
+
+struct model_sport {
+	u32 sr;					/* nominal frame rate */
+	double hw_ppm;			/* rate error of the untrimmed clock */
+	double frames;			/* frames clocked out since model_sport_init */
+	u32 cnt_start;			/* down counter at frames 0 */
+	s32 cnt_jump;			/* counter moved by restarts, not by frames */
+	u32 enabled;			/* counter enabled by AUDIO_SP_Set{TX,RX}Counter */
+	u32 latched;			/* value of the last AUDIO_SP_SetPhaseLatch */
+	u32 latch_cnt;
+	u32 read_unlatched;		/* reads without a latch before them */
+	u32 stalled;			/* no frames are clocked while set */
+};
+
+struct model_pll {
+	u32 clock;				/* PLL the trim was last written to, 0 if none */
+	u32 f0f;				/* F0F register */
+	u32 f0f_base;
+	double trim_ppm;		/* trim in effect */
+	u32 write_cnt;
+	u32 other_pll;			/* writes to the PLL the SPORT does not run from */
+};
+
+extern struct model_sport model_sport;
+extern struct model_pll model_pll;
+
+/* SPORT at sr from the given clock, hw_ppm off, with its down counter at cnt_start */
+void model_sport_init(u32 clock, u32 sr, double hw_ppm, u32 cnt_start);
+
+/* clock the SPORT for sec seconds at its current rate */
+void model_sport_run(double sec);
+
+/* rate of the SPORT now, in ppm of sr */
+double model_sport_ppm(void);
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host stand-in for ameba_soc.h, just what ameba_audio_clock.c needs. The SPORT counter
+ * and PLL trim functions it calls are modeled in clock_model.c.
+ */
+
+#ifndef _AMEBA_SOC_H_
+#define _AMEBA_SOC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+
+#define __IO			volatile
+#define __I			volatile const
+#define __O			volatile
+#define _LONG_CALL_
+#define ALIGNMTO(x)		__attribute__((aligned(x)))
+#define BIT(x)			(1UL << (x))
+#define TRUE			1
+#define FALSE			0
+#define ENABLE			1
+#define DISABLE			0
+#define MIN(x, y)		(((x) < (y)) ? (x) : (y))
+#define MAX(x, y)		(((x) > (y)) ? (x) : (y))
+
+#define assert_param(expr)	((void)0)
+#define _memset			memset
+
+typedef u32(*IRQ_FUN)(void *Data);
+
+enum {
+	RTK_LOG_NONE = 0,
+	RTK_LOG_ERROR,
+	RTK_LOG_WARN,
+	RTK_LOG_INFO,
+	RTK_LOG_DEBUG,
+};
+extern int model_log_level;
+#define RTK_LOGS(tag, level, fmt, ...)	do { \
+		if ((level) <= model_log_level) { \
+			fprintf(stderr, "[%s] " fmt, tag, ##__VA_ARGS__); \
+		} \
+	} while (0)
+#define RTK_LOGE(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_ERROR, fmt, ##__VA_ARGS__)
+#define RTK_LOGW(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_WARN, fmt, ##__VA_ARGS__)
+#define RTK_LOGI(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_INFO, fmt, ##__VA_ARGS__)
+
+/* PLL_ClkTune_definitions of ameba_clk.h, the rest of it is not needed */
+#define PLL_I2S		0
+#define PLL_AUTO		0
+#define PLL_FASTER		1
+#define PLL_SLOWER		2
+float PLL_I2S_98P304M_ClkTune(u32 pll_sel, float ppm, u32 action);
+float PLL_I2S_45P158M_ClkTune(u32 pll_sel, float ppm, u32 action);
+
+#include "ameba_gdma.h"
+#include "ameba_sport.h"
+
+#endif
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * KM4 cycles/period of AUDIO_DMIC_VADProcess, counted by DWT->CYCCNT.
+ * Add this file to an application built with CONFIG_I2S_AMEBA and call
+ * audio_dmic_bench() from a task, the period is in SRAM and warm in D-Cache.
+ */
+
+#include "ameba_soc.h"
+#include "ameba_audio_dmic.h"
+
+static const char *const TAG = "DMIC";
+
+#define BENCH_CHN_CNT	2
+
+static s16 bench_pcm[512 * BENCH_CHN_CNT] __attribute__((aligned(32)));
+
+void audio_dmic_bench(void)
+{
+	static const u32 frames[] = {160, 256, 320, 512};
+	AUDIO_DMIC_VADTypeDef vad;
+	AUDIO_DMIC_VADParams params;
+	u32 start, cycles, loop;
+	u32 i;
+
+	for (i = 0; i < sizeof(bench_pcm) / sizeof(bench_pcm[0]); i++) {
+		bench_pcm[i] = (s16)(_rand() >> 20);
+	}
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	AUDIO_DMIC_VADStructInit(&params);
+	for (i = 0; i < sizeof(frames) / sizeof(frames[0]); i++) {
+		AUDIO_DMIC_VADInit(&vad, &params, BENCH_CHN_CNT, frames[i]);
+
+		/* the second run is reported, the first one warms the caches */
+		for (loop = 0; loop < 2; loop++) {
+			start = DWT->CYCCNT;
+			AUDIO_DMIC_VADProcess(&vad, bench_pcm);
+			cycles = DWT->CYCCNT - start;
+		}
+		RTK_LOGI(TAG, "VADProcess %d frames x %d ch: %d cycles/period, %d.%02d cycles/frame\n", frames[i],
+				 BENCH_CHN_CNT, cycles, cycles / frames[i], (cycles % frames[i]) * 100 / frames[i]);
+	}
+}
@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Feeds a synthetic capture through AUDIO_DMIC_CaptureInit and the VAD, period by period
+ * as the SPORT GDMA ring delivers it: a low noise floor, a loud hiss burst that must not
+ * start speech, then a fricative followed by a voiced syllable train and noise again.
+ * Reports the onset and end latency and checks that the pre-roll brings back the
+ * fricative, that speech is delivered once, in order and intact, and that pre-roll periods
+ * GDMA comes round to while the callback runs are dropped, not delivered overwritten.
+ * With "bench" it also prints the host time of AUDIO_DMIC_VADProcess per period, see
+ * audio_dmic_bench.c for cycles on target.
+ *
+ *   audio_dmic_check [bench]	exit status is non-zero on any failure
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "ameba_soc.h"
+#include "ameba_audio_dmic.h"
+
+/* 16 kHz, 16ms periods, two channels of which channel 0 is analysed */
+#define RATE		16000
+#define CHN_CNT		2
+#define FRAMES		256
+#define PERIOD_MS	(FRAMES * 1000 / RATE)
+#define PERIOD_BYTES	(FRAMES * CHN_CNT * sizeof(s16))
+#define PERIOD_NUM	7
+
+/* timeline in periods */
+#define HISS_START	63
+#define HISS_END	94
+#define ONSET		125		/* fricative */
+#define VOICED		128		/* syllables */
+#define VOICED_END	203
+#define TOTAL		270
+
+static u32 fail;
+
+#define CHECK(expr)	do { \
+		if (!(expr)) { \
+			printf("audio_dmic: %s:%d check failed: %s\n", __FILE__, __LINE__, #expr); \
+			fail++; \
+		} \
+	} while (0)
+
+static s16 gen[TOTAL][FRAMES * CHN_CNT];
+static u8 ring[PERIOD_NUM * PERIOD_BYTES] __attribute__((aligned(32)));
+static struct GDMA_CH_LLI lli[PERIOD_NUM];
+static u32 seed = 1;
+
+static s32 check_noise(s32 rms)
+{
+	/* sum of 4 uniforms, close enough to gaussian */
+	s32 sum = 0;
+	u32 i;
+
+	for (i = 0; i < 4; i++) {
+		seed = seed * 1664525 + 1013904223;
+		sum += (s32)(seed >> 16) - 32768;
+	}
+
+	return (s32)((int64_t)sum * rms / 37837);
+}
+
+static s16 check_sat(s32 x)
+{
+	return (s16)((x > 32767) ? 32767 : ((x < -32768) ? -32768 : x));
+}
+
+static void check_gen(void)
+{
+	double lp = 0, phase = 0;
+	u32 p, i;
+	s32 x;
+
+	for (p = 0; p < TOTAL; p++) {
+		for (i = 0; i < FRAMES; i++) {
+			u32 n = p * FRAMES + i;
+
+			x = check_noise(20);
+			if ((p >= HISS_START && p < HISS_END) || (p >= ONSET && p < VOICED)) {
+				/* white noise, half the samples cross zero */
+				x += check_noise(400);
+			} else if (p >= VOICED && p < VOICED_END) {
+				/* 125 Hz glottal pulses through a low pass, 4 Hz syllables */
+				phase += 125.0 / RATE;
+				if (phase >= 1.0) {
+					phase -= 1.0;
+					lp += 12000;
+				}
+				lp *= 0.97;
+				x += (s32)((lp - 2000) * (0.6 + 0.4 * sin(2 * M_PI * 4 * n / RATE)));
+			}
+			gen[p][i * CHN_CNT] = check_sat(x);
+			/* channel 1 is never analysed, a loud tone there changes nothing */
+			gen[p][i * CHN_CNT + 1] = (s16)(20000 * sin(2 * M_PI * 3000.0 * n / RATE));
+		}
+	}
+}
+
+/* Codec and SPORT stream model ---------------------------------------------*/
+
+static AUDIO_SP_StreamTypeDef *model_stream;
+
+void AUDIO_CODEC_Record(u32 i2s_sel, u32 type, I2S_InitTypeDef *I2S_InitStruct)
+{
+	(void)i2s_sel;
+	(void)type;
+	(void)I2S_InitStruct;
+}
+
+void AUDIO_CODEC_SetDmicClk(u32 clk, u32 newstate)
+{
+	(void)clk;
+	(void)newstate;
+}
+
+void AUDIO_CODEC_SetADCHPF(u32 adc_sel, u32 fc, u32 NewState)
+{
+	(void)adc_sel;
+	(void)fc;
+	(void)NewState;
+}
+
+void AUDIO_CODEC_SetADCZDET(u32 adc_sel, u32 type)
+{
+	(void)adc_sel;
+	(void)type;
+}
+
+void AUDIO_SP_DmaCmd(u32 index, u32 NewState)
+{
+	(void)index;
+	(void)NewState;
+}
+
+void AUDIO_SP_RXStart(u32 index, u32 NewState)
+{
+	(void)index;
+	(void)NewState;
+}
+
+bool AUDIO_SP_StreamInit(AUDIO_SP_StreamTypeDef *Stream, u32 Index, u32 Direction, u32 SelGDMA, u8 *Buf,
+						 u32 PeriodBytes, u32 PeriodNum, struct GDMA_CH_LLI *Lli, AUDIO_SP_STREAM_CB Callback,
+						 void *CbData)
+{
+	(void)SelGDMA;
+
+	memset((void *)Stream, 0, sizeof(AUDIO_SP_StreamTypeDef));
+	Stream->Index = Index;
+	Stream->Direction = Direction;
+	Stream->Buf = Buf;
+	Stream->PeriodBytes = PeriodBytes;
+	Stream->PeriodNum = PeriodNum;
+	Stream->Lli = Lli;
+	Stream->Callback = Callback;
+	Stream->CbData = CbData;
+	memset(Buf, 0, PeriodBytes * PeriodNum);
+	model_stream = Stream;
+
+	return TRUE;
+}
+
+void AUDIO_SP_StreamDeInit(AUDIO_SP_StreamTypeDef *Stream)
+{
+	(void)Stream;
+	model_stream = NULL;
+}
+
+/* RX side of ameba_sport.c, without the overrun skip, the check never falls behind */
+u8 *AUDIO_SP_StreamGetPeriod(AUDIO_SP_StreamTypeDef *Stream)
+{
+	if (Stream->HwCnt == Stream->SwCnt) {
+		return NULL;
+	}
+
+	return Stream->Buf + (Stream->SwCnt % Stream->PeriodNum) * Stream->PeriodBytes;
+}
+
+void AUDIO_SP_StreamCommit(AUDIO_SP_StreamTypeDef *Stream)
+{
+	Stream->SwCnt++;
+}
+
+/* GDMA: the period in progress is half written, the finished ones are whole */
+static u32 gdma_cnt;
+
+static void gdma_advance(void)
+{
+	AUDIO_SP_StreamTypeDef *Stream = model_stream;
+	u8 *slot;
+
+	slot = Stream->Buf + (gdma_cnt % PERIOD_NUM) * PERIOD_BYTES;
+	memcpy(slot, gen[gdma_cnt], PERIOD_BYTES);
+	gdma_cnt++;
+	Stream->HwCnt = gdma_cnt;
+
+	if (gdma_cnt < TOTAL) {
+		slot = Stream->Buf + (gdma_cnt % PERIOD_NUM) * PERIOD_BYTES;
+		memcpy(slot, gen[gdma_cnt], PERIOD_BYTES / 2);
+	}
+}
+
+/* one GDMA block interrupt, like AUDIO_SP_Stream_Irq */
+static void gdma_irq(void)
+{
+	AUDIO_SP_StreamTypeDef *Stream = model_stream;
+
+	gdma_advance();
+	Stream->Callback(Stream->CbData, Stream->HwCnt);
+}
+
+/* Application ---------------------------------------------------------------*/
+
+static struct {
+	u32 start_cnt;
+	u32 end_cnt;
+	u32 start_at;			/* period analysed when START came */
+	u32 end_at;
+	u32 delivered[TOTAL];	/* generated period index of each delivered one */
+	u32 delivered_num;
+	u32 corrupt;
+	u32 stall;				/* GDMA periods to finish during the first pre-roll callback */
+} app;
+
+static u32 check_find(const s16 *pcm)
+{
+	u32 p;
+
+	for (p = 0; p < TOTAL; p++) {
+		if (memcmp(pcm, gen[p], PERIOD_BYTES) == 0) {
+			return p;
+		}
+	}
+
+	return TOTAL;
+}
+
+static void check_cb(void *CbData, u32 Event, s16 *Pcm, u32 Frames)
+{
+	AUDIO_DMIC_CaptureTypeDef *Capture = (AUDIO_DMIC_CaptureTypeDef *)CbData;
+	u32 p;
+
+	if (Event == AUDIO_DMIC_VAD_START) {
+		app.start_cnt++;
+		app.start_at = Capture->PeriodCnt;
+		return;
+	}
+	if (Event == AUDIO_DMIC_VAD_END) {
+		app.end_cnt++;
+		app.end_at = Capture->PeriodCnt;
+		return;
+	}
+
+	CHECK(Frames == FRAMES);
+	p = check_find(Pcm);
+	if (p == TOTAL) {
+		app.corrupt++;
+		return;
+	}
+	app.delivered[app.delivered_num++] = p;
+
+	/* a slow consumer, GDMA goes on under the pre-roll */
+	while (app.stall) {
+		app.stall--;
+		gdma_advance();
+	}
+}
+
+static void check_run(u32 stall)
+{
+	static AUDIO_DMIC_CaptureTypeDef capture;
+	AUDIO_DMIC_VADParams params;
+	u32 i;
+
+	memset(&app, 0, sizeof(app));
+	app.stall = stall;
+	gdma_cnt = 0;
+
+	AUDIO_DMIC_VADStructInit(&params);
+	CHECK(AUDIO_DMIC_CaptureInit(&capture, 0, 0, CHN_CNT, ring, PERIOD_BYTES, PERIOD_NUM, lli, &params,
+								 check_cb, &capture) == TRUE);
+
+	while (gdma_cnt < TOTAL) {
+		gdma_irq();
+	}
+	AUDIO_DMIC_CaptureDeInit(&capture);
+
+	printf("audio_dmic: stall %u | onset %3u ms after voicing, %3u ms after fricative | end %3u ms | "
+		   "%u periods, first %u\n", stall, (app.start_at + 1 - VOICED) * PERIOD_MS,
+		   (app.start_at + 1 - ONSET) * PERIOD_MS, (app.end_at + 1 - VOICED_END) * PERIOD_MS,
+		   app.delivered_num, app.delivered_num ? app.delivered[0] : 0);
+
+	/* one utterance, the hiss burst and channel 1 do not start speech */
+	CHECK(app.start_cnt == 1);
+	CHECK(app.end_cnt == 1);
+	CHECK(app.start_at >= VOICED + params.OnsetNum - 1 && app.start_at <= VOICED + params.OnsetNum + 1);
+	CHECK(app.end_at >= VOICED_END + params.HangoverNum - 1 && app.end_at <= VOICED_END + params.HangoverNum + 8);
+	CHECK(app.corrupt == 0);
+
+	/* every delivered period is whole, in order, and speech is continuous from the start */
+	for (i = 1; i < app.delivered_num; i++) {
+		CHECK(app.delivered[i] > app.delivered[i - 1]);
+	}
+	for (i = 0; i < app.delivered_num && app.delivered[i] < app.start_at; i++) {
+	}
+	CHECK(app.delivered_num - i == app.end_at - app.start_at + 1);
+
+	if (stall == 0) {
+		/* the whole pre-roll, back to the fricative */
+		CHECK(app.delivered[0] == app.start_at - params.PreRollNum);
+		CHECK(app.delivered[0] <= ONSET);
+		CHECK(i == params.PreRollNum);
+	} else {
+		/* the oldest one went out first, the ones GDMA reached afterwards are dropped */
+		CHECK(app.delivered[0] == app.start_at - params.PreRollNum);
+		CHECK(i < params.PreRollNum);
+	}
+}
+
+static double check_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+#define BENCH_LOOPS	200
+
+static void check_bench(void)
+{
+	AUDIO_DMIC_VADTypeDef vad;
+	AUDIO_DMIC_VADParams params;
+	volatile u32 state = 0;
+	double t0;
+	u32 n, p;
+#if defined(__x86_64__) || defined(__i386__)
+	u64 c0;
+#endif
+
+	AUDIO_DMIC_VADStructInit(&params);
+	AUDIO_DMIC_VADInit(&vad, &params, CHN_CNT, FRAMES);
+
+	t0 = check_now_ns();
+#if defined(__x86_64__) || defined(__i386__)
+	c0 = __builtin_ia32_rdtsc();
+#endif
+	for (n = 0; n < BENCH_LOOPS; n++) {
+		for (p = 0; p < TOTAL; p++) {
+			state += AUDIO_DMIC_VADProcess(&vad, gen[p]);
+		}
+	}
+	printf("audio_dmic: VADProcess %u frames x %u ch: %.0f ns/period on host", FRAMES, CHN_CNT,
+		   (check_now_ns() - t0) / BENCH_LOOPS / TOTAL);
+#if defined(__x86_64__) || defined(__i386__)
+	printf(", %.0f TSC cycles/period", (double)(__builtin_ia32_rdtsc() - c0) / BENCH_LOOPS / TOTAL);
+#endif
+	printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+	check_gen();
+
+	check_run(0);
+	check_run(3);
+
+	if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+		check_bench();
+	}
+
+	if (fail) {
+		printf("audio_dmic: FAIL (%u)\n", fail);
+		return 1;
+	}
+
+	printf("audio_dmic: VAD onset, pre-roll and delivery pass\n");
+	return 0;
+}
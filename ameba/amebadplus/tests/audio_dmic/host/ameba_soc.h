@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host stand-in for ameba_soc.h, just what ameba_audio_dmic.c needs. The codec and
+ * SPORT stream functions it calls are modeled in audio_dmic_check.c.
+ */
+
+#ifndef _AMEBA_SOC_H_
+#define _AMEBA_SOC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+
+#define __IO			volatile
+#define __I			volatile const
+#define __O			volatile
+#define _LONG_CALL_
+#define ALIGNMTO(x)		__attribute__((aligned(x)))
+#define BIT(x)			(1UL << (x))
+#define TRUE			1
+#define FALSE			0
+#define ENABLE			1
+#define DISABLE			0
+#define MIN(x, y)		(((x) < (y)) ? (x) : (y))
+#define MAX(x, y)		(((x) > (y)) ? (x) : (y))
+
+#define assert_param(expr)	((void)0)
+#define _memset			memset
+
+typedef u32(*IRQ_FUN)(void *Data);
+
+#include "ameba_gdma.h"
+#include "ameba_sport.h"
+#include "ameba_audio.h"
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * KM4 cycles/sample of the AUDIO_FMT kernels, counted by DWT->CYCCNT.
+ * Add this file to an application built with CONFIG_I2S_AMEBA and call
+ * audio_fmt_bench() from a task, buffers are in SRAM and warm in D-Cache.
+ */
+
+#include "ameba_soc.h"
+#include "ameba_audio_fmt.h"
+
+static const char *const TAG = "FMT";
+
+#define BENCH_FRAMES	480
+#define BENCH_SAMPLES	(2 * BENCH_FRAMES)
+
+static s16 bench_in16[BENCH_SAMPLES] __attribute__((aligned(32)));
+static s16 bench_mix16[BENCH_SAMPLES] __attribute__((aligned(32)));
+static s16 bench_out16[BENCH_SAMPLES] __attribute__((aligned(32)));
+static s32 bench_in32[BENCH_SAMPLES] __attribute__((aligned(32)));
+static float bench_f[BENCH_SAMPLES] __attribute__((aligned(32)));
+static s16 bench_chn16[2][BENCH_FRAMES] __attribute__((aligned(32)));
+
+/* the second run is reported, the first one warms the caches */
+#define BENCH(name, samples, call)	do { \
+		u32 start, cycles, loop; \
+		for (loop = 0; loop < 2; loop++) { \
+			start = DWT->CYCCNT; \
+			call; \
+			cycles = DWT->CYCCNT - start; \
+		} \
+		RTK_LOGI(TAG, "%s: %d.%02d cycles/sample\n", name, cycles / (samples), \
+				 (cycles % (samples)) * 100 / (samples)); \
+	} while (0)
+
+void audio_fmt_bench(void)
+{
+	s16 *d16[2] = {bench_chn16[0], bench_chn16[1]};
+	u32 i;
+
+	for (i = 0; i < BENCH_SAMPLES; i++) {
+		bench_in16[i] = (s16)_rand();
+		bench_mix16[i] = (s16)_rand();
+		bench_in32[i] = (s32)_rand();
+	}
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	BENCH("S32ToS16", BENCH_SAMPLES, AUDIO_FMT_S32ToS16(bench_out16, bench_in32, BENCH_SAMPLES));
+	BENCH("S16ToFloat", BENCH_SAMPLES, AUDIO_FMT_S16ToFloat(bench_f, bench_in16, BENCH_SAMPLES));
+	BENCH("FloatToS16", BENCH_SAMPLES, AUDIO_FMT_FloatToS16(bench_out16, bench_f, BENCH_SAMPLES));
+	BENCH("MonoToStereoS16", BENCH_FRAMES, AUDIO_FMT_MonoToStereoS16(bench_out16, bench_in16, BENCH_FRAMES));
+	BENCH("StereoToMonoS16", BENCH_FRAMES, AUDIO_FMT_StereoToMonoS16(bench_out16, bench_in16, BENCH_FRAMES, 16384, 16384));
+	BENCH("DeinterleaveS16 x2", BENCH_FRAMES, AUDIO_FMT_DeinterleaveS16(d16, bench_in16, 2, BENCH_FRAMES));
+	BENCH("GainS16", BENCH_SAMPLES, AUDIO_FMT_GainS16(bench_out16, bench_in16, BENCH_SAMPLES, 0x0800));
+	BENCH("MixS16", BENCH_SAMPLES, AUDIO_FMT_MixS16(bench_out16, bench_mix16, BENCH_SAMPLES));
+}
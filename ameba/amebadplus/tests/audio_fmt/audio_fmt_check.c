@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Runs every AUDIO_FMT kernel on fixed pseudo random data, full scale edges
+ * included, and writes all outputs to one file. Built once with the C path and
+ * once with the DSP path, the two files must be identical, see Makefile.
+ * With "bench" as second argument it also prints host ns/sample per kernel.
+ *
+ * Rounding and saturation at full scale are checked against fixed expected values,
+ * so both paths agreeing on a wrong value still fails. The resampler is also run
+ * against a reference: over random blocks of 1 ~ 1000 frames
+ * and a ppm that changes between blocks, every output frame must be the linear
+ * interpolation of the input at its position and the output count must be the number
+ * of positions the input has covered. Exit status is non-zero on any failure.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "ameba_soc.h"
+#include "ameba_audio_fmt.h"
+
+/* odd sizes so the kernels run their scalar tails too */
+#define FRAMES		4097
+#define SAMPLES		(2 * FRAMES)
+
+static s16 in16[8 * FRAMES] __attribute__((aligned(4)));
+static s16 mix16[SAMPLES] __attribute__((aligned(4)));
+static s32 in32[8 * FRAMES];
+static s16 out16[8 * FRAMES + 16] __attribute__((aligned(4)));
+static s32 out32[8 * FRAMES];
+static float outf[SAMPLES];
+static s16 chn16[8][FRAMES];
+static s32 chn32[8][FRAMES];
+
+static FILE *out_fp;
+static u32 seed = 1;
+static u32 fail;
+
+static u32 check_rand(void)
+{
+	seed = seed * 1664525 + 1013904223;
+	return seed;
+}
+
+static void check_dump(const void *buf, size_t len)
+{
+	fwrite(buf, 1, len, out_fp);
+}
+
+static void check_fill(void)
+{
+	u32 i;
+
+	for (i = 0; i < 8 * FRAMES; i++) {
+		in16[i] = (s16)check_rand();
+		in32[i] = (s32)check_rand();
+	}
+	for (i = 0; i < SAMPLES; i++) {
+		mix16[i] = (s16)check_rand();
+	}
+
+	in16[0] = -32768;
+	in16[1] = 32767;
+	in16[2] = 32767;
+	in16[3] = 32767;
+	mix16[0] = -32768;
+	mix16[1] = 32767;
+	mix16[2] = 1;
+	in32[0] = (s32)0x80000000;
+	in32[1] = 0x7FFFFFFF;
+	in32[2] = 0x007FFFFF;
+	in32[3] = (s32)0xFF800000;
+}
+
+static void check_deinterleave(u32 chn_cnt)
+{
+	s16 *d16[8];
+	s32 *d32[8];
+	const s16 *s16p[8];
+	u32 ch;
+
+	for (ch = 0; ch < chn_cnt; ch++) {
+		d16[ch] = chn16[ch];
+		d32[ch] = chn32[ch];
+		s16p[ch] = chn16[ch];
+	}
+
+	/* a chn_cnt long pointer array, so a sanitizer catches reads past it */
+	{
+		s16 *dd16[chn_cnt];
+		s32 *dd32[chn_cnt];
+		const s16 *ss16[chn_cnt];
+
+		memcpy(dd16, d16, sizeof(dd16));
+		memcpy(dd32, d32, sizeof(dd32));
+		memcpy(ss16, s16p, sizeof(ss16));
+
+		AUDIO_FMT_DeinterleaveS16(dd16, in16, chn_cnt, FRAMES);
+		AUDIO_FMT_DeinterleaveS32(dd32, in32, chn_cnt, FRAMES);
+		for (ch = 0; ch < chn_cnt; ch++) {
+			check_dump(chn16[ch], FRAMES * sizeof(s16));
+			check_dump(chn32[ch], FRAMES * sizeof(s32));
+		}
+
+		AUDIO_FMT_InterleaveS16(out16, ss16, chn_cnt, FRAMES);
+		check_dump(out16, chn_cnt * FRAMES * sizeof(s16));
+		if (memcmp(out16, in16, chn_cnt * FRAMES * sizeof(s16)) != 0) {
+			printf("interleave %u channels does not restore the input\n", (unsigned)chn_cnt);
+			fail++;
+		}
+	}
+}
+
+static void check_resample(float ppm, u32 chn_cnt)
+{
+	AUDIO_FMT_ResampleTypeDef State;
+	u32 blk, n;
+
+	AUDIO_FMT_ResampleInit(&State, chn_cnt);
+	AUDIO_FMT_ResampleSetPpm(&State, ppm);
+	for (blk = 0; blk < 8; blk++) {
+		n = AUDIO_FMT_ResampleS16(&State, out16, &in16[blk * 480 * chn_cnt], 480);
+		check_dump(&n, sizeof(n));
+		check_dump(out16, n * chn_cnt * sizeof(s16));
+	}
+}
+
+#define GOLDEN(name, got, expect, n)	do { \
+		for (u32 k = 0; k < (n); k++) { \
+			if ((got)[k] != (expect)[k]) { \
+				printf("%s[%u]: %ld, expected %ld\n", name, (unsigned)k, (long)(got)[k], (long)(expect)[k]); \
+				fail++; \
+			} \
+		} \
+	} while (0)
+
+/* full scale and half lsb edges, odd counts so the DSP path runs its pairs and its tail */
+static void check_golden(void)
+{
+	static const s32 s32_in[] = {0x7FFFFFFF, (s32)0x80000000, 0x00008000, 0x00007FFF, -0x8000, -0x8001, 0x7FFF8000};
+	static const s16 s32_s16[] = {32767, -32768, 1, 0, 0, -1, 32767};
+	static const s32 s32_s24[] = {0x7FFFFF, -0x800000, 0x80, 0x80, -0x80, -0x80, 0x7FFF80};
+	static const s32 s24_in[] = {0x007FFFFF, (s32)0xFF800000, 0x80, 0x7F, -0x80, -0x81, 0x007FFF80};
+	static const s16 s24_s16[] = {32767, -32768, 1, 0, 0, -1, 32767};
+	static const s32 s24_s32[] = {0x7FFFFF00, (s32)0x80000000, 0x8000, 0x7F00, -0x8000, -0x8100, 0x7FFF8000};
+	static const s16 s16_in[] = {32767, -32768, 1, -1, 0};
+	static const s32 s16_s32[] = {0x7FFF0000, (s32)0x80000000, 0x10000, -0x10000, 0};
+	static const s32 s16_s24[] = {0x7FFF00, -0x800000, 0x100, -0x100, 0};
+	static const float fl_in[] = {1.0f, -1.0f, 2.0f, -2.0f, 0.5f / 32768, -0.5f / 32768, 0.0f};
+	static const s16 fl_s16[] = {32767, -32768, 32767, -32768, 1, -1, 0};
+	static const s32 fl_s32[] = {0x7FFFFFFF, (s32)0x80000000, 0x7FFFFFFF, (s32)0x80000000, 0x8000, -0x8000, 0};
+	static const s16 gain_max[] = {32767, -32768, 8, -8, 0};
+	static const s16 mix_a[] = {32767, -32768, 32767, -32768, 100};
+	static const s16 mix_b[] = {1, -1, -32768, 32767, -200};
+	static const s16 mix_ab[] = {32767, -32768, -1, -1, -100};
+	static const s16 stereo_in[] = {32767, 32767, -32768, -32768, 32767, -32768};
+	static const s16 mono_sum[] = {32767, -32768, -1};
+	static const s16 mono_diff[] = {0, 0, 32767};
+	s16 o16[8] __attribute__((aligned(4)));
+	s16 a16[8] __attribute__((aligned(4)));
+	s32 o32[8];
+
+	AUDIO_FMT_S32ToS16(o16, s32_in, 7);
+	GOLDEN("S32ToS16", o16, s32_s16, 7);
+	AUDIO_FMT_S32ToS24(o32, s32_in, 7);
+	GOLDEN("S32ToS24", o32, s32_s24, 7);
+	AUDIO_FMT_S24ToS16(o16, s24_in, 7);
+	GOLDEN("S24ToS16", o16, s24_s16, 7);
+	AUDIO_FMT_S24ToS32(o32, s24_in, 7);
+	GOLDEN("S24ToS32", o32, s24_s32, 7);
+	AUDIO_FMT_S16ToS32(o32, s16_in, 5);
+	GOLDEN("S16ToS32", o32, s16_s32, 5);
+	AUDIO_FMT_S16ToS24(o32, s16_in, 5);
+	GOLDEN("S16ToS24", o32, s16_s24, 5);
+	AUDIO_FMT_FloatToS16(o16, fl_in, 7);
+	GOLDEN("FloatToS16", o16, fl_s16, 7);
+	AUDIO_FMT_FloatToS32(o32, fl_in, 7);
+	GOLDEN("FloatToS32", o32, fl_s32, 7);
+
+	memcpy(a16, s16_in, sizeof(s16_in));
+	a16[2] = 1;
+	a16[3] = -1;
+	AUDIO_FMT_GainS16(o16, a16, 5, 0x7FFF);
+	GOLDEN("GainS16 max", o16, gain_max, 5);
+	AUDIO_FMT_GainS16(o16, a16, 5, AUDIO_FMT_GAIN_UNITY);
+	GOLDEN("GainS16 unity", o16, s16_in, 5);
+
+	memcpy(a16, mix_a, sizeof(mix_a));
+	AUDIO_FMT_MixS16(a16, mix_b, 5);
+	GOLDEN("MixS16", a16, mix_ab, 5);
+
+	memcpy(a16, stereo_in, sizeof(stereo_in));
+	AUDIO_FMT_StereoToMonoS16(o16, a16, 3, 32767, 32767);
+	GOLDEN("StereoToMonoS16 sum", o16, mono_sum, 3);
+	AUDIO_FMT_StereoToMonoS16(o16, a16, 3, 16384, -16384);
+	GOLDEN("StereoToMonoS16 diff", o16, mono_diff, 3);
+}
+
+#define REF_BLOCKS		400
+#define REF_BLOCK_MAX	1000
+
+/* const_ppm: one ppm for the whole run, so the count also has a closed form */
+static void check_resample_ref(u32 chn_cnt, int const_ppm, float ppm)
+{
+	AUDIO_FMT_ResampleTypeDef State;
+	/* the input as one stream, frame 0 is the zero frame the resampler starts from */
+	s16 *in = calloc((REF_BLOCKS * REF_BLOCK_MAX + 1) * chn_cnt, sizeof(s16));
+	u64 pos = (u64)1 << 32;
+	u64 in_frames = 0;
+	u64 out_frames = 0;
+	double max_err = 0;
+	u32 blk, n, i, c, frames;
+	u32 idx;
+	double frac, ref, err, step;
+	s32 delta;
+
+	AUDIO_FMT_ResampleInit(&State, chn_cnt);
+	for (i = chn_cnt; i < (REF_BLOCKS * REF_BLOCK_MAX + 1) * chn_cnt; i++) {
+		in[i] = (s16)check_rand();
+	}
+
+	for (blk = 0; blk < REF_BLOCKS; blk++) {
+		if (!const_ppm || blk == 0) {
+			if (!const_ppm) {
+				ppm = (float)((s32)(check_rand() % 2401) - 1200);
+			}
+			AUDIO_FMT_ResampleSetPpm(&State, ppm);
+			/* clamped to AUDIO_FMT_RESAMPLE_PPM_MAX, Q32 input frames per output frame */
+			step = 4294967296.0 / (1 + fmax(fmin(ppm, AUDIO_FMT_RESAMPLE_PPM_MAX), -AUDIO_FMT_RESAMPLE_PPM_MAX) / 1e6);
+			if (fabs((double)State.Step - step) > 1) {
+				printf("resample: ppm %.0f step %llu, expected %.1f\n", ppm, (unsigned long long)State.Step, step);
+				fail++;
+			}
+		}
+
+		frames = 1 + check_rand() % REF_BLOCK_MAX;
+		/* guard frames after what the resampler may write */
+		memset(out16, 0x5A, (REF_BLOCK_MAX + 4) * chn_cnt * sizeof(s16));
+		n = AUDIO_FMT_ResampleS16(&State, out16, &in[(in_frames + 1) * chn_cnt], frames);
+		in_frames += frames;
+
+		if (n > frames + 2 || out16[(frames + 2) * chn_cnt] != 0x5A5A) {
+			printf("resample: %u frames in, %u out, more than the dst size\n", frames, n);
+			fail++;
+		}
+
+		/* every position below the last input frame is produced in this block */
+		for (i = 0; i < n; i++, pos += State.Step) {
+			idx = (u32)(pos >> 32);
+			frac = (double)(u32)pos / 4294967296.0;
+			for (c = 0; c < chn_cnt; c++) {
+				delta = in[(idx + 1) * chn_cnt + c] - in[idx * chn_cnt + c];
+				ref = in[idx * chn_cnt + c] + delta * frac;
+				/* the kernel keeps 15 bits of the fraction and rounds the product down */
+				err = fabs(out16[i * chn_cnt + c] - ref);
+				max_err = fmax(max_err, err);
+				if (err >= abs(delta) / 32768.0 + 1) {
+					printf("resample: frame %llu channel %u: %d, reference %.2f\n",
+						   (unsigned long long)(out_frames + i), c, out16[i * chn_cnt + c], ref);
+					fail++;
+				}
+			}
+		}
+		out_frames += n;
+		if ((pos >> 32) < in_frames || ((pos - State.Step) >> 32) >= in_frames) {
+			printf("resample: block %u stops at position %.3f of %llu frames\n", blk, pos / 4294967296.0,
+				   (unsigned long long)in_frames);
+			fail++;
+		}
+	}
+
+	/* (in_frames - 1) / step outputs, rounded up, as the first one is at frame 0 */
+	if (const_ppm && out_frames != ((in_frames - 1) * ((u64)1 << 32) + State.Step - 1) / State.Step) {
+		printf("resample: %.0f ppm, %llu frames in, %llu out\n", ppm, (unsigned long long)in_frames,
+			   (unsigned long long)out_frames);
+		fail++;
+	}
+
+	printf("resample: %u channels, %s ppm: %llu frames in, %llu out, %+.1f ppm, within %.2f lsb of the reference\n",
+		   chn_cnt, const_ppm ? "fixed" : "changing", (unsigned long long)in_frames, (unsigned long long)out_frames,
+		   ((double)out_frames / in_frames - 1) * 1e6, max_err);
+
+	free(in);
+}
+
+static void check_all(void)
+{
+	static const u32 gains[] = {0, 0x0800, AUDIO_FMT_GAIN_UNITY, 0x2000, 0x7FFF};
+	static const float fl[] = {1.0f, -1.0f, 2.0f, -2.0f, 0.5f / 32768, -0.5f / 32768, 0.0f};
+	static const u32 chns[] = {1, 2, 3, 4, 8};
+	u32 i;
+
+	AUDIO_FMT_S16ToS32(out32, in16, SAMPLES);
+	check_dump(out32, SAMPLES * sizeof(s32));
+	AUDIO_FMT_S32ToS16(out16, in32, SAMPLES);
+	check_dump(out16, SAMPLES * sizeof(s16));
+	AUDIO_FMT_S16ToS24(out32, in16, SAMPLES);
+	check_dump(out32, SAMPLES * sizeof(s32));
+	AUDIO_FMT_S24ToS16(out16, in32, SAMPLES);
+	check_dump(out16, SAMPLES * sizeof(s16));
+	AUDIO_FMT_S24ToS32(out32, in32, SAMPLES);
+	check_dump(out32, SAMPLES * sizeof(s32));
+	AUDIO_FMT_S32ToS24(out32, in32, SAMPLES);
+	check_dump(out32, SAMPLES * sizeof(s32));
+
+	AUDIO_FMT_S16ToFloat(outf, in16, SAMPLES);
+	check_dump(outf, SAMPLES * sizeof(float));
+	AUDIO_FMT_FloatToS16(out16, outf, SAMPLES);
+	check_dump(out16, SAMPLES * sizeof(s16));
+	AUDIO_FMT_S32ToFloat(outf, in32, SAMPLES);
+	check_dump(outf, SAMPLES * sizeof(float));
+	AUDIO_FMT_FloatToS32(out32, outf, SAMPLES);
+	check_dump(out32, SAMPLES * sizeof(s32));
+	AUDIO_FMT_FloatToS16(out16, fl, sizeof(fl) / sizeof(fl[0]));
+	check_dump(out16, sizeof(fl) / sizeof(fl[0]) * sizeof(s16));
+	AUDIO_FMT_FloatToS32(out32, fl, sizeof(fl) / sizeof(fl[0]));
+	check_dump(out32, sizeof(fl) / sizeof(fl[0]) * sizeof(s32));
+
+	AUDIO_FMT_MonoToStereoS16(out16, in16, FRAMES);
+	check_dump(out16, SAMPLES * sizeof(s16));
+	AUDIO_FMT_StereoToMonoS16(out16, in16, FRAMES, 16384, 16384);
+	check_dump(out16, FRAMES * sizeof(s16));
+	AUDIO_FMT_StereoToMonoS16(out16, in16, FRAMES, 32767, -32767);
+	check_dump(out16, FRAMES * sizeof(s16));
+	AUDIO_FMT_StereoToMonoS16(out16, in16, FRAMES, -32767, 32767);
+	check_dump(out16, FRAMES * sizeof(s16));
+
+	for (i = 0; i < sizeof(gains) / sizeof(gains[0]); i++) {
+		AUDIO_FMT_GainS16(out16, in16, SAMPLES, gains[i]);
+		check_dump(out16, SAMPLES * sizeof(s16));
+	}
+
+	memcpy(out16, in16, SAMPLES * sizeof(s16));
+	AUDIO_FMT_MixS16(out16, mix16, SAMPLES);
+	check_dump(out16, SAMPLES * sizeof(s16));
+
+	for (i = 0; i < sizeof(chns) / sizeof(chns[0]); i++) {
+		check_deinterleave(chns[i]);
+	}
+
+	check_resample(0.0f, 2);
+	check_resample(250.0f, 2);
+	check_resample(-1000.0f, 1);
+	check_resample(1000.0f, AUDIO_FMT_RESAMPLE_CHN_MAX);
+
+	check_golden();
+
+	check_resample_ref(2, 1, 250.0f);
+	check_resample_ref(1, 1, -1000.0f);
+	check_resample_ref(3, 1, 5000.0f);
+	check_resample_ref(AUDIO_FMT_RESAMPLE_CHN_MAX, 0, 0);
+}
+
+static double check_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+#define BENCH_LOOPS	2000
+#define BENCH(name, samples, call)	do { \
+		double t0 = check_now_ns(); \
+		for (u32 n = 0; n < BENCH_LOOPS; n++) { \
+			call; \
+			__asm__ volatile("" ::: "memory"); \
+		} \
+		printf("%-24s %6.3f ns/sample\n", name, (check_now_ns() - t0) / BENCH_LOOPS / (samples)); \
+	} while (0)
+
+static void check_bench(void)
+{
+	s16 *d16[2] = {chn16[0], chn16[1]};
+
+	BENCH("S32ToS16", SAMPLES, AUDIO_FMT_S32ToS16(out16, in32, SAMPLES));
+	BENCH("S16ToFloat", SAMPLES, AUDIO_FMT_S16ToFloat(outf, in16, SAMPLES));
+	BENCH("FloatToS16", SAMPLES, AUDIO_FMT_FloatToS16(out16, outf, SAMPLES));
+	BENCH("MonoToStereoS16", FRAMES, AUDIO_FMT_MonoToStereoS16(out16, in16, FRAMES));
+	BENCH("StereoToMonoS16", FRAMES, AUDIO_FMT_StereoToMonoS16(out16, in16, FRAMES, 16384, 16384));
+	BENCH("DeinterleaveS16 x2", FRAMES, AUDIO_FMT_DeinterleaveS16(d16, in16, 2, FRAMES));
+	BENCH("GainS16", SAMPLES, AUDIO_FMT_GainS16(out16, in16, SAMPLES, 0x0800));
+	BENCH("MixS16", SAMPLES, AUDIO_FMT_MixS16(out16, mix16, SAMPLES));
+}
+
+int main(int argc, char **argv)
+{
+	if (argc < 2) {
+		printf("usage: %s <out.bin> [bench]\n", argv[0]);
+		return 2;
+	}
+
+	out_fp = fopen(argv[1], "wb");
+	if (out_fp == NULL) {
+		perror(argv[1]);
+		return 2;
+	}
+
+	check_fill();
+	check_all();
+	fclose(out_fp);
+
+	if (argc > 2 && strcmp(argv[2], "bench") == 0) {
+		check_bench();
+	}
+
+	if (fail) {
+		printf("audio_fmt: FAIL (%u)\n", fail);
+		return 1;
+	}
+
+	return 0;
+}
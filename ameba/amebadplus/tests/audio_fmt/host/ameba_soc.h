@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host stand-in for ameba_soc.h, just what ameba_audio_fmt.c needs. */
+
+#ifndef _AMEBA_SOC_H_
+#define _AMEBA_SOC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int16_t s16;
+typedef int32_t s32;
+
+#define assert_param(expr)	((void)0)
+#define _memset			memset
+
+#ifdef AUDIO_FMT_TEST_DSP
+/* Cortex-M33 DSP intrinsics as described in the Armv8-M Architecture Reference Manual */
+#define __ARM_FEATURE_DSP	1U
+
+static inline s32 __SSAT(s32 x, u32 n)
+{
+	s32 max = (s32)((1UL << (n - 1)) - 1);
+
+	return (x > max) ? max : ((x < -max - 1) ? -max - 1 : x);
+}
+
+static inline u32 __PKHBT(u32 a, u32 b, u32 s)
+{
+	return (a & 0xFFFF) | ((b << s) & 0xFFFF0000);
+}
+
+static inline u32 __PKHTB(u32 a, u32 b, u32 s)
+{
+	return (a & 0xFFFF0000) | ((b >> s) & 0xFFFF);
+}
+
+static inline u32 __SMLAD(u32 a, u32 b, u32 c)
+{
+	return (u32)((s32)(s16)a * (s16)b + (s32)(s16)(a >> 16) * (s16)(b >> 16) + (s32)c);
+}
+
+static inline s32 __SMULBB(u32 a, u32 b)
+{
+	return (s32)(s16)a * (s16)b;
+}
+
+static inline s32 __SMULTB(u32 a, u32 b)
+{
+	return (s32)(s16)(a >> 16) * (s16)b;
+}
+
+static inline u32 __QADD16(u32 a, u32 b)
+{
+	s32 lo = __SSAT((s16)a + (s16)b, 16);
+	s32 hi = __SSAT((s16)(a >> 16) + (s16)(b >> 16), 16);
+
+	return (u16)lo | ((u32)(u16)hi << 16);
+}
+#endif
+
+#endif
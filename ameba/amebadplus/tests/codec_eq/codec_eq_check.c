@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Quantization reference for the ADC EQ designer of ameba_codec.c: every band is designed
+ * again here and rounded to 4.25, the registers of AUDIO_CODEC_DesignEQFilter must match.
+ *
+ * The band runs y[n] = H0 x[n] + B1 x[n-1] + B2 x[n-2] - A1 y[n-1] - A2 y[n-2] on the
+ * quantized registers. With that, every band must be stable and, from fc = sr / 2000 up,
+ * have its response within 0.05dB: the gain at fc for peaking, the gain at DC or Nyquist
+ * and half of it at fc for the shelves, -3dB at fc for a Butterworth HPF/LPF. A 1kHz +6dB peak at 16kHz is also run on tones.
+ * Out of range bands are rejected and a profile loads into the registers in one go.
+ *
+ *   codec_eq_check	exit status is non-zero on any failure
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include "ameba_soc.h"
+
+#define COEF_ONE	(1 << 25)
+#define SAMPLE_NUM	16000
+#define COEF_TOL_LSB	1	/* libm rounding */
+
+AUDIO_CODEC_TypeDef model_codec;
+int model_log_level = RTK_LOG_NONE;
+
+static u32 fail;
+
+#define CHECK(expr)	do { \
+		if (!(expr)) { \
+			printf("codec_eq: %s:%d check failed: %s\n", __FILE__, __LINE__, #expr); \
+			fail++; \
+		} \
+	} while (0)
+
+/* 29 bit 2's complement 4.25 register to its value */
+static double coef_of(u32 reg)
+{
+	s32 q = (s32)(reg << 3) >> 3;
+
+	return (double)q / COEF_ONE;
+}
+
+/* cookbook band in double, b0..a2 normalized to a0 = 1 */
+static void ref_design(CODEC_EQBandParams *Band, u32 sr, double c[5])
+{
+	double w0 = 2 * M_PI * Band->Fc / sr;
+	double cs = cos(w0);
+	double alpha = sin(w0) / (2 * Band->Q);
+	double A = pow(10, Band->GainDb / 40.0);
+	double sqA = 2 * sqrt(A) * alpha;
+	double b0, b1, b2, a0, a1, a2;
+
+	switch (Band->Type) {
+	case CODEC_EQ_PEAKING:
+		b0 = 1 + alpha * A;
+		b1 = -2 * cs;
+		b2 = 1 - alpha * A;
+		a0 = 1 + alpha / A;
+		a1 = -2 * cs;
+		a2 = 1 - alpha / A;
+		break;
+	case CODEC_EQ_LOWSHELF:
+		b0 = A * ((A + 1) - (A - 1) * cs + sqA);
+		b1 = 2 * A * ((A - 1) - (A + 1) * cs);
+		b2 = A * ((A + 1) - (A - 1) * cs - sqA);
+		a0 = (A + 1) + (A - 1) * cs + sqA;
+		a1 = -2 * ((A - 1) + (A + 1) * cs);
+		a2 = (A + 1) + (A - 1) * cs - sqA;
+		break;
+	case CODEC_EQ_HIGHSHELF:
+		b0 = A * ((A + 1) + (A - 1) * cs + sqA);
+		b1 = -2 * A * ((A - 1) + (A + 1) * cs);
+		b2 = A * ((A + 1) + (A - 1) * cs - sqA);
+		a0 = (A + 1) - (A - 1) * cs + sqA;
+		a1 = 2 * ((A - 1) - (A + 1) * cs);
+		a2 = (A + 1) - (A - 1) * cs - sqA;
+		break;
+	case CODEC_EQ_HPF:
+		b0 = (1 + cs) / 2;
+		b1 = -(1 + cs);
+		b2 = b0;
+		a0 = 1 + alpha;
+		a1 = -2 * cs;
+		a2 = 1 - alpha;
+		break;
+	default:
+		b0 = (1 - cs) / 2;
+		b1 = 1 - cs;
+		b2 = b0;
+		a0 = 1 + alpha;
+		a1 = -2 * cs;
+		a2 = 1 - alpha;
+		break;
+	}
+
+	c[0] = b0 / a0;
+	c[1] = b1 / a0;
+	c[2] = b2 / a0;
+	c[3] = a1 / a0;
+	c[4] = a2 / a0;
+}
+
+static void regs_of(CODEC_EQFilterCoef *Coef, u32 reg[5])
+{
+	reg[0] = Coef->H0_Q;
+	reg[1] = Coef->B1_Q;
+	reg[2] = Coef->B2_Q;
+	reg[3] = Coef->A1_Q;
+	reg[4] = Coef->A2_Q;
+}
+
+/* response of the band on its registers, in dB */
+static double band_db(u32 reg[5], double f, u32 sr)
+{
+	double complex z1 = cexp(-I * 2 * M_PI * f / sr);
+	double complex num = coef_of(reg[0]) + coef_of(reg[1]) * z1 + coef_of(reg[2]) * z1 * z1;
+	double complex den = 1 + coef_of(reg[3]) * z1 + coef_of(reg[4]) * z1 * z1;
+
+	return 20 * log10(cabs(num) / cabs(den));
+}
+
+/* poles of 1 + A1 z^-1 + A2 z^-2 inside the unit circle */
+static int band_stable(u32 reg[5])
+{
+	double a1 = coef_of(reg[3]);
+	double a2 = coef_of(reg[4]);
+
+	return (fabs(a2) < 1) && (fabs(a1) < 1 + a2);
+}
+
+/* run the band on a tone the way the codec does, return the output to input level in dB */
+static double band_tone_db(u32 reg[5], double f, u32 sr)
+{
+	double c[5];
+	double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+	double in = 0, out = 0;
+	double x, y;
+	u32 n, k;
+
+	for (k = 0; k < 5; k++) {
+		c[k] = coef_of(reg[k]);
+	}
+
+	for (n = 0; n < SAMPLE_NUM; n++) {
+		x = sin(2 * M_PI * f * n / sr);
+		y = c[0] * x + c[1] * x1 + c[2] * x2 - c[3] * y1 - c[4] * y2;
+		x2 = x1;
+		x1 = x;
+		y2 = y1;
+		y1 = y;
+		/* past the settling of the band */
+		if (n >= SAMPLE_NUM / 2) {
+			in += x * x;
+			out += y * y;
+		}
+	}
+
+	return 10 * log10(out / in);
+}
+
+static u32 band_num;
+static u32 max_lsb;
+
+static void check_band(u32 type, float fc, float q, float gain, u32 sr)
+{
+	CODEC_EQBandParams band = {type, fc, q, gain};
+	CODEC_EQFilterCoef coef;
+	double ref[5];
+	double expect_db, got_db;
+	int64_t lsb;
+	u32 reg[5];
+	u32 k;
+
+	if (!AUDIO_CODEC_DesignEQFilter(&band, sr, &coef)) {
+		printf("codec_eq: type %u fc %.1f Q %.3f gain %.1f sr %u rejected\n", type, fc, q, gain, sr);
+		fail++;
+		return;
+	}
+	regs_of(&coef, reg);
+	ref_design(&band, sr, ref);
+	band_num++;
+
+	for (k = 0; k < 5; k++) {
+		lsb = llabs(llround(ref[k] * COEF_ONE) - llround(coef_of(reg[k]) * COEF_ONE));
+		if (lsb > max_lsb) {
+			max_lsb = lsb;
+		}
+		if (lsb > COEF_TOL_LSB) {
+			printf("codec_eq: type %u fc %.1f Q %.3f gain %.1f sr %u coef %u: %.9f, reference %.9f\n",
+				   type, fc, q, gain, sr, k, coef_of(reg[k]), ref[k]);
+			fail++;
+		}
+	}
+
+	CHECK(band_stable(reg));
+
+	/* below that the rounding of A1/A2 alone is more than 0.05dB, see AUDIO_CODEC_DesignEQFilter */
+	if (fc < (float)sr / 2000) {
+		return;
+	}
+
+	switch (type) {
+	case CODEC_EQ_PEAKING:
+		got_db = band_db(reg, fc, sr);
+		expect_db = gain;
+		break;
+	case CODEC_EQ_LOWSHELF:
+		CHECK(fabs(band_db(reg, 0, sr) - gain) < 0.05);
+		got_db = band_db(reg, fc, sr);
+		expect_db = gain / 2;
+		break;
+	case CODEC_EQ_HIGHSHELF:
+		CHECK(fabs(band_db(reg, sr / 2.0, sr) - gain) < 0.05);
+		got_db = band_db(reg, fc, sr);
+		expect_db = gain / 2;
+		break;
+	default:
+		got_db = band_db(reg, fc, sr);
+		expect_db = 20 * log10(q);
+		break;
+	}
+
+	if (fabs(got_db - expect_db) > 0.05) {
+		printf("codec_eq: type %u fc %.1f Q %.3f gain %.1f sr %u: %.3f dB at fc, expected %.3f dB\n",
+			   type, fc, q, gain, sr, got_db, expect_db);
+		fail++;
+	}
+}
+
+int main(void)
+{
+	static const u32 rates[] = {8000, 16000, 32000, 44100, 48000, 96000};
+	static const float qs[] = {0.3f, 0.707f, 1, 4, 10};
+	static const float gains[] = {-12, -6, -1, 0, 3, 6, 12};
+	CODEC_EQBandParams peak = {CODEC_EQ_PEAKING, 1000, 1, 6};
+	CODEC_EQBandParams bands[3] = {
+		{CODEC_EQ_HPF, 100, 0.707f, 0},
+		{CODEC_EQ_PEAKING, 1000, 1, 6},
+		{CODEC_EQ_HIGHSHELF, 4000, 0.707f, -6},
+	};
+	CODEC_EQFilterCoef coef;
+	CODEC_EQProfile profile;
+	u32 reg[5];
+	u32 r, g, k, i;
+	float fc;
+
+	for (r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+		for (fc = 20; fc < 0.45f * rates[r]; fc *= 1.5f) {
+			for (g = 0; g < sizeof(gains) / sizeof(gains[0]); g++) {
+				for (k = 0; k < sizeof(qs) / sizeof(qs[0]); k++) {
+					check_band(CODEC_EQ_PEAKING, fc, qs[k], gains[g], rates[r]);
+				}
+				check_band(CODEC_EQ_LOWSHELF, fc, 0.707f, gains[g], rates[r]);
+				check_band(CODEC_EQ_HIGHSHELF, fc, 0.707f, gains[g], rates[r]);
+			}
+			check_band(CODEC_EQ_HPF, fc, 0.707f, 0, rates[r]);
+			check_band(CODEC_EQ_LPF, fc, 0.707f, 0, rates[r]);
+		}
+	}
+	printf("codec_eq: %u bands, registers within %u lsb of the reference\n", band_num, max_lsb);
+
+	/* the band the feedback sign shows on: with + A1 y[n-1] + A2 y[n-2] it has a pole at 2.0 */
+	CHECK(AUDIO_CODEC_DesignEQFilter(&peak, 16000, &coef));
+	regs_of(&coef, reg);
+	printf("codec_eq: 1kHz Q1 +6dB at 16k: %.2f dB at 100Hz, %.2f dB at 1kHz, %.2f dB at 4kHz\n",
+		   band_tone_db(reg, 100, 16000), band_tone_db(reg, 1000, 16000), band_tone_db(reg, 4000, 16000));
+	CHECK(fabs(band_tone_db(reg, 1000, 16000) - 6) < 0.05);
+	CHECK(fabs(band_tone_db(reg, 100, 16000)) < 0.1);
+	CHECK(fabs(band_tone_db(reg, 4000, 16000)) < 0.5);
+
+	/* bypass is the register reset value */
+	peak.Type = CODEC_EQ_BYPASS;
+	CHECK(AUDIO_CODEC_DesignEQFilter(&peak, 16000, &coef));
+	CHECK(coef.H0_Q == AUD_GET_ADC_0_BIQUAD_H0_x(0x2000000) && coef.B1_Q == 0 && coef.B2_Q == 0 &&
+		  coef.A1_Q == 0 && coef.A2_Q == 0);
+
+	/* invalid, or a coefficient beyond -8 ~ 7.99 */
+	peak.Type = CODEC_EQ_PEAKING;
+	peak.Fc = 8000;
+	CHECK(!AUDIO_CODEC_DesignEQFilter(&peak, 16000, &coef));
+	peak.Fc = 1000;
+	peak.Q = 0;
+	CHECK(!AUDIO_CODEC_DesignEQFilter(&peak, 16000, &coef));
+	peak.Q = 0.1f;
+	peak.GainDb = 40;
+	CHECK(!AUDIO_CODEC_DesignEQFilter(&peak, 16000, &coef));
+
+	/* a profile writes every band and enables only the designed ones */
+	memset(&model_codec, 0, sizeof(model_codec));
+	model_codec.CODEC_ADC_1_EQ_CTRL = AUD_BIT_ADC_1_BIQUAD_EN_4;
+	CHECK(AUDIO_CODEC_DesignEQProfile(bands, 3, 48000, &profile));
+	CHECK(profile.BandMask == (BIT(0) | BIT(1) | BIT(2)));
+	AUDIO_CODEC_LoadADCEQProfile(ADCHN2, &profile);
+	CHECK(model_codec.CODEC_ADC_1_EQ_CTRL == (AUD_BIT_ADC_1_BIQUAD_EN_0 | AUD_BIT_ADC_1_BIQUAD_EN_1 |
+			AUD_BIT_ADC_1_BIQUAD_EN_2));
+	CHECK(model_codec.CODEC_CLOCK_CONTROL_2 & AUD_BIT_AD_1_EQ_EN);
+	CHECK(model_codec.CODEC_ADC_0_EQ_CTRL == 0);
+	for (i = 0; i < 5; i++) {
+		regs_of(&profile.Coef[i], reg);
+		CHECK(model_codec.CODEC_ADC_1_EQ_BAND[i].CODEC_BIQUAD_H0_x == reg[0]);
+		CHECK(model_codec.CODEC_ADC_1_EQ_BAND[i].CODEC_BIQUAD_B1_x == reg[1]);
+		CHECK(model_codec.CODEC_ADC_1_EQ_BAND[i].CODEC_BIQUAD_B2_x == reg[2]);
+		CHECK(model_codec.CODEC_ADC_1_EQ_BAND[i].CODEC_BIQUAD_A1_x == reg[3]);
+		CHECK(model_codec.CODEC_ADC_1_EQ_BAND[i].CODEC_BIQUAD_A2_x == reg[4]);
+	}
+	CHECK(model_codec.CODEC_ADC_1_EQ_BAND[4].CODEC_BIQUAD_H0_x == COEF_ONE);
+
+	if (fail) {
+		printf("codec_eq: FAIL (%u)\n", fail);
+		return 1;
+	}
+
+	printf("codec_eq: EQ registers match the reference, bands stable with their response\n");
+	return 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host stand-in for ameba_soc.h, just what ameba_codec.c needs. The codec registers are
+ * a plain struct, model_codec in codec_eq_check.c.
+ */
+
+#ifndef _AMEBA_SOC_H_
+#define _AMEBA_SOC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+
+#define __IO			volatile
+#define __I			volatile const
+#define __O			volatile
+#define _LONG_CALL_
+#define ALIGNMTO(x)		__attribute__((aligned(x)))
+#define BIT(x)			(1UL << (x))
+#define TRUE			1
+#define FALSE			0
+#define ENABLE			1
+#define DISABLE			0
+#define MIN(x, y)		(((x) < (y)) ? (x) : (y))
+#define MAX(x, y)		(((x) > (y)) ? (x) : (y))
+
+#define assert_param(expr)	((void)0)
+#define _memset			memset
+
+typedef u32(*IRQ_FUN)(void *Data);
+
+enum {
+	RTK_LOG_NONE = 0,
+	RTK_LOG_ERROR,
+	RTK_LOG_WARN,
+	RTK_LOG_INFO,
+	RTK_LOG_DEBUG,
+};
+extern int model_log_level;
+#define RTK_LOGS(tag, level, fmt, ...)	do { \
+		if ((level) <= model_log_level) { \
+			fprintf(stderr, "[%s] " fmt, tag, ##__VA_ARGS__); \
+		} \
+	} while (0)
+#define RTK_LOGE(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_ERROR, fmt, ##__VA_ARGS__)
+#define RTK_LOGW(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_WARN, fmt, ##__VA_ARGS__)
+#define RTK_LOGI(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_INFO, fmt, ##__VA_ARGS__)
+
+#include "ameba_gdma.h"
+#include "ameba_sport.h"
+#include "ameba_audio.h"
+
+extern AUDIO_CODEC_TypeDef model_codec;
+#define AUDIO_REG_BASE			(&model_codec)
+#define AUDIO_REG_BASE_S		(&model_codec)
+#define TrustZone_IsSecure()	0
+
+#endif
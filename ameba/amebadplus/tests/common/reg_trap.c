@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Register side effects for host models. Drivers access registers as plain volatile
+ * struct members, so a FIFO data register or a level register that counts by itself
+ * cannot be a variable. The register page is mapped without access instead, each load
+ * or store faults, and the handler decodes the instruction, calls the model and steps
+ * over it. x86-64 only, and only the moves gcc emits for volatile 32 bit accesses:
+ * mov r32, m32 / mov m32, r32 / mov m32, imm32. Anything else aborts with its opcode.
+ */
+
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include "reg_trap.h"
+
+uint64_t reg_trap_cnt;
+
+static uint8_t *reg_trap_page;
+static REG_TRAP_READ reg_trap_read;
+static REG_TRAP_WRITE reg_trap_write;
+
+/* ModRM reg field, REX.R extended, to the saved register */
+static const int reg_trap_gregs[16] = {
+	REG_RAX, REG_RCX, REG_RDX, REG_RBX, REG_RSP, REG_RBP, REG_RSI, REG_RDI,
+	REG_R8, REG_R9, REG_R10, REG_R11, REG_R12, REG_R13, REG_R14, REG_R15,
+};
+
+static void reg_trap_handler(int Sig, siginfo_t *Info, void *Ctx)
+{
+	ucontext_t *uc = (ucontext_t *)Ctx;
+	greg_t *gregs = uc->uc_mcontext.gregs;
+	uint8_t *ip = (uint8_t *)gregs[REG_RIP];
+	uint8_t *addr = (uint8_t *)Info->si_addr;
+	uint32_t len = 0;
+	uint32_t rex = 0;
+	uint32_t op;
+	uint32_t modrm;
+	uint32_t mod;
+	uint32_t rm;
+	uint32_t reg;
+
+	if ((addr < reg_trap_page) || (addr >= reg_trap_page + REG_TRAP_PAGE_SIZE)) {
+		/* a real fault, let it kill the program where it happened */
+		signal(Sig, SIG_DFL);
+		return;
+	}
+
+	if ((ip[len] & 0xF0) == 0x40) {
+		rex = ip[len++];
+	}
+	op = ip[len++];
+	modrm = ip[len++];
+	mod = modrm >> 6;
+	rm = modrm & 7;
+	reg = ((modrm >> 3) & 7) | ((rex & 0x4) << 1);
+
+	if ((mod != 3) && (rm == 4)) {
+		/* SIB, with disp32 and no base */
+		if ((mod == 0) && ((ip[len] & 7) == 5)) {
+			len += 4;
+		}
+		len++;
+	}
+	if (mod == 1) {
+		len += 1;
+	} else if ((mod == 2) || ((mod == 0) && (rm == 5))) {
+		len += 4;
+	}
+
+	if ((rex & 0x8) || (mod == 3) ||
+		((op != 0x8B) && (op != 0x89) && (op != 0xC7))) {
+		fprintf(stderr, "reg_trap: unsupported access %02x %02x %02x at %p\n", rex, op, modrm, ip);
+		abort();
+	}
+
+	reg_trap_cnt++;
+	if (op == 0x8B) {
+		/* a 32 bit load clears the upper half */
+		gregs[reg_trap_gregs[reg]] = reg_trap_read(addr - reg_trap_page);
+	} else if (op == 0x89) {
+		reg_trap_write(addr - reg_trap_page, (uint32_t)gregs[reg_trap_gregs[reg]]);
+	} else {
+		reg_trap_write(addr - reg_trap_page, *(uint32_t *)(ip + len));
+		len += 4;
+	}
+
+	gregs[REG_RIP] += len;
+}
+
+void reg_trap_init(void *Page, REG_TRAP_READ Read, REG_TRAP_WRITE Write)
+{
+	struct sigaction sa;
+
+	reg_trap_page = (uint8_t *)Page;
+	reg_trap_read = Read;
+	reg_trap_write = Write;
+
+	sa.sa_sigaction = reg_trap_handler;
+	sa.sa_flags = SA_SIGINFO;
+	sigemptyset(&sa.sa_mask);
+	sigaction(SIGSEGV, &sa, NULL);
+
+	if (mprotect(Page, REG_TRAP_PAGE_SIZE, PROT_NONE)) {
+		perror("reg_trap: mprotect");
+		exit(1);
+	}
+}
@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _REG_TRAP_H_
+#define _REG_TRAP_H_
+
+#include <stdint.h>
+
+/* a 32 bit access at byte Offset of the trapped page */
+typedef uint32_t (*REG_TRAP_READ)(uint32_t Offset);
+typedef void (*REG_TRAP_WRITE)(uint32_t Offset, uint32_t Value);
+
+#define REG_TRAP_PAGE_SIZE	4096
+
+/* Page (REG_TRAP_PAGE_SIZE aligned, nothing else on it) is made inaccessible and every
+load or store the driver does on it is handed to Read or Write instead */
+void reg_trap_init(void *Page, REG_TRAP_READ Read, REG_TRAP_WRITE Write);
+
+/* loads and stores trapped so far */
+extern uint64_t reg_trap_cnt;
+
+#endif
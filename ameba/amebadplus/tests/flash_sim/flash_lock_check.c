@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Two core model of the flash lock handshake: ameba_flash_ram.c is built for KM4 and,
+ * with its symbols renamed to km0_*, for KM0, whose FLASH_Write_IPC_Int runs as the peer
+ * interrupt some time after KM4 sent the request (see model_peer_raise). KM4 waits for it
+ * in WFE, woken by the SEV of KM0 or by its own systick.
+ *
+ * Checks that a handshake costs the latency of KM0 and not a systick, that an SEV before
+ * WFE is not lost, and that a dead KM0 fails FLASH_Write_Lock after FLASH_SYNC_TIMEOUT_US
+ * instead of hanging, with flash, sema and scheduler left as they were.
+ *
+ *   flash_lock_check	exit status is non-zero on any failure
+ */
+
+#include <stdlib.h>
+#include "flash_model.h"
+#include "os_wrapper.h"
+
+/* KM0 build of ameba_flash_ram.c */
+void km0_FLASH_Write_IPC_Int(void *Data, u32 IrqStatus, u32 ChanNum);
+u32 km0_FLASH_Write_IPC_GetMaxIrqOff(void);
+
+static u32 fail;
+
+#define CHECK(expr)	do { \
+		if (!(expr)) { \
+			printf("flash_lock: %s:%d check failed: %s\n", __FILE__, __LINE__, #expr); \
+			fail++; \
+		} \
+	} while (0)
+
+/* interrupt latency of KM0, and how many requests it answers before it dies */
+static u32 km0_latency_us;
+static u32 km0_answer_left = 0xFFFFFFFF;
+
+static void km0_ipc_irq(void)
+{
+	km0_FLASH_Write_IPC_Int(NULL, 0, IPC_A2N_FLASHPG_REQ);
+}
+
+/* how long ipc_send_message waits for a full channel */
+#define IPC_IDLE_TIMEOUT_US	10000
+
+/* KM4 side of the channel, full till KM0 takes the message */
+u32 ipc_send_message(u32 IPC_Dir, u8 IPC_ChNum, PIPC_MSG_STRUCT IPC_Msg)
+{
+	u32 start = DTimestamp_Get();
+
+	assert((IPC_Dir == IPC_KM4_TO_KM0) && (IPC_ChNum == IPC_A2N_FLASHPG_REQ));
+
+	while (model_peer_pending()) {
+		if (DTimestamp_Get() - start > IPC_IDLE_TIMEOUT_US) {
+			return IPC_SEND_TIMEOUT;
+		}
+		model_advance_us(1);
+	}
+
+	model_ipc_msg = *IPC_Msg;
+
+	if (km0_answer_left == 0) {
+		model_peer_raise(km0_ipc_irq, MODEL_PEER_DEAD);
+	} else {
+		km0_answer_left--;
+		model_peer_raise(km0_ipc_irq, km0_latency_us);
+	}
+
+	return IPC_SEND_SUCCESS;
+}
+
+static u32 hist_sum(void)
+{
+	u32 hist[FLASH_LOCK_HIST_NUM];
+	u32 sum = 0;
+	u32 i;
+
+	FLASH_Write_Lock_GetHist(hist);
+	for (i = 0; i < FLASH_LOCK_HIST_NUM; i++) {
+		sum += hist[i];
+	}
+
+	return sum;
+}
+
+/* KM0 answers after latency_us, return the time of one lock/unlock pair around a RDID */
+static u32 check_latency(u32 latency_us)
+{
+	u8 id[3];
+	u8 data[NOR_PAGE_SIZE];
+	u32 hist = hist_sum();
+	u32 rounds = 16;
+	u32 tick;
+	u64 start;
+	u32 pair_us;
+	u32 i;
+
+	model_nor_init(NOR_GD, 0);
+	km0_latency_us = latency_us;
+	km0_answer_left = 0xFFFFFFFF;
+
+	start = model_now_us();
+	for (i = 0; i < rounds; i++) {
+		FLASH_RxCmdXIP(FLASH_CMD_RDID, 3, id);
+		CHECK((id[0] == 0xC8) && (id[1] == 0x40) && (id[2] == 0x16));
+	}
+	pair_us = (model_now_us() - start) / rounds;
+
+	printf("flash_lock: %8u | %8u us | %8.2f %8.2f %8.2f\n", latency_us, pair_us,
+		   (double)model_stat.wfe_cnt / (2 * rounds), (double)model_stat.wfe_sleep / (2 * rounds),
+		   (double)model_stat.wfe_tick_wake / (2 * rounds));
+
+	/* woken by KM0, not by the systick */
+	CHECK(pair_us <= 2 * latency_us + 4);
+	CHECK(model_stat.sev_cnt == 2 * rounds);
+	CHECK(model_stat.wfe_sleep - model_stat.wfe_tick_wake <= 2 * rounds);
+	CHECK(model_stat.wfe_tick_wake <= 2 * rounds * (latency_us / MODEL_SYSTICK_US + 1));
+	CHECK(hist_sum() - hist == 2 * rounds);
+	if (latency_us == 0) {
+		/* KM0 ran between the flag read and WFE, the latched event must end WFE at once */
+		CHECK(model_stat.wfe_sleep == 0);
+	}
+
+	/* data and the KM0 tick catch-up still work through the handshake */
+	memset(data, 0x5A, sizeof(data));
+	CHECK(FLASH_WriteStream(0x1000, sizeof(data), data) == 1);
+	CHECK(memcmp(model_nor_image() + 0x1000, data, sizeof(data)) == 0);
+
+	model_timer_task();
+	tick = model_kernel_tick;
+	FLASH_EraseXIP(EraseSector, 0x1000);
+	model_timer_task();
+	CHECK(model_nor_image()[0x1000] == 0xFF);
+	/* one tick is left to the tick interrupt, KM0 measures from its lock to its unlock interrupt */
+	CHECK(model_kernel_tick - tick + 2 >= nor_parts[NOR_GD].t_se_us[0] / 1000);
+	CHECK(model_kernel_tick - tick <= (nor_parts[NOR_GD].t_se_us[0] + latency_us) / 1000 + 1);
+
+	return pair_us;
+}
+
+/* KM0 answers answer requests, then no more */
+static void check_dead(u32 answer)
+{
+	u8 data[NOR_PAGE_SIZE];
+	u32 hist = hist_sum();
+	u64 start;
+	u64 took;
+	int ret;
+
+	model_nor_init(NOR_GD, 0);
+	km0_latency_us = 5;
+	km0_answer_left = answer;
+	memset(data, 0x00, sizeof(data));
+
+	start = model_now_us();
+	ret = FLASH_WriteStream(0x2000, sizeof(data), data);
+	took = model_now_us() - start;
+
+	if (answer == 0) {
+		/* lock failed, nothing written */
+		printf("flash_lock: KM0 dead on lock, FLASH_WriteStream %d after %llu us, %u WFE sleeps\n",
+			   ret, took, model_stat.wfe_sleep);
+		CHECK(ret == 0);
+		CHECK(model_stat.prog_cnt == 0);
+		CHECK(model_nor_image()[0x2000] == 0xFF);
+		CHECK(hist_sum() == hist);
+	} else {
+		/* unlock lost only the tick compensation of KM0 */
+		printf("flash_lock: KM0 dead on unlock, FLASH_WriteStream %d after %llu us, %u WFE sleeps\n",
+			   ret, took, model_stat.wfe_sleep);
+		CHECK(ret == 1);
+		CHECK(memcmp(model_nor_image() + 0x2000, data, sizeof(data)) == 0);
+		CHECK(hist_sum() == hist + 1);
+	}
+	CHECK(took > FLASH_SYNC_TIMEOUT_US);
+	CHECK(took <= FLASH_SYNC_TIMEOUT_US + MODEL_SYSTICK_US + 10);
+	/* a systick per check of the timeout, no spinning */
+	CHECK(model_stat.wfe_sleep <= FLASH_SYNC_TIMEOUT_US / MODEL_SYSTICK_US + 1 + answer);
+
+	/* the request is still in the channel, the next lock fails when the send times out */
+	start = model_now_us();
+	FLASH_EraseXIP(EraseSector, 0x2000);
+	took = model_now_us() - start;
+	CHECK((took > IPC_IDLE_TIMEOUT_US) && (took <= IPC_IDLE_TIMEOUT_US + 10));
+	CHECK(model_stat.erase_cnt[EraseSector] == 0);
+
+	/* KM0 takes the old request late, after that locks work again; the sema and the scheduler
+	were released on failure, or the model would assert on the next take */
+	model_peer_revive(5);
+	km0_answer_left = 0xFFFFFFFF;
+	FLASH_EraseXIP(EraseSector, 0x2000);
+	CHECK(model_stat.erase_cnt[EraseSector] == 1);
+	CHECK(model_nor_image()[0x2000] == 0xFF);
+	model_timer_task();
+}
+
+int main(void)
+{
+	static const u32 latency_us[] = {0, 2, 20, 200, 2000};
+	u32 i;
+
+	model_log_level = RTK_LOG_NONE;
+
+	printf("flash_lock: KM4 waits for KM0 in WFE, per handshake:\n");
+	printf("flash_lock: %8s | %11s | %8s %8s %8s\n", "KM0 us", "lock+unlock", "WFE", "sleeps", "by tick");
+
+	for (i = 0; i < sizeof(latency_us) / sizeof(latency_us[0]); i++) {
+		check_latency(latency_us[i]);
+	}
+	printf("flash_lock: KM0 max irq-off %u us\n", km0_FLASH_Write_IPC_GetMaxIrqOff());
+
+	check_dead(0);
+	check_dead(1);
+
+	if (fail) {
+		printf("flash_lock: FAIL (%u)\n", fail);
+		return 1;
+	}
+
+	printf("flash_lock: handshake woken by KM0, dead KM0 fails the lock in time\n");
+	return 0;
+}
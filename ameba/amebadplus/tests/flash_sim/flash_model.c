@@ -0,0 +1,773 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host model of a SPI NOR flash behind SPIC, the ROM functions ameba_flash_ram.c calls
+ * on top of it, and the rest of the platform it needs for one core and one task.
+ *
+ * The flash takes program, erase and write status commands only after write enable,
+ * programs by AND and wraps inside the page like the real part, and is busy for the
+ * datasheet time of the vendor. Program and erase are applied when the busy time is
+ * over, a suspend freezes them. Time is virtual: it moves by the busy time of the flash
+ * (the ROM functions poll status until it is done) and a little on each timestamp read.
+ */
+
+#include <stdlib.h>
+#include <sys/mman.h>
+#include "flash_model.h"
+#include "os_wrapper.h"
+
+const struct nor_part nor_parts[NOR_VENDOR_NUM] = {
+	[NOR_GD] = {
+		.name = "GD25Q32",
+		.id = 0xC84016,
+		.t_pp_us = {600, 2400},
+		.t_se_us = {50000, 400000},
+		.t_be_us = {220000, 1200000},
+		.t_ce_ms = {10000, 25000},
+		.cmd_suspend = 0x75,
+		.cmd_resume = 0x7A,
+	},
+	[NOR_MXIC] = {
+		.name = "MX25L3233F",
+		.id = 0xC22016,
+		.t_pp_us = {500, 3000},
+		.t_se_us = {35000, 200000},
+		.t_be_us = {270000, 2000000},
+		.t_ce_ms = {13000, 50000},
+		.cmd_suspend = 0xB0,
+		.cmd_resume = 0x30,
+	},
+	[NOR_MICRON] = {
+		.name = "MT25QL32",
+		.id = 0x20BA16,
+		.t_pp_us = {120, 1800},
+		.t_se_us = {50000, 400000},
+		.t_be_us = {150000, 1000000},
+		.t_ce_ms = {15000, 60000},
+		.cmd_suspend = 0x75,
+		.cmd_resume = 0x7A,
+	},
+};
+
+struct model_stat model_stat;
+u32 model_dcache_ops;
+int model_log_level = RTK_LOG_NONE;
+FLASH_InitTypeDef flash_init_para;
+
+/* one status read on the bus, and one timestamp read of the cpu */
+#define MODEL_POLL_NS		1000
+#define MODEL_TIMESTAMP_NS	100
+/* write status register busy time */
+#define MODEL_T_W_US		5000
+
+enum {
+	NOR_OP_NONE,
+	NOR_OP_PROGRAM,
+	NOR_OP_ERASE,
+	NOR_OP_STATUS,
+};
+
+static struct {
+	const struct nor_part *part;
+	u32 worst;
+	u8 *image;
+	u32 wel;
+	u8 status;
+	/* operation in progress */
+	u32 op;
+	u32 addr;
+	u32 len;
+	u8 data[NOR_PAGE_SIZE];
+	u64 done_ns;
+	u64 left_ns;		/* time left while suspended */
+	u32 suspended;
+} nor;
+
+static u64 model_time_ns;
+static u32 model_irq_depth;
+static u64 model_irq_off_start;
+static u32 model_sched_depth;
+static u32 model_sem_taken;
+
+/* the other core, and the event register of this one */
+static struct {
+	void (*handler)(void);
+	u64 due_ns;
+	u32 pending;
+	u32 dead;
+} peer;
+static u32 model_event;
+
+u64 model_now_us(void)
+{
+	return model_time_ns / 1000;
+}
+
+void model_advance_us(u32 us)
+{
+	model_time_ns += (u64)us * 1000;
+}
+
+u8 *model_nor_image(void)
+{
+	return nor.image;
+}
+
+/* finish the operation in progress if its time is over */
+static void nor_update(void)
+{
+	u32 i;
+
+	if ((nor.op == NOR_OP_NONE) || nor.suspended || (model_time_ns < nor.done_ns)) {
+		return;
+	}
+
+	if (nor.op == NOR_OP_PROGRAM) {
+		for (i = 0; i < nor.len; i++) {
+			/* the address counter wraps inside the page */
+			u32 a = (nor.addr & ~(NOR_PAGE_SIZE - 1)) | ((nor.addr + i) & (NOR_PAGE_SIZE - 1));
+
+			if (nor.data[i] & ~nor.image[a]) {
+				model_stat.one_bits++;
+			}
+			nor.image[a] &= nor.data[i];
+		}
+	} else if (nor.op == NOR_OP_ERASE) {
+		memset(nor.image + nor.addr, 0xFF, nor.len);
+	}
+
+	nor.op = NOR_OP_NONE;
+	nor.wel = 0;
+}
+
+void model_nor_settle(void)
+{
+	if ((nor.op != NOR_OP_NONE) && !nor.suspended && (model_time_ns < nor.done_ns)) {
+		model_time_ns = nor.done_ns;
+	}
+	nor_update();
+}
+
+static u32 nor_busy(void)
+{
+	nor_update();
+
+	return (nor.op != NOR_OP_NONE) && !nor.suspended;
+}
+
+static void nor_start(u32 op, u32 addr, u32 len, u64 busy_us)
+{
+	nor.op = op;
+	nor.addr = addr;
+	nor.len = len;
+	nor.done_ns = model_time_ns + busy_us * 1000;
+}
+
+void model_nor_init(u32 vendor, u32 worst)
+{
+	assert(vendor < NOR_VENDOR_NUM);
+
+	if (nor.image == NULL) {
+		nor.image = mmap((void *)SPI_FLASH_BASE, NOR_SIZE, PROT_READ | PROT_WRITE,
+						 MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+		assert(nor.image == (u8 *)SPI_FLASH_BASE);
+	}
+
+	memset(nor.image, 0xFF, NOR_SIZE);
+	nor.part = &nor_parts[vendor];
+	nor.worst = worst ? 1 : 0;
+	nor.op = NOR_OP_NONE;
+	nor.suspended = 0;
+	nor.wel = 0;
+	nor.status = 0;
+
+	memset(&flash_init_para, 0, sizeof(flash_init_para));
+	flash_init_para.FLASH_Id = (vendor == NOR_GD) ? FLASH_ID_GD : (vendor == NOR_MXIC) ? FLASH_ID_MXIC : FLASH_ID_MICRON;
+	flash_init_para.FLASH_cur_cmd = FLASH_CMD_READ;
+	flash_init_para.FLASH_Busy_bit = FLASH_STATUS_BUSY;
+	flash_init_para.FLASH_WLE_bit = FLASH_STATUS_WLE;
+	flash_init_para.FLASH_cmd_wr_en = FLASH_CMD_WREN;
+	flash_init_para.FLASH_cmd_rd_id = FLASH_CMD_RDID;
+	flash_init_para.FLASH_cmd_rd_status = FLASH_CMD_RDSR;
+	flash_init_para.FLASH_cmd_wr_status = FLASH_CMD_WRSR;
+	flash_init_para.FLASH_cmd_chip_e = FLASH_CMD_CE;
+	flash_init_para.FLASH_cmd_block_e = FLASH_CMD_BE;
+	flash_init_para.FLASH_cmd_sector_e = FLASH_CMD_SE;
+
+	memset(&model_stat, 0, sizeof(model_stat));
+	model_time_ns = 0;
+	memset(&peer, 0, sizeof(peer));
+	model_event = 0;
+}
+
+/* Platform ------------------------------------------------------------------*/
+
+u32 SYS_CPUID(void)
+{
+	return 0;
+}
+
+u32 CPU_InInterrupt(void)
+{
+	return 0;
+}
+
+static void model_irq_off(void)
+{
+	if (model_irq_depth++ == 0) {
+		model_irq_off_start = model_time_ns;
+	}
+}
+
+static void model_irq_on(void)
+{
+	u32 us;
+
+	assert(model_irq_depth > 0);
+	if (--model_irq_depth) {
+		return;
+	}
+
+	us = (model_time_ns - model_irq_off_start) / 1000;
+	model_stat.irq_off_cnt++;
+	model_stat.irq_off_us += us;
+	if (us > model_stat.irq_off_max_us) {
+		model_stat.irq_off_max_us = us;
+	}
+}
+
+u32 irq_disable_save(void)
+{
+	model_irq_off();
+
+	return 0;
+}
+
+void irq_enable_restore(u32 PrevStatus)
+{
+	(void)PrevStatus;
+
+	model_irq_on();
+}
+
+void __disable_irq(void)
+{
+	model_irq_off();
+}
+
+void __enable_irq(void)
+{
+	model_irq_on();
+}
+
+/* other core ----------------------------------------------------------------*/
+
+void model_peer_raise(void (*handler)(void), u32 delay_us)
+{
+	assert(peer.pending == 0);
+
+	peer.handler = handler;
+	peer.pending = 1;
+	peer.dead = (delay_us == MODEL_PEER_DEAD);
+	peer.due_ns = peer.dead ? 0 : model_time_ns + (u64)delay_us * 1000;
+}
+
+u32 model_peer_pending(void)
+{
+	return peer.pending;
+}
+
+void model_peer_revive(u32 delay_us)
+{
+	peer.dead = 0;
+	peer.due_ns = model_time_ns + (u64)delay_us * 1000;
+}
+
+/* run the handler of the peer if its time has come */
+static void model_peer_run(void)
+{
+	if (!peer.pending || peer.dead || (model_time_ns < peer.due_ns)) {
+		return;
+	}
+
+	/* the handler reads the timestamp too */
+	peer.pending = 0;
+	peer.handler();
+}
+
+void __SEV(void)
+{
+	model_stat.sev_cnt++;
+	model_event = 1;
+}
+
+/* sleep till the event of the peer or, with irq enabled, the next systick */
+void __WFE(void)
+{
+	u64 wake = UINT64_MAX;
+	u64 tick;
+
+	model_stat.wfe_cnt++;
+
+	if (model_event) {
+		model_event = 0;
+		return;
+	}
+
+	model_stat.wfe_sleep++;
+	if (peer.pending && !peer.dead) {
+		wake = peer.due_ns;
+	}
+	if (model_irq_depth == 0) {
+		tick = (model_time_ns / (MODEL_SYSTICK_US * 1000) + 1) * (MODEL_SYSTICK_US * 1000);
+		if (tick < wake) {
+			wake = tick;
+			model_stat.wfe_tick_wake++;
+		}
+	}
+
+	/* irq off and nothing from the peer, the core would sleep forever */
+	assert(wake != UINT64_MAX);
+
+	if (wake > model_time_ns) {
+		model_time_ns = wake;
+	}
+	model_peer_run();
+	model_event = 0;
+}
+
+u32 DTimestamp_Get(void)
+{
+	model_time_ns += MODEL_TIMESTAMP_NS;
+	model_peer_run();
+
+	return (u32)(model_time_ns / 1000);
+}
+
+/* 32768Hz, the 31us tick */
+u32 SYSTIMER_TickGet(void)
+{
+	return (u32)(model_time_ns * 32768 / 1000000000);
+}
+
+u32 SYSTIMER_GetPassTick(u32 start)
+{
+	return SYSTIMER_TickGet() - start;
+}
+
+u32 SYSTIMER_GetPassTime(u32 start)
+{
+	return (u32)((u64)SYSTIMER_GetPassTick(start) * 1000 / 32768);
+}
+
+u32 IPC_SEMTake(u32 SEM_Idx, u32 timeout)
+{
+	(void)timeout;
+
+	/* one core, taking it twice would hang */
+	assert((model_sem_taken & BIT(SEM_Idx)) == 0);
+	model_sem_taken |= BIT(SEM_Idx);
+
+	return TRUE;
+}
+
+u32 IPC_SEMFree(u32 SEM_Idx)
+{
+	assert(model_sem_taken & BIT(SEM_Idx));
+	model_sem_taken &= ~BIT(SEM_Idx);
+
+	return TRUE;
+}
+
+void rtos_sched_suspend(void)
+{
+	model_sched_depth++;
+}
+
+void rtos_sched_resume(void)
+{
+	assert(model_sched_depth > 0);
+	model_sched_depth--;
+}
+
+int rtos_sema_create_binary(rtos_sema_t *pp_handle)
+{
+	*pp_handle = calloc(1, sizeof(u32));
+
+	return (*pp_handle != NULL) ? RTK_SUCCESS : RTK_FAIL;
+}
+
+int rtos_sema_take(rtos_sema_t p_handle, u32 wait_ms)
+{
+	u32 *count = (u32 *)p_handle;
+
+	(void)wait_ms;
+
+	/* one task, nobody else could give it */
+	assert(*count > 0);
+	(*count)--;
+
+	return RTK_SUCCESS;
+}
+
+int rtos_sema_give(rtos_sema_t p_handle)
+{
+	u32 *count = (u32 *)p_handle;
+
+	*count = 1;
+
+	return RTK_SUCCESS;
+}
+
+/* kernel of the one core: the tick count, the cost of processing one tick, and a timer
+service task with a queue of pended functions run by model_timer_task. The tick interrupt
+itself is not modeled, ticks only move by the functions below. */
+u32 model_kernel_tick;
+u32 model_tick_cost_us = 2;
+u32 model_timer_queue_len = 4;
+u32 model_crit_max_us;
+
+static struct {
+	void (*fn)(void *, u32);
+	void *param1;
+	u32 param2;
+} model_timer_queue[8];
+static u32 model_timer_queue_num;
+
+u32 xTaskIncrementTick(void)
+{
+	model_kernel_tick++;
+	model_advance_us(model_tick_cost_us);
+
+	return 0;
+}
+
+u32 xTaskGetTickCountFromISR(void)
+{
+	return model_kernel_tick;
+}
+
+/* the kernel processes pended ticks one by one in a critical section, which masks the
+interrupts that use the kernel but not the ones above it, so it is timed apart */
+u32 xTaskCatchUpTicks(u32 xTicksToCatchUp)
+{
+	u64 start = model_now_us();
+
+	assert(model_irq_depth == 0);
+
+	while (xTicksToCatchUp--) {
+		model_kernel_tick++;
+		model_advance_us(model_tick_cost_us);
+	}
+
+	if (model_now_us() - start > model_crit_max_us) {
+		model_crit_max_us = model_now_us() - start;
+	}
+
+	return 0;
+}
+
+u32 xTimerPendFunctionCallFromISR(void (*xFunctionToPend)(void *, u32), void *pvParameter1, u32 ulParameter2, u32 *pxHigherPriorityTaskWoken)
+{
+	(void)pxHigherPriorityTaskWoken;
+
+	if (model_timer_queue_num >= MIN(model_timer_queue_len, 8)) {
+		return FALSE;
+	}
+
+	model_timer_queue[model_timer_queue_num].fn = xFunctionToPend;
+	model_timer_queue[model_timer_queue_num].param1 = pvParameter1;
+	model_timer_queue[model_timer_queue_num].param2 = ulParameter2;
+	model_timer_queue_num++;
+
+	return TRUE;
+}
+
+u32 model_timer_task(void)
+{
+	u32 num = model_timer_queue_num;
+	u32 i;
+
+	for (i = 0; i < num; i++) {
+		model_timer_queue[i].fn(model_timer_queue[i].param1, model_timer_queue[i].param2);
+	}
+	model_timer_queue_num = 0;
+
+	return num;
+}
+
+/* IPC of the KM0 build, flash_lock_check.c models the KM4 side */
+IPC_MSG_STRUCT model_ipc_msg;
+
+PIPC_MSG_STRUCT ipc_get_message(u32 IPC_Dir, u8 IPC_ChNum)
+{
+	(void)IPC_Dir;
+	(void)IPC_ChNum;
+
+	return &model_ipc_msg;
+}
+
+void IPC_TXHandler(void *Data, u32 IrqStatus, u32 ChanNum)
+{
+	(void)Data;
+	(void)IrqStatus;
+	(void)ChanNum;
+}
+
+/* GDMA: no channel, bulk reads take the SPIC user mode path */
+u8 GDMA_ChnlAlloc(u32 GDMA_Index, IRQ_FUN IrqFun, u32 IrqData, u32 IrqPriority)
+{
+	(void)GDMA_Index;
+	(void)IrqFun;
+	(void)IrqData;
+	(void)IrqPriority;
+
+	return 0xFF;
+}
+
+u8 GDMA_ChnlFree(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	(void)GDMA_Index;
+	(void)GDMA_ChNum;
+
+	return 0;
+}
+
+void GDMA_StructInit(PGDMA_InitTypeDef GDMA_InitStruct)
+{
+	memset(GDMA_InitStruct, 0, sizeof(*GDMA_InitStruct));
+}
+
+void GDMA_Init(u8 GDMA_Index, u8 GDMA_ChNum, PGDMA_InitTypeDef GDMA_InitStruct)
+{
+	(void)GDMA_Index;
+	(void)GDMA_ChNum;
+	(void)GDMA_InitStruct;
+	assert(0);
+}
+
+void GDMA_Cmd(u8 GDMA_Index, u8 GDMA_ChNum, u32 NewState)
+{
+	(void)GDMA_Index;
+	(void)GDMA_ChNum;
+	(void)NewState;
+	assert(0);
+}
+
+u32 GDMA_ClearINT(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	(void)GDMA_Index;
+	(void)GDMA_ChNum;
+	assert(0);
+
+	return 0;
+}
+
+void GDMA_INTConfig(u8 GDMA_Index, u8 GDMA_ChNum, u32 GDMA_IT, u32 NewState)
+{
+	(void)GDMA_Index;
+	(void)GDMA_ChNum;
+	(void)GDMA_IT;
+	(void)NewState;
+	assert(0);
+}
+
+u8 GDMA_Abort(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	(void)GDMA_Index;
+	(void)GDMA_ChNum;
+	assert(0);
+
+	return 0;
+}
+
+/* SPIC commands -------------------------------------------------------------*/
+
+static u32 nor_addr(u8 *pData)
+{
+	return ((u32)pData[0] << 16) | ((u32)pData[1] << 8) | pData[2];
+}
+
+void FLASH_TxCmd(u8 cmd, u8 DataPhaseLen, u8 *pData)
+{
+	const struct nor_part *part = nor.part;
+	u32 busy = nor_busy();
+	u32 addr;
+
+	if ((cmd == part->cmd_suspend) && busy && ((nor.op == NOR_OP_PROGRAM) || (nor.op == NOR_OP_ERASE))) {
+		nor.left_ns = nor.done_ns - model_time_ns;
+		nor.suspended = 1;
+		model_stat.suspend_cnt++;
+		/* tSUS */
+		model_advance_us(20);
+		return;
+	}
+
+	if ((cmd == part->cmd_resume) && nor.suspended) {
+		nor.suspended = 0;
+		nor.done_ns = model_time_ns + nor.left_ns;
+		return;
+	}
+
+	if (busy || nor.suspended) {
+		/* only program and read are allowed in erase suspend, the model allows none */
+		model_stat.cmd_busy++;
+		return;
+	}
+
+	if (cmd == FLASH_CMD_WREN) {
+		nor.wel = 1;
+		return;
+	}
+
+	if (cmd == FLASH_CMD_WRDI) {
+		nor.wel = 0;
+		return;
+	}
+
+	if ((cmd != FLASH_CMD_WRSR) && (cmd != FLASH_CMD_SE) && (cmd != FLASH_CMD_BE) &&
+		(cmd != FLASH_CMD_CE) && (cmd != 0xC7)) {
+		return;
+	}
+
+	if (nor.wel == 0) {
+		model_stat.no_wren++;
+		return;
+	}
+
+	if (cmd == FLASH_CMD_WRSR) {
+		nor.status = (DataPhaseLen ? pData[0] : 0) & ~(FLASH_STATUS_BUSY | FLASH_STATUS_WLE);
+		nor_start(NOR_OP_STATUS, 0, 0, MODEL_T_W_US);
+		return;
+	}
+
+	if (cmd == FLASH_CMD_SE) {
+		addr = nor_addr(pData) & ~(NOR_SECTOR_SIZE - 1);
+		nor_start(NOR_OP_ERASE, addr, NOR_SECTOR_SIZE, part->t_se_us[nor.worst]);
+		model_stat.erase_cnt[EraseSector]++;
+	} else if (cmd == FLASH_CMD_BE) {
+		addr = nor_addr(pData) & ~(NOR_BLOCK_SIZE - 1);
+		nor_start(NOR_OP_ERASE, addr, NOR_BLOCK_SIZE, part->t_be_us[nor.worst]);
+		model_stat.erase_cnt[EraseBlock]++;
+	} else {
+		nor_start(NOR_OP_ERASE, 0, NOR_SIZE, (u64)part->t_ce_ms[nor.worst] * 1000);
+		model_stat.erase_cnt[EraseChip]++;
+	}
+}
+
+void FLASH_RxCmd(u8 cmd, u32 read_len, u8 *read_data)
+{
+	u32 id = nor.part->id;
+	u32 i;
+
+	memset(read_data, 0, read_len);
+
+	if (cmd == FLASH_CMD_RDSR) {
+		model_time_ns += MODEL_POLL_NS;
+		model_stat.status_poll++;
+		if (read_len) {
+			read_data[0] = nor.status | (nor_busy() ? FLASH_STATUS_BUSY : 0) | (nor.wel ? FLASH_STATUS_WLE : 0);
+		}
+	} else if (cmd == FLASH_CMD_RDID) {
+		for (i = 0; (i < read_len) && (i < 3); i++) {
+			read_data[i] = (u8)(id >> (16 - 8 * i));
+		}
+	}
+}
+
+/* ROM functions on the commands -----------------------------------------------*/
+
+void FLASH_WaitBusy_InUserMode(u32 WaitType)
+{
+	u8 status;
+
+	(void)WaitType;
+
+	do {
+		FLASH_RxCmd(flash_init_para.FLASH_cmd_rd_status, 1, &status);
+	} while (status & flash_init_para.FLASH_Busy_bit);
+}
+
+void FLASH_TxData(u32 StartAddr, u32 DataPhaseLen, u8 *pData)
+{
+	u32 busy_us;
+
+	assert(DataPhaseLen <= NOR_PAGE_SIZE);
+
+	FLASH_TxCmd(flash_init_para.FLASH_cmd_wr_en, 0, NULL);
+
+	if (nor_busy() || nor.suspended) {
+		model_stat.cmd_busy++;
+		return;
+	}
+	if (nor.wel == 0) {
+		model_stat.no_wren++;
+		return;
+	}
+
+	if ((StartAddr & (NOR_PAGE_SIZE - 1)) + DataPhaseLen > NOR_PAGE_SIZE) {
+		model_stat.page_wrap++;
+	}
+
+	memcpy(nor.data, pData, DataPhaseLen);
+	/* tPP is for a full page, shorter programs are quicker, not below 1/8 of it */
+	busy_us = (u64)nor.part->t_pp_us[nor.worst] * MAX(DataPhaseLen, NOR_PAGE_SIZE / 8) / NOR_PAGE_SIZE;
+	nor_start(NOR_OP_PROGRAM, StartAddr, DataPhaseLen, busy_us);
+	model_stat.prog_cnt++;
+	model_stat.prog_bytes += DataPhaseLen;
+
+	FLASH_WaitBusy_InUserMode(WAIT_WRITE_DONE);
+}
+
+void FLASH_Erase(u32 EraseType, u32 Address)
+{
+	u8 addr[3] = {(u8)(Address >> 16), (u8)(Address >> 8), (u8)Address};
+	u8 cmd;
+
+	if (EraseType == EraseChip) {
+		cmd = flash_init_para.FLASH_cmd_chip_e;
+	} else if (EraseType == EraseBlock) {
+		cmd = flash_init_para.FLASH_cmd_block_e;
+	} else {
+		cmd = flash_init_para.FLASH_cmd_sector_e;
+	}
+
+	FLASH_TxCmd(flash_init_para.FLASH_cmd_wr_en, 0, NULL);
+	FLASH_TxCmd(cmd, (EraseType == EraseChip) ? 0 : 3, addr);
+	FLASH_WaitBusy_InUserMode(WAIT_FLASH_BUSY);
+}
+
+void FLASH_SetStatus(u8 Cmd, u32 Len, u8 *Status)
+{
+	FLASH_TxCmd(flash_init_para.FLASH_cmd_wr_en, 0, NULL);
+	FLASH_TxCmd(Cmd, Len, Status);
+	FLASH_WaitBusy_InUserMode(WAIT_FLASH_BUSY);
+}
+
+void FLASH_SetStatusBits(u32 SetBits, u32 NewState)
+{
+	u8 status;
+
+	FLASH_RxCmd(flash_init_para.FLASH_cmd_rd_status, 1, &status);
+	if (NewState == ENABLE) {
+		status |= (u8)SetBits;
+	} else {
+		status &= ~(u8)SetBits;
+	}
+	FLASH_SetStatus(flash_init_para.FLASH_cmd_wr_status, 1, &status);
+}
+
+void FLASH_RxData(u8 cmd, u32 StartAddr, u32 read_len, u8 *read_data)
+{
+	(void)cmd;
+
+	if (nor_busy()) {
+		model_stat.cmd_busy++;
+	}
+
+	memcpy(read_data, nor.image + StartAddr, read_len);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _FLASH_MODEL_H_
+#define _FLASH_MODEL_H_
+
+#include "ameba_soc.h"
+
+/* flash image mapped at SPI_FLASH_BASE */
+#define NOR_SIZE			0x400000
+#define NOR_PAGE_SIZE		0x100
+#define NOR_SECTOR_SIZE		0x1000
+#define NOR_BLOCK_SIZE		0x10000
+
+enum {
+	NOR_GD,
+	NOR_MXIC,
+	NOR_MICRON,
+	NOR_VENDOR_NUM,
+};
+
+/* typical and max times from the datasheets, tPP is for a full page */
+struct nor_part {
+	const char *name;
+	u32 id;				/* RDID bytes, manufacturer first */
+	u32 t_pp_us[2];
+	u32 t_se_us[2];		/* 4KB sector erase */
+	u32 t_be_us[2];		/* 64KB block erase */
+	u32 t_ce_ms[2];
+	u8 cmd_suspend;
+	u8 cmd_resume;
+};
+
+extern const struct nor_part nor_parts[NOR_VENDOR_NUM];
+
+struct model_stat {
+	u32 irq_off_cnt;		/* irq-off windows */
+	u64 irq_off_us;			/* total time irq was off */
+	u32 irq_off_max_us;		/* longest window */
+	u32 prog_cnt;			/* page program commands */
+	u64 prog_bytes;			/* bytes programmed */
+	u32 erase_cnt[3];		/* by EraseChip, EraseBlock, EraseSector */
+	u32 page_wrap;			/* programs that ran past the page end and wrapped */
+	u32 one_bits;			/* programs that asked for a 0 -> 1 bit, lost by AND */
+	u32 no_wren;			/* program or erase without write enable, ignored */
+	u32 cmd_busy;			/* commands other than status, suspend and resume while busy */
+	u32 status_poll;		/* status reads */
+	u32 suspend_cnt;
+	u32 wfe_cnt;			/* WFE executed */
+	u32 wfe_sleep;			/* WFE that slept, no event was latched */
+	u32 wfe_tick_wake;		/* sleeps ended by the systick, not by the peer */
+	u32 sev_cnt;
+};
+
+extern struct model_stat model_stat;
+
+/* fresh erased part of the vendor at time 0, use max instead of typical times if worst is set */
+void model_nor_init(u32 vendor, u32 worst);
+
+/* virtual time */
+u64 model_now_us(void);
+void model_advance_us(u32 us);
+
+/* run the pending program or erase to its end, as if the flash was left alone */
+void model_nor_settle(void);
+
+/* raw image, not through XIP */
+u8 *model_nor_image(void);
+
+/* kernel of KM0: tick count, time to process one tick, length of the timer queue, and the
+longest critical section of xTaskCatchUpTicks */
+extern u32 model_kernel_tick;
+extern u32 model_tick_cost_us;
+extern u32 model_timer_queue_len;
+extern u32 model_crit_max_us;
+
+/* run the functions pended to the timer service task, return how many */
+u32 model_timer_task(void);
+
+/* message ipc_get_message returns */
+extern IPC_MSG_STRUCT model_ipc_msg;
+
+/* The other core: handler runs as its interrupt delay_us after now, when the time of this core
+gets there in DTimestamp_Get or WFE. MODEL_PEER_DEAD never runs it. Only one can be pending. */
+#define MODEL_PEER_DEAD		0xFFFFFFFF
+void model_peer_raise(void (*handler)(void), u32 delay_us);
+u32 model_peer_pending(void);
+/* a dead peer wakes up and takes its pending interrupt delay_us after now */
+void model_peer_revive(u32 delay_us);
+
+/* period of the systick of this core, wakes WFE when irq is enabled */
+#define MODEL_SYSTICK_US	1000
+
+#endif
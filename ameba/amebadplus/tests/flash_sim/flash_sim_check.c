@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Runs the RAM flash functions of ameba_flash_ram.c on the NOR model of flash_model.c
+ * for GD, MXIC and Micron timings: erase, AND-only program, page wrap, the busy bit and
+ * suspend of the model itself, then stream write, bulk read and the write buffer through
+ * the driver, with the irq-off windows and bytes programmed they cost, and the write
+ * buffer timeout flush without a work queue.
+ *
+ *   flash_sim_check [worst]	exit status is non-zero on any failure
+ */
+
+#include <stdlib.h>
+#include "flash_model.h"
+#include "os_wrapper.h"
+
+static u32 fail;
+
+#define CHECK(expr)	do { \
+		if (!(expr)) { \
+			printf("flash_sim: %s:%d check failed: %s\n", __FILE__, __LINE__, #expr); \
+			fail++; \
+		} \
+	} while (0)
+
+static u8 pattern[0x3000];
+static u8 readback[0x3000 + CACHE_LINE_SIZE] ALIGNMTO(CACHE_LINE_SIZE);
+
+static u8 *xip(u32 addr)
+{
+	return (u8 *)(SPI_FLASH_BASE + addr);
+}
+
+static u32 all_ff(u32 addr, u32 len)
+{
+	u32 i;
+
+	for (i = 0; i < len; i++) {
+		if (xip(addr)[i] != 0xFF) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static u8 status_get(void)
+{
+	u8 status;
+
+	FLASH_RxCmd(FLASH_CMD_RDSR, 1, &status);
+
+	return status;
+}
+
+/* the model behaves like a NOR part */
+static void check_nor(u32 vendor, u32 worst)
+{
+	const struct nor_part *part = &nor_parts[vendor];
+	u8 addr[3] = {0x01, 0x00, 0x00};
+	u8 data[0x20];
+	u64 t;
+
+	model_nor_init(vendor, worst);
+
+	/* erase to 0xFF, busy for tSE */
+	memset(model_nor_image() + 0x3000, 0x5A, NOR_SECTOR_SIZE);
+	t = model_now_us();
+	FLASH_Erase(EraseSector, 0x3010);
+	t = model_now_us() - t;
+	CHECK(all_ff(0x3000, NOR_SECTOR_SIZE));
+	CHECK((t >= part->t_se_us[worst]) && (t <= part->t_se_us[worst] + 10));
+	CHECK(model_stat.status_poll >= part->t_se_us[worst]);
+
+	/* program can only clear bits */
+	memset(data, 0x0F, sizeof(data));
+	FLASH_TxData(0x3000, sizeof(data), data);
+	memset(data, 0xF0, sizeof(data));
+	FLASH_TxData(0x3000, sizeof(data), data);
+	CHECK(xip(0x3000)[0] == 0x00 && xip(0x3000)[0x1F] == 0x00 && xip(0x3000)[0x20] == 0xFF);
+	CHECK(model_stat.one_bits == sizeof(data));
+
+	/* a program past the page end wraps to the page start */
+	memset(data, 0xA5, sizeof(data));
+	FLASH_TxData(0x31F0, sizeof(data), data);
+	CHECK(xip(0x31FF)[0] == 0xA5 && xip(0x3200)[0] == 0xFF);
+	CHECK(xip(0x3100)[0x0F] == 0xA5 && xip(0x3110)[0] == 0xFF);
+	CHECK(model_stat.page_wrap == 1);
+
+	/* erase without write enable is ignored */
+	FLASH_TxCmd(FLASH_CMD_SE, 3, addr);
+	CHECK(model_stat.no_wren == 1);
+	CHECK((status_get() & FLASH_STATUS_BUSY) == 0);
+
+	/* busy bit, and commands while busy are dropped */
+	memset(model_nor_image() + 0x10000, 0x00, NOR_BLOCK_SIZE);
+	FLASH_TxCmd(FLASH_CMD_WREN, 0, NULL);
+	CHECK(status_get() & FLASH_STATUS_WLE);
+	FLASH_TxCmd(FLASH_CMD_BE, 3, addr);
+	CHECK(status_get() & FLASH_STATUS_BUSY);
+	FLASH_TxCmd(FLASH_CMD_WREN, 0, NULL);
+	CHECK(model_stat.cmd_busy == 1);
+
+	/* suspend the erase, the rest of the flash can be read, then resume */
+	model_advance_us(part->t_be_us[worst] / 2);
+	FLASH_TxCmd(part->cmd_suspend, 0, NULL);
+	CHECK((status_get() & FLASH_STATUS_BUSY) == 0);
+	CHECK(xip(0x3000)[0x20] == 0xFF);
+	model_advance_us(part->t_be_us[worst]);
+	CHECK(xip(0x10000)[0] == 0x00);
+	FLASH_TxCmd(part->cmd_resume, 0, NULL);
+	CHECK(status_get() & FLASH_STATUS_BUSY);
+	FLASH_WaitBusy_InUserMode(WAIT_FLASH_BUSY);
+	CHECK(all_ff(0x10000, NOR_BLOCK_SIZE));
+	CHECK(model_stat.suspend_cnt == 1);
+}
+
+/* stream write and bulk read through the driver */
+static void check_stream(u32 vendor, u32 worst)
+{
+	const struct nor_part *part = &nor_parts[vendor];
+	u32 addr = 0x20080;
+	u32 len = 0x2A0;
+	u32 pages = ((addr + len - 1) >> 8) - (addr >> 8) + 1;
+	u64 t;
+
+	model_nor_init(vendor, worst);
+
+	t = model_now_us();
+	FLASH_WriteStream(addr, len, pattern);
+	t = model_now_us() - t;
+	CHECK(memcmp(xip(addr), pattern, len) == 0);
+	CHECK(xip(addr - 1)[0] == 0xFF && xip(addr + len)[0] == 0xFF);
+	CHECK(model_stat.page_wrap == 0);
+	CHECK(model_stat.prog_cnt == pages);
+	CHECK(model_stat.prog_bytes == len);
+	/* one lock for all pages */
+	CHECK(model_stat.irq_off_cnt == 1);
+	CHECK(model_stat.irq_off_max_us + 1 >= t - 1 && t >= (u64)part->t_pp_us[worst] * 2);
+
+	FLASH_EraseXIP(EraseSector, 0x20000);
+	CHECK(all_ff(0x20000, NOR_SECTOR_SIZE));
+	CHECK(model_stat.irq_off_cnt == 2);
+	CHECK(model_stat.irq_off_max_us >= part->t_se_us[worst]);
+
+	/* no GDMA channel in the model, the bulk read goes through user mode in chunks */
+	memcpy(model_nor_image() + 0x40000, pattern, sizeof(pattern));
+	memset(&model_stat, 0, sizeof(model_stat));
+	CHECK(FLASH_ReadStreamBulk(0x40003, 0x2801, readback + 5) == 1);
+	CHECK(memcmp(readback + 5, pattern + 3, 0x2801) == 0);
+	CHECK(model_stat.irq_off_cnt == (0x2801 - 0x20) / FLASH_BULK_READ_USER_CHUNK + 1);
+}
+
+/* small sequential writes through the page buffer against plain stream writes */
+static void check_buffer(u32 vendor, u32 worst)
+{
+	FLASH_WriteBufStatTypeDef start, stat;
+	struct model_stat direct;
+	u32 addr = 0x50010;
+	u32 chunk = 12;
+	u32 num = 200;
+	u32 i;
+
+	model_nor_init(vendor, worst);
+	for (i = 0; i < num; i++) {
+		FLASH_WriteStream(addr + i * chunk, chunk, pattern + i * chunk);
+	}
+	CHECK(memcmp(xip(addr), pattern, num * chunk) == 0);
+	direct = model_stat;
+
+	model_nor_init(vendor, worst);
+	FLASH_WriteBufferGetStats(&start);
+	for (i = 0; i < num; i++) {
+		CHECK(FLASH_WriteStreamBuffered(addr + i * chunk, chunk, pattern + i * chunk) == 1);
+	}
+	CHECK(FLASH_WriteBufferPending(NULL) != 0);
+	CHECK(FLASH_WriteBufferSync() == 1);
+	CHECK(FLASH_WriteBufferPending(NULL) == 0);
+	CHECK(memcmp(xip(addr), pattern, num * chunk) == 0);
+	CHECK(model_stat.page_wrap == 0 && model_stat.one_bits == 0);
+	CHECK(model_stat.prog_bytes == num * chunk);
+
+	FLASH_WriteBufferGetStats(&stat);
+	CHECK(stat.flush_cnt - start.flush_cnt == model_stat.irq_off_cnt);
+	CHECK(model_stat.irq_off_cnt < direct.irq_off_cnt / 8);
+
+	printf("flash_sim: %-10s %s  %u x %u B: direct %4u irq-off windows %7llu us, max %5u us | "
+		   "buffered %3u windows %6llu us, max %5u us\n",
+		   nor_parts[vendor].name, worst ? "max" : "typ", num, chunk,
+		   direct.irq_off_cnt, (unsigned long long)direct.irq_off_us, direct.irq_off_max_us,
+		   model_stat.irq_off_cnt, (unsigned long long)model_stat.irq_off_us, model_stat.irq_off_max_us);
+}
+
+/* the 100 ms timeout without a work queue: polled, then by the next buffered write */
+static void check_buffer_timeout(u32 vendor, u32 worst)
+{
+	FLASH_WriteBufStatTypeDef start, stat;
+	u32 addr = 0x60004;
+	u32 pending_addr;
+
+	model_nor_init(vendor, worst);
+	FLASH_WriteBufferGetStats(&start);
+
+	CHECK(FLASH_WriteStreamBuffered(addr, 8, pattern) == 1);
+	model_advance_us(90000);
+	CHECK(FLASH_WriteBufferPoll() == 1);
+	CHECK(FLASH_WriteBufferPending(&pending_addr) == 8);
+	CHECK(pending_addr == addr);
+	model_advance_us(20000);
+	CHECK(FLASH_WriteBufferPoll() == 1);
+	CHECK(FLASH_WriteBufferPending(NULL) == 0);
+	CHECK(memcmp(xip(addr), pattern, 8) == 0);
+
+	/* the expired page goes first, the new write stays buffered */
+	CHECK(FLASH_WriteStreamBuffered(addr + 8, 8, pattern + 8) == 1);
+	model_advance_us(110000);
+	CHECK(FLASH_WriteStreamBuffered(addr + 16, 8, pattern + 16) == 1);
+	CHECK(memcmp(xip(addr), pattern, 16) == 0);
+	CHECK(FLASH_WriteBufferPending(&pending_addr) == 8);
+	CHECK(pending_addr == addr + 16);
+	CHECK(FLASH_WriteBufferSync() == 1);
+	CHECK(memcmp(xip(addr), pattern, 24) == 0);
+
+	FLASH_WriteBufferGetStats(&stat);
+	CHECK(stat.flush_timeout - start.flush_timeout == 2);
+	CHECK(stat.flush_sync - start.flush_sync == 1);
+}
+
+int main(int argc, char **argv)
+{
+	u32 worst = (argc > 1) && (strcmp(argv[1], "worst") == 0);
+	u32 vendor;
+	u32 i;
+
+	for (i = 0; i < sizeof(pattern); i++) {
+		pattern[i] = (u8)(i * 7 + (i >> 8) + 1);
+	}
+
+	CHECK(FLASH_WriteBufferInit(100, NULL) == RTK_SUCCESS);
+	/* a second init must not drop buffered data */
+	CHECK(FLASH_WriteBufferInit(50, NULL) == RTK_FAIL);
+
+	for (vendor = 0; vendor < NOR_VENDOR_NUM; vendor++) {
+		check_nor(vendor, worst);
+		check_stream(vendor, worst);
+		check_buffer(vendor, worst);
+		check_buffer_timeout(vendor, worst);
+	}
+
+	if (fail) {
+		printf("flash_sim: FAIL (%u)\n", fail);
+		return 1;
+	}
+
+	printf("flash_sim: NOR model and RAM flash functions pass\n");
+	return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Irq-off window of the KM0 flash lock interrupt FLASH_Write_IPC_Int when KM4 held
+ * flash for a while: before, every lost tick is processed in the interrupt (the fallback
+ * when the timer queue is full); after, the interrupt only records them and the timer
+ * service task catches up by xTaskCatchUpTicks. Both must end at the same tick count.
+ *
+ *   flash_tick_check [tick_cost_us]	exit status is non-zero on any failure
+ */
+
+#include <stdlib.h>
+#include "flash_model.h"
+#include "os_wrapper.h"
+
+#define WRITE_SYNC_LOCK    1
+#define WRITE_SYNC_UNLOCK  2
+
+static u32 fail;
+
+#define CHECK(expr)	do { \
+		if (!(expr)) { \
+			printf("flash_tick: %s:%d check failed: %s\n", __FILE__, __LINE__, #expr); \
+			fail++; \
+		} \
+	} while (0)
+
+static u8 sync_flag[CACHE_LINE_SIZE];
+
+/* KM4 locks flash for hold_ms, return the longest irq-off window of KM0 */
+static u32 flash_hold(u32 hold_ms, u32 queue_len, u32 *ticks)
+{
+	u32 start_tick;
+
+	model_nor_init(NOR_GD, 0);
+	model_timer_queue_len = queue_len;
+	model_crit_max_us = 0;
+	model_ipc_msg.msg = (u32)sync_flag;
+
+	start_tick = model_kernel_tick;
+
+	sync_flag[0] = WRITE_SYNC_LOCK;
+	FLASH_Write_IPC_Int(NULL, 0, IPC_A2N_FLASHPG_REQ);
+	CHECK(sync_flag[0] == 0);
+
+	/* KM0 can not take the tick interrupt while flash is locked */
+	model_advance_us(hold_ms * 1000);
+
+	sync_flag[0] = WRITE_SYNC_UNLOCK;
+	FLASH_Write_IPC_Int(NULL, 0, IPC_A2N_FLASHPG_REQ);
+	CHECK(sync_flag[0] == 0);
+
+	model_timer_task();
+
+	*ticks = model_kernel_tick - start_tick;
+
+	return model_stat.irq_off_max_us;
+}
+
+int main(int argc, char **argv)
+{
+	static const u32 hold_ms[] = {1, 5, 50, 250, 1000};
+	u32 before_ticks, after_ticks;
+	u32 before_us, after_us;
+	u32 before_crit, after_crit;
+	u32 i;
+
+	if (argc > 1) {
+		model_tick_cost_us = strtoul(argv[1], NULL, 0);
+	}
+
+	printf("flash_tick: %u us per tick, irq-off window of FLASH_Write_IPC_Int (all irq masked)\n", model_tick_cost_us);
+	printf("flash_tick: %8s %8s | %14s | %14s %14s\n", "hold ms", "ticks", "before irq-off", "after irq-off", "catch-up crit");
+
+	for (i = 0; i < sizeof(hold_ms) / sizeof(hold_ms[0]); i++) {
+		/* no room in the timer queue, the lost ticks are stepped in the interrupt */
+		before_us = flash_hold(hold_ms[i], 0, &before_ticks);
+		before_crit = model_crit_max_us;
+		after_us = flash_hold(hold_ms[i], 4, &after_ticks);
+		after_crit = model_crit_max_us;
+
+		printf("flash_tick: %8u %8u | %11u us | %11u us %11u us\n",
+			   hold_ms[i], after_ticks, before_us, after_us, after_crit);
+
+		CHECK(before_ticks == after_ticks);
+		CHECK(before_crit == 0);
+		/* one tick is always left to the tick interrupt */
+		CHECK(after_ticks + 2 >= hold_ms[i] && after_ticks <= hold_ms[i]);
+		/* the window does not grow with the lost ticks any more */
+		CHECK(after_us <= 2);
+		CHECK(before_us + 1 >= after_us + before_ticks * model_tick_cost_us);
+	}
+
+	/* ticks lost twice before the timer task runs are caught up once */
+	model_nor_init(NOR_GD, 0);
+	model_timer_queue_len = 4;
+	model_ipc_msg.msg = (u32)sync_flag;
+	before_ticks = model_kernel_tick;
+	for (i = 0; i < 2; i++) {
+		sync_flag[0] = WRITE_SYNC_LOCK;
+		FLASH_Write_IPC_Int(NULL, 0, IPC_A2N_FLASHPG_REQ);
+		model_advance_us(20000);
+		sync_flag[0] = WRITE_SYNC_UNLOCK;
+		FLASH_Write_IPC_Int(NULL, 0, IPC_A2N_FLASHPG_REQ);
+	}
+	CHECK(model_timer_task() == 1);
+	CHECK(model_kernel_tick - before_ticks >= 2 * 19 - 2 && model_kernel_tick - before_ticks <= 40);
+
+	if (fail) {
+		printf("flash_tick: FAIL (%u)\n", fail);
+		return 1;
+	}
+
+	printf("flash_tick: lost ticks caught up in task context\n");
+	return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host stand-in for ameba_soc.h, just what ameba_flash_ram.c needs. Time is virtual,
+ * it only moves when the flash model is busy or a test moves it, see flash_model.c.
+ * The tests link with -no-pie, the flash image is mapped at SPI_FLASH_BASE so XIP
+ * reads of the driver work as they are.
+ */
+
+#ifndef _AMEBA_SOC_H_
+#define _AMEBA_SOC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int16_t s16;
+typedef int32_t s32;
+
+#define __IO			volatile
+#define __I			volatile const
+#define __O			volatile
+#define __weak			__attribute__((weak))
+#define _LONG_CALL_
+#define ALIGNMTO(x)		__attribute__((aligned(x)))
+#define IPC_TABLE_DATA_SECTION
+#define BIT(x)			(1UL << (x))
+#define TRUE			1
+#define FALSE			0
+#define ENABLE			1
+#define DISABLE			0
+#define UNUSED(x)		(void)(x)
+#define NOTAG			"#"
+#define MIN(x, y)		(((x) < (y)) ? (x) : (y))
+#define MAX(x, y)		(((x) > (y)) ? (x) : (y))
+
+#define assert_param(expr)	assert(expr)
+#define _memset			memset
+#define _memcpy			memcpy
+
+/* cache of the host is coherent, the model only counts maintenance calls */
+#define CACHE_LINE_SIZE		32U
+#define CACHE_LINE_ADDR_MSK	(~(CACHE_LINE_SIZE - 1U))
+#define CACHE_LINE_ALIGNMENT(x)	(((u32)(x) + (CACHE_LINE_SIZE - 1U)) & CACHE_LINE_ADDR_MSK)
+extern u32 model_dcache_ops;
+#define DCache_Clean(addr, len)			((void)(addr), (void)(len), model_dcache_ops++)
+#define DCache_Invalidate(addr, len)		((void)(addr), (void)(len), model_dcache_ops++)
+#define DCache_CleanInvalidate(addr, len)	((void)(addr), (void)(len), model_dcache_ops++)
+#define RSIP_MMU_Cache_Clean()			((void)0)
+
+#define __STATIC_INLINE	static inline
+#define __CLZ(x)		((u32)((x) ? __builtin_clz(x) : 32))
+#define __DMB()			__atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __DSB()			__atomic_thread_fence(__ATOMIC_SEQ_CST)
+/* event register of the core, see flash_model.c */
+void __WFE(void);
+void __SEV(void);
+
+#define SPI_FLASH_BASE		0x08000000
+#define IS_FLASH_ADDR(addr)	((addr >= SPI_FLASH_BASE) && (addr <= 0x0FFFFFFF))
+
+enum {
+	RTK_LOG_NONE = 0,
+	RTK_LOG_ERROR,
+	RTK_LOG_WARN,
+	RTK_LOG_INFO,
+	RTK_LOG_DEBUG,
+};
+extern int model_log_level;
+#define RTK_LOGS(tag, level, fmt, ...)	do { \
+		if ((level) <= model_log_level) { \
+			fprintf(stderr, "[%s] " fmt, tag, ##__VA_ARGS__); \
+		} \
+	} while (0)
+#define RTK_LOGE(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_ERROR, fmt, ##__VA_ARGS__)
+#define RTK_LOGW(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_WARN, fmt, ##__VA_ARGS__)
+#define RTK_LOGI(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_INFO, fmt, ##__VA_ARGS__)
+
+typedef u32(*IRQ_FUN)(void *Data);
+#define INT_PRI_MIDDLE		5
+
+u32 SYS_CPUID(void);
+u32 CPU_InInterrupt(void);
+u32 irq_disable_save(void);
+void irq_enable_restore(u32 PrevStatus);
+void __disable_irq(void);
+void __enable_irq(void);
+
+u32 DTimestamp_Get(void);
+u32 SYSTIMER_TickGet(void);
+u32 SYSTIMER_GetPassTick(u32 start);
+u32 SYSTIMER_GetPassTime(u32 start);
+
+#define IPC_SEM_FLASH		2
+u32 IPC_SEMTake(u32 SEM_Idx, u32 timeout);
+u32 IPC_SEMFree(u32 SEM_Idx);
+
+#define IPC_A2N_FLASHPG_REQ	4
+
+#include "ameba_ipc.h"
+#include "ameba_ipc_api.h"
+#include "ameba_gdma.h"
+#include "ameba_flashclk.h"
+#include "ameba_spic.h"
+
+#endif
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host stand-in for os_wrapper.h, one task, see flash_model.c. */
+
+#ifndef _OS_WRAPPER_H_
+#define _OS_WRAPPER_H_
+
+#define RTK_SUCCESS		0
+#define RTK_FAIL		(-1)
+
+typedef void *rtos_sema_t;
+
+int rtos_sema_create_binary(rtos_sema_t *pp_handle);
+int rtos_sema_take(rtos_sema_t p_handle, u32 wait_ms);
+int rtos_sema_give(rtos_sema_t p_handle);
+void rtos_sched_suspend(void);
+void rtos_sched_resume(void);
+
+#endif
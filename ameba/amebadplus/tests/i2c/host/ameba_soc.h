@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host stand-in for ameba_soc.h, just what ameba_i2c.c needs. The I2C registers and
+ * the delays of the polled master functions are modeled in i2c_model.c.
+ */
+
+#ifndef _AMEBA_SOC_H_
+#define _AMEBA_SOC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+
+#define __IO			volatile
+#define __I			volatile const
+#define __O			volatile
+#define _LONG_CALL_
+#define __weak			__attribute__((weak))
+#define ALIGNMTO(x)		__attribute__((aligned(x)))
+#define BIT(x)			(1UL << (x))
+#define TRUE			1
+#define FALSE			0
+#define ENABLE			1
+#define DISABLE			0
+#define MIN(x, y)		(((x) < (y)) ? (x) : (y))
+#define MAX(x, y)		(((x) > (y)) ? (x) : (y))
+
+#define assert_param(expr)	((void)0)
+#define _memset			memset
+
+typedef u32(*IRQ_FUN)(void *Data);
+
+enum {
+	RTK_LOG_NONE = 0,
+	RTK_LOG_ERROR,
+	RTK_LOG_WARN,
+	RTK_LOG_INFO,
+	RTK_LOG_DEBUG,
+};
+extern int model_log_level;
+#define RTK_LOGS(tag, level, fmt, ...)	do { \
+		if ((level) <= model_log_level) { \
+			fprintf(stderr, "[%s] " fmt, tag, ##__VA_ARGS__); \
+		} \
+	} while (0)
+#define RTK_LOGE(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_ERROR, fmt, ##__VA_ARGS__)
+#define RTK_LOGW(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_WARN, fmt, ##__VA_ARGS__)
+#define RTK_LOGI(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_INFO, fmt, ##__VA_ARGS__)
+
+#define RTK_SUCCESS		0
+#define RTK_FAIL		(-1)
+
+/* cache of the host is coherent */
+#define DCache_Clean(addr, len)			((void)(addr), (void)(len))
+#define DCache_Invalidate(addr, len)		((void)(addr), (void)(len))
+#define DCache_CleanInvalidate(addr, len)	((void)(addr), (void)(len))
+
+#define RTK_ERR_TIMEOUT		(-5)
+#define RTK_LOGD(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_DEBUG, fmt, ##__VA_ARGS__)
+
+u32 irq_disable_save(void);
+void irq_enable_restore(u32 PrevStatus);
+
+/* polling waits in DelayUs, which lets the model time pass */
+void DelayUs(u32 us);
+void DelayMs(u32 ms);
+
+#define INT_PRI_MIDDLE		5
+typedef enum {
+	I2C0_IRQ = 20,
+	I2C1_IRQ = 21,
+} IRQn_Type;
+
+/* interrupt mode and the queue are not modeled, see i2c_model.c */
+void InterruptRegister(IRQ_FUN IrqFun, IRQn_Type IrqNum, u32 Data, u32 Priority);
+void InterruptUnRegister(IRQn_Type IrqNum);
+void InterruptEn(IRQn_Type IrqNum, u32 Priority);
+void InterruptDis(IRQn_Type IrqNum);
+
+#include "ameba_gdma.h"
+#include "ameba_i2c.h"
+
+/* both I2C register blocks on one page of their own, every access to it traps into
+the model, see i2c_model.c */
+union model_i2c_page {
+	I2C_TypeDef dev[2];
+	u8 page[4096];
+};
+extern union model_i2c_page model_i2c_page;
+#define I2C0_DEV		(&model_i2c_page.dev[0])
+#define I2C1_DEV		(&model_i2c_page.dev[1])
+
+#endif
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The FIFO batched I2C_MasterWrite and I2C_MasterRead against the byte by byte loops
+ * they replace, on the I2C model of i2c_model.c, at 100k, 400k, 1M and 3.4M. Each call
+ * is one transfer, timed from the call until STOP is on the bus.
+ *
+ * Printed are the bus use (bytes of the transfer over the bits the bus could have sent
+ * in that time), register accesses per byte and the share of time SCL was held low
+ * waiting for the CPU. The model counts register accesses and DelayUs as CPU time, not
+ * instructions.
+ *
+ * Polling spins at DelayUs(2) as long as the bus is busy, so most accesses follow the
+ * bus time and batching saves few of them. What it buys is the bus: the byte by byte
+ * read has one command outstanding and holds SCL after every byte until the CPU sends
+ * the next one.
+ *
+ * Every byte must be written or read once and in order, with one START and one STOP,
+ * and no FIFO may over- or underflow. The batched functions must not take longer than
+ * the loops, up to the poll that sees the end, the batched write must not take more
+ * register accesses and the batched read must not hold the bus.
+ *
+ *   i2c_fifo_bench [bytes [apb_cycles]]	exit status is non-zero on any failure
+ */
+
+#include <stdlib.h>
+#include "i2c_model.h"
+#include "reg_trap.h"
+
+#define BYTES_MAX		4096
+/* the end is seen up to a PollFlagRawINT spin and one wait for STOP late */
+#define END_SLACK_US	3
+
+static u32 bytes = 256;
+static u32 fail;
+
+static u8 txbuf[BYTES_MAX];
+static u8 rxbuf[BYTES_MAX];
+static u8 wire_log[BYTES_MAX];
+
+#define CHECK(expr)	do { \
+		if (!(expr)) { \
+			printf("i2c_fifo: %s:%d check failed: %s\n", __FILE__, __LINE__, #expr); \
+			fail++; \
+		} \
+	} while (0)
+
+struct i2c_result {
+	u64 cycles;			/* from the call until STOP */
+	double bus;			/* share of the bus time carrying the transfer */
+	double access;		/* register accesses per byte */
+	double hold;		/* share of the time SCL was held */
+};
+
+/* I2C_MasterWrite as it was, one TFNF poll per byte */
+static u32 legacy_write(I2C_TypeDef *I2Cx, u8 *pBuf, u32 len)
+{
+	u32 cnt = 0;
+
+	for (cnt = 0; cnt < len; cnt++) {
+		if (I2C_PollFlagRawINT(I2Cx, I2C_BIT_TFNF, 0, I2C_POLL_TIMEOUT_MS) != RTK_SUCCESS) {
+			return cnt;
+		}
+
+		if (cnt >= len - 1) {
+			I2Cx->IC_DATA_CMD = (*pBuf++) | (1 << 9);
+		} else {
+			I2Cx->IC_DATA_CMD = (*pBuf++);
+		}
+	}
+
+	I2C_PollFlagRawINT(I2Cx, I2C_BIT_TFE, 0, I2C_POLL_TIMEOUT_MS);
+	return cnt;
+}
+
+/* I2C_MasterRead as it was, one read command and one RFNE poll per byte */
+static u32 legacy_read(I2C_TypeDef *I2Cx, u8 *pBuf, u32 len)
+{
+	u32 cnt = 0;
+
+	for (cnt = 0; cnt < len; cnt++) {
+		if (cnt >= len - 1) {
+			I2Cx->IC_DATA_CMD = 0x0003 << 8;
+		} else {
+			I2Cx->IC_DATA_CMD = 0x0001 << 8;
+		}
+
+		if (I2C_PollFlagRawINT(I2Cx, I2C_BIT_RFNE, 0, I2C_POLL_TIMEOUT_MS) != RTK_SUCCESS) {
+			return cnt;
+		}
+		*pBuf++ = (u8)I2Cx->IC_DATA_CMD;
+	}
+
+	return cnt;
+}
+
+static void i2c_run(u32 rd, u32 legacy, struct i2c_result *res)
+{
+	struct model_i2c *i2c = &model_i2c[0];
+	/* START and address, a byte and ACK each, STOP */
+	u64 bits = 10 + 9 * bytes + 1;
+	u64 start_cycles;
+	u64 start_access;
+	u64 access;
+	u32 ret;
+	u32 i;
+
+	model_i2c_reset(0);
+	i2c->wire = wire_log;
+	i2c->wire_max = BYTES_MAX;
+	I2C_Cmd(I2C0_DEV, ENABLE);
+
+	for (i = 0; i < bytes; i++) {
+		txbuf[i] = (u8)(i * 0x2545F491U >> 9);
+	}
+	memset(rxbuf, 0xA5, sizeof(rxbuf));
+
+	start_cycles = model_cycles;
+	start_access = reg_trap_cnt;
+	if (rd) {
+		ret = legacy ? legacy_read(I2C0_DEV, rxbuf, bytes) : I2C_MasterRead(I2C0_DEV, rxbuf, bytes);
+	} else {
+		ret = legacy ? legacy_write(I2C0_DEV, txbuf, bytes) : I2C_MasterWrite(I2C0_DEV, txbuf, bytes);
+	}
+	access = reg_trap_cnt - start_access;
+
+	/* until STOP is on the bus */
+	while (I2C0_DEV->IC_STATUS & I2C_BIT_MST_ACTIVITY) {
+		DelayUs(1);
+	}
+
+	CHECK(ret == bytes);
+	CHECK(i2c->starts == 1 && i2c->stops == 1);
+	CHECK(i2c->written == (rd ? 0 : bytes));
+	CHECK(i2c->read == (rd ? bytes : 0));
+	CHECK(i2c->tx_overflow == 0 && i2c->rx_overflow == 0 && i2c->rx_underflow == 0);
+
+	for (i = 0; i < bytes; i++) {
+		if (!rd && (wire_log[i] != txbuf[i])) {
+			printf("i2c_fifo: write byte %u sent %x, buffer %x\n", i, wire_log[i], txbuf[i]);
+			fail++;
+			break;
+		}
+		if (rd && (rxbuf[i] != model_i2c_peer(i))) {
+			printf("i2c_fifo: read byte %u got %x, slave %x\n", i, rxbuf[i], model_i2c_peer(i));
+			fail++;
+			break;
+		}
+	}
+	CHECK(rd || (rxbuf[0] == 0xA5));
+
+	res->cycles = model_cycles - start_cycles;
+	res->bus = (double)(bits * model_bit_cycles) / (model_cycles - start_cycles);
+	res->access = (double)access / bytes;
+	res->hold = (double)i2c->hold / (model_cycles - start_cycles);
+}
+
+int main(int argc, char **argv)
+{
+	static const u32 rates_khz[] = {100, 400, 1000, 3400};
+	struct i2c_result old_res, new_res;
+	u32 r, rd;
+
+	if (argc > 1) {
+		bytes = strtoul(argv[1], NULL, 0);
+	}
+	if (argc > 2) {
+		model_apb_cycles = strtoul(argv[2], NULL, 0);
+	}
+	if ((bytes == 0) || (bytes > BYTES_MAX)) {
+		printf("i2c_fifo: bytes must be 1..%u\n", BYTES_MAX);
+		return 1;
+	}
+
+	model_i2c_init();
+
+	printf("i2c_fifo: %u bytes, %u cycles per register access, %u cycles per us\n",
+		   bytes, model_apb_cycles, model_cycles_per_us);
+	for (r = 0; r < sizeof(rates_khz) / sizeof(rates_khz[0]); r++) {
+		model_bit_cycles = model_cycles_per_us * 1000 / rates_khz[r];
+		for (rd = 0; rd < 2; rd++) {
+			i2c_run(rd, 1, &old_res);
+			i2c_run(rd, 0, &new_res);
+			printf("i2c_fifo: %4u kHz %-5s per byte bus %5.1f%% %6.2f accesses/byte hold %5.1f%% | batched bus %5.1f%% %6.2f accesses/byte hold %5.1f%%\n",
+				   rates_khz[r], rd ? "read" : "write",
+				   old_res.bus * 100, old_res.access, old_res.hold * 100,
+				   new_res.bus * 100, new_res.access, new_res.hold * 100);
+			CHECK(new_res.cycles <= old_res.cycles + END_SLACK_US * model_cycles_per_us);
+			if (rd) {
+				CHECK(new_res.hold == 0);
+			} else {
+				CHECK(new_res.access <= old_res.access);
+			}
+		}
+	}
+
+	if (fail) {
+		printf("i2c_fifo: FAIL (%u)\n", fail);
+		return 1;
+	}
+
+	printf("i2c_fifo: every byte written and read once\n");
+	return 0;
+}
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host model of the two I2C masters for the polled master functions of ameba_i2c.c. The
+ * register page traps (see ../common/reg_trap.c), so writing IC_DATA_CMD pushes a
+ * command into the TX FIFO, reading it pops the RX FIFO, and IC_TXFLR, IC_RXFLR and
+ * IC_STATUS follow both.
+ *
+ * Time is virtual and counted in CPU cycles: a register access takes model_apb_cycles,
+ * DelayUs model_cycles_per_us per us, and between two of them the bus runs the queued
+ * commands at model_bit_cycles per bit. A command is 9 bits, byte and ACK. START or
+ * RESTART with the address byte takes 10 more, STOP 1 more. A RESTART goes before a
+ * command after CMD_RESTART or on a change of direction. With the TX FIFO empty and no
+ * STOP the master holds SCL low and waits, which is counted in hold. A read command
+ * pushes the slave answer into RX, or loses it if RX is full.
+ *
+ * The slave always acks, so TX_ABRT is never raised. Interrupt mode, DMA and the queue
+ * are not modeled, their GDMA and interrupt calls abort.
+ */
+
+#include <stdlib.h>
+#include "i2c_model.h"
+#include "reg_trap.h"
+
+#define MODEL_I2C_CMD_BITS		9
+#define MODEL_I2C_ADDR_BITS		10
+#define MODEL_I2C_STOP_BITS		1
+
+union model_i2c_page model_i2c_page __attribute__((aligned(REG_TRAP_PAGE_SIZE)));
+int model_log_level = RTK_LOG_NONE;
+
+struct model_i2c model_i2c[2];
+u64 model_cycles;
+u32 model_apb_cycles = 4;
+u32 model_bit_cycles = 600;
+u32 model_cycles_per_us = 240;
+
+u32 irq_disable_save(void)
+{
+	return 0;
+}
+
+void irq_enable_restore(u32 PrevStatus)
+{
+	(void)PrevStatus;
+}
+
+void DelayUs(u32 us)
+{
+	model_cycles += (u64)us * model_cycles_per_us;
+}
+
+void DelayMs(u32 ms)
+{
+	DelayUs(ms * 1000);
+}
+
+u8 model_i2c_peer(u32 n)
+{
+	return (u8)((n * 0x9E3779B1U) >> 13);
+}
+
+/* run the bus until Now */
+static void model_i2c_wire(struct model_i2c *i2c, u64 Now)
+{
+	u32 entry;
+	u32 bits;
+
+	while (1) {
+		if (!i2c->shifting) {
+			if (((i2c->reg.IC_ENABLE & I2C_BIT_ENABLE) == 0) || (i2c->tx_wr == i2c->tx_rd)) {
+				break;
+			}
+
+			entry = i2c->tx_fifo[i2c->tx_rd++ % I2C_TRX_BUFFER_DEPTH];
+			bits = MODEL_I2C_CMD_BITS;
+			if (!i2c->active) {
+				bits += MODEL_I2C_ADDR_BITS;
+				i2c->active = 1;
+				i2c->starts++;
+			} else if (i2c->restart || ((entry & I2C_BIT_CMD_RW) != i2c->dir)) {
+				bits += MODEL_I2C_ADDR_BITS;
+			}
+			if (entry & I2C_BIT_CMD_STOP) {
+				bits += MODEL_I2C_STOP_BITS;
+			}
+
+			i2c->entry = entry;
+			i2c->dir = entry & I2C_BIT_CMD_RW;
+			i2c->restart = (entry & I2C_BIT_CMD_RESTART) ? 1 : 0;
+			i2c->shift_end = i2c->wire_t + bits * model_bit_cycles;
+			i2c->shifting = 1;
+		}
+
+		if (i2c->shift_end > Now) {
+			return;
+		}
+
+		i2c->wire_t = i2c->shift_end;
+		i2c->shifting = 0;
+		entry = i2c->entry;
+		if (entry & I2C_BIT_CMD_RW) {
+			if (i2c->rx_wr - i2c->rx_rd == I2C_TRX_BUFFER_DEPTH) {
+				i2c->rx_overflow++;
+			} else {
+				i2c->rx_fifo[i2c->rx_wr++ % I2C_TRX_BUFFER_DEPTH] = model_i2c_peer(i2c->read);
+			}
+			i2c->read++;
+		} else {
+			if (i2c->wire && (i2c->written < i2c->wire_max)) {
+				i2c->wire[i2c->written] = (u8)entry;
+			}
+			i2c->written++;
+		}
+		if (entry & I2C_BIT_CMD_STOP) {
+			i2c->active = 0;
+			i2c->stops++;
+		}
+	}
+
+	/* nothing to send, SCL is held low until the next command if no STOP was sent */
+	if (i2c->active) {
+		i2c->hold += Now - i2c->wire_t;
+	}
+	i2c->wire_t = Now;
+}
+
+static u32 model_i2c_status(struct model_i2c *i2c)
+{
+	u32 tx = i2c->tx_wr - i2c->tx_rd;
+	u32 rx = i2c->rx_wr - i2c->rx_rd;
+	u32 sr = 0;
+
+	sr |= (i2c->active || i2c->shifting || tx) ? (I2C_BIT_MST_ACTIVITY | I2C_BIT_ACTIVITY) : 0;
+	sr |= (tx < I2C_TRX_BUFFER_DEPTH) ? I2C_BIT_TFNF : 0;
+	sr |= (tx == 0) ? I2C_BIT_TFE : 0;
+	sr |= rx ? I2C_BIT_RFNE : 0;
+	sr |= (rx == I2C_TRX_BUFFER_DEPTH) ? I2C_BIT_RFF : 0;
+
+	return sr;
+}
+
+static u32 model_i2c_read(u32 Offset)
+{
+	struct model_i2c *i2c = &model_i2c[Offset / sizeof(I2C_TypeDef)];
+	u32 reg = Offset % sizeof(I2C_TypeDef);
+	u32 val;
+
+	model_i2c_wire(i2c, model_cycles);
+	model_cycles += model_apb_cycles;
+
+	switch (reg) {
+	case offsetof(I2C_TypeDef, IC_TXFLR):
+		return i2c->tx_wr - i2c->tx_rd;
+	case offsetof(I2C_TypeDef, IC_RXFLR):
+		return i2c->rx_wr - i2c->rx_rd;
+	case offsetof(I2C_TypeDef, IC_STATUS):
+		return model_i2c_status(i2c);
+	case offsetof(I2C_TypeDef, IC_DATA_CMD):
+		if (i2c->rx_wr == i2c->rx_rd) {
+			i2c->rx_underflow++;
+			return 0;
+		}
+		return i2c->rx_fifo[i2c->rx_rd++ % I2C_TRX_BUFFER_DEPTH];
+	}
+
+	memcpy(&val, (u8 *)&i2c->reg + reg, sizeof(val));
+	return val;
+}
+
+static void model_i2c_write(u32 Offset, u32 Value)
+{
+	struct model_i2c *i2c = &model_i2c[Offset / sizeof(I2C_TypeDef)];
+	u32 reg = Offset % sizeof(I2C_TypeDef);
+
+	model_i2c_wire(i2c, model_cycles);
+	model_cycles += model_apb_cycles;
+
+	if (reg == offsetof(I2C_TypeDef, IC_DATA_CMD)) {
+		if (i2c->tx_wr - i2c->tx_rd == I2C_TRX_BUFFER_DEPTH) {
+			i2c->tx_overflow++;
+		} else {
+			i2c->tx_fifo[i2c->tx_wr++ % I2C_TRX_BUFFER_DEPTH] = Value;
+		}
+		return;
+	}
+
+	memcpy((u8 *)&i2c->reg + reg, &Value, sizeof(Value));
+
+	/* disabled: the FIFOs are held erased */
+	if ((reg == offsetof(I2C_TypeDef, IC_ENABLE)) && ((Value & I2C_BIT_ENABLE) == 0)) {
+		i2c->tx_rd = i2c->tx_wr;
+		i2c->rx_rd = i2c->rx_wr;
+		i2c->shifting = 0;
+		i2c->active = 0;
+	}
+}
+
+void model_i2c_reset(u32 Index)
+{
+	struct model_i2c *i2c = &model_i2c[Index];
+
+	memset(i2c, 0, sizeof(*i2c));
+	i2c->wire_t = model_cycles;
+}
+
+void model_i2c_init(void)
+{
+	model_i2c_reset(0);
+	model_i2c_reset(1);
+	reg_trap_init(&model_i2c_page, model_i2c_read, model_i2c_write);
+}
+
+/* interrupt mode, DMA and the queue are not modeled */
+void InterruptRegister(IRQ_FUN IrqFun, IRQn_Type IrqNum, u32 Data, u32 Priority)
+{
+	(void)IrqFun;
+	(void)IrqNum;
+	(void)Data;
+	(void)Priority;
+	abort();
+}
+
+void InterruptUnRegister(IRQn_Type IrqNum)
+{
+	(void)IrqNum;
+	abort();
+}
+
+void InterruptEn(IRQn_Type IrqNum, u32 Priority)
+{
+	(void)IrqNum;
+	(void)Priority;
+	abort();
+}
+
+void InterruptDis(IRQn_Type IrqNum)
+{
+	(void)IrqNum;
+	abort();
+}
+
+u8 GDMA_ChnlAlloc(u32 GDMA_Index, IRQ_FUN IrqFun, u32 IrqData, u32 IrqPriority)
+{
+	(void)GDMA_Index;
+	(void)IrqFun;
+	(void)IrqData;
+	(void)IrqPriority;
+	abort();
+}
+
+u8 GDMA_ChnlFree(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	(void)GDMA_Index;
+	(void)GDMA_ChNum;
+	abort();
+}
+
+void GDMA_Init(u8 GDMA_Index, u8 GDMA_ChNum, PGDMA_InitTypeDef GDMA_InitStruct)
+{
+	(void)GDMA_Index;
+	(void)GDMA_ChNum;
+	(void)GDMA_InitStruct;
+	abort();
+}
+
+void GDMA_Cmd(u8 GDMA_Index, u8 GDMA_ChNum, u32 NewState)
+{
+	(void)GDMA_Index;
+	(void)GDMA_ChNum;
+	(void)NewState;
+	abort();
+}
+
+u32 GDMA_ClearINT(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	(void)GDMA_Index;
+	(void)GDMA_ChNum;
+	abort();
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _I2C_MODEL_H_
+#define _I2C_MODEL_H_
+
+#include "ameba_soc.h"
+
+/* one I2C master, its FIFOs and the bus to a slave that acks every byte */
+struct model_i2c {
+	I2C_TypeDef reg;			/* plain registers, FIFO, level and status registers are computed */
+	u32 tx_fifo[I2C_TRX_BUFFER_DEPTH];
+	u32 tx_rd, tx_wr;
+	u32 rx_fifo[I2C_TRX_BUFFER_DEPTH];
+	u32 rx_rd, rx_wr;
+
+	u64 wire_t;					/* cycle the bus is simulated up to */
+	u64 shift_end;				/* cycle the entry on the bus is done, if shifting */
+	u32 shifting;
+	u32 entry;					/* command entry on the bus */
+	u32 active;					/* between START and STOP */
+	u32 dir;					/* I2C_BIT_CMD_RW of the last entry */
+	u32 restart;				/* next entry starts with a RESTART */
+	u64 hold;					/* cycles SCL was held low with nothing queued */
+
+	u32 written;				/* data bytes written to the slave */
+	u32 read;					/* data bytes read from the slave */
+	u8 *wire;					/* bytes written, up to wire_max, can be NULL */
+	u32 wire_max;
+	u32 starts;
+	u32 stops;
+
+	u32 tx_overflow;			/* writes to a full TX FIFO */
+	u32 rx_overflow;			/* bytes lost to a full RX FIFO */
+	u32 rx_underflow;			/* reads of an empty RX FIFO */
+};
+
+extern struct model_i2c model_i2c[2];
+
+/* CPU cycles: each register access takes model_apb_cycles, a bit on the bus
+model_bit_cycles, DelayUs model_cycles_per_us per us. Time only moves on register
+accesses and delays. */
+extern u64 model_cycles;
+extern u32 model_apb_cycles;
+extern u32 model_bit_cycles;
+extern u32 model_cycles_per_us;
+
+/* map and trap the register page, reset both I2C */
+void model_i2c_init(void);
+void model_i2c_reset(u32 Index);
+
+/* what the slave answers to data byte n read from it */
+u8 model_i2c_peer(u32 n);
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host stand-in for ameba_soc.h, just what ameba_ipc_api.c needs. Each core is a
+ * thread, see ipc_model.c. The tests link with -no-pie so shared memory, which the
+ * driver passes around as u32, is below 4GB.
+ */
+
+#ifndef _AMEBA_SOC_H_
+#define _AMEBA_SOC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int16_t s16;
+typedef int32_t s32;
+
+#define __IO			volatile
+#define __I			volatile const
+#define BIT(x)			(1UL << (x))
+#define TRUE			1
+#define FALSE			0
+#define UNUSED(x)		(void)(x)
+#define NOTAG			"#"
+#define ENABLE			1
+#define DISABLE			0
+
+#define assert_param(expr)	assert(expr)
+#define _memset			memset
+#define _memcpy			memcpy
+
+/* cache of the host is coherent, the model only counts maintenance calls */
+#define CACHE_LINE_SIZE		32U
+#define IS_CACHE_LINE_ALIGNED_ADDR(ADDR)	(((ADDR) & (CACHE_LINE_SIZE - 1U)) == 0)
+extern __thread u32 model_dcache_ops;
+#define DCache_Clean(addr, len)			((void)(addr), (void)(len), model_dcache_ops++)
+#define DCache_Invalidate(addr, len)		((void)(addr), (void)(len), model_dcache_ops++)
+#define DCache_CleanInvalidate(addr, len)	((void)(addr), (void)(len), model_dcache_ops++)
+
+#define __DMB()			__atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __STATIC_INLINE	static inline
+#define __CLZ(x)		((u32)((x) ? __builtin_clz(x) : 32))
+
+enum {
+	RTK_LOG_NONE = 0,
+	RTK_LOG_ERROR,
+	RTK_LOG_WARN,
+	RTK_LOG_INFO,
+	RTK_LOG_DEBUG,
+};
+extern int model_log_level;
+#define RTK_LOGS(tag, level, fmt, ...)	do { \
+		if ((level) <= model_log_level) { \
+			fprintf(stderr, "[%s] " fmt, tag, ##__VA_ARGS__); \
+		} \
+	} while (0)
+#define RTK_LOGE(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_ERROR, fmt, ##__VA_ARGS__)
+#define RTK_LOGW(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_WARN, fmt, ##__VA_ARGS__)
+#define RTK_LOGI(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_INFO, fmt, ##__VA_ARGS__)
+
+u32 SYS_CPUID(void);
+u32 CPU_InInterrupt(void);
+u32 DTimestamp_Get(void);
+u32 irq_disable_save(void);
+void irq_enable_restore(u32 PrevStatus);
+
+#define IPC_SEM_POOL		6
+u32 IPC_SEMTake(u32 SEM_Idx, u32 timeout);
+u32 IPC_SEMFree(u32 SEM_Idx);
+
+extern u8 __ipc_table_start__[];
+extern u8 __ipc_table_end__[];
+extern u8 __km0_ipc_memory_start__[];
+
+#include "ameba_ipc.h"
+#include "ameba_ipc_api.h"
+
+extern IPC_TypeDef model_ipc_dev[2];
+#define IPCKM0_DEV		(&model_ipc_dev[0])
+#define IPCKM4_DEV		(&model_ipc_dev[1])
+
+#endif
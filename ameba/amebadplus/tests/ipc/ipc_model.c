@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Two core model for the IPC driver on the host. Each core is a task thread plus an
+ * irq thread, the IPC devices and the hardware semaphores are plain shared memory.
+ * The irq thread of a core runs the rx handlers of pending channels and then clears
+ * the TX bit of the sender as the hardware does, and it runs the TX empty handler
+ * (level triggered) of channels it enabled by IPC_INTConfig. irq_disable_save holds the irq gate
+ * of the core, so a handler never runs while a task of the same core masks irq.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdlib.h>
+#include <time.h>
+#include "ipc_model.h"
+#include "os_wrapper.h"
+
+__thread u32 model_dcache_ops;
+int model_log_level = RTK_LOG_NONE;
+
+u8 __ipc_table_start__[1];
+u8 __ipc_table_end__[1];
+u8 __km0_ipc_memory_start__[2 * IPC_TX_CHANNEL_NUM * sizeof(IPC_MSG_STRUCT)] __attribute__((aligned(32)));
+
+IPC_TypeDef model_ipc_dev[2];
+IPC_IRQ_FUN IPC_IrqHandler[IPC_CHANNEL_NUM];
+
+u32 model_irq_latency_us;
+u32 model_irq_cnt[2];
+
+static __thread u32 model_cpu_id;
+static __thread u32 model_in_irq;
+static __thread u32 model_irq_masked;
+
+static pthread_mutex_t model_irq_gate[2] = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER};
+static pthread_t model_irq_thread[2];
+static volatile u32 model_irq_stop;
+/* TX empty interrupt enable of each IPC device, bit IPC_TX_CHANNEL_SHIFT + ch */
+static u32 model_tx_irq_en[2];
+
+static u32 model_sem[64];
+
+static IPC_IRQ_FUN model_rx_handler[2][IPC_TX_CHANNEL_NUM];
+static void *model_rx_data[2][IPC_TX_CHANNEL_NUM];
+
+static pthread_t model_thread[2];
+static u32 model_thread_num;
+
+
+struct model_core_arg {
+	u32 cpu_id;
+	void *(*entry)(void *);
+	void *arg;
+};
+
+double model_now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+void model_delay_us(u32 us)
+{
+	double end = model_now_us() + us;
+
+	/* the other core keeps running meanwhile, also on hosts with less cpus than threads */
+	while (model_now_us() < end) {
+		sched_yield();
+	}
+}
+
+u32 SYS_CPUID(void)
+{
+	return model_cpu_id;
+}
+
+u32 CPU_InInterrupt(void)
+{
+	return model_in_irq;
+}
+
+u32 DTimestamp_Get(void)
+{
+	/* the driver polls the timer in its wait loops, let the peer run as in IPC_SEMTake */
+	sched_yield();
+
+	return (u32)(u64)model_now_us();
+}
+
+u32 irq_disable_save(void)
+{
+	/* irq is masked all through a handler already */
+	if (model_in_irq) {
+		return 0;
+	}
+
+	if (model_irq_masked == 0) {
+		pthread_mutex_lock(&model_irq_gate[model_cpu_id]);
+	}
+
+	return model_irq_masked++;
+}
+
+void irq_enable_restore(u32 PrevStatus)
+{
+	if (model_in_irq) {
+		return;
+	}
+
+	model_irq_masked = PrevStatus;
+	if (model_irq_masked == 0) {
+		pthread_mutex_unlock(&model_irq_gate[model_cpu_id]);
+	}
+}
+
+u32 IPC_SEMTake(u32 SEM_Idx, u32 timeout)
+{
+	u32 expect;
+	u32 loop = timeout * 1000;
+
+	do {
+		expect = 0;
+		if (__atomic_compare_exchange_n(&model_sem[SEM_Idx], &expect, model_cpu_id + 1, 0,
+										__ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+			return TRUE;
+		}
+		/* let the holder run, the host may have less cpus than the model threads */
+		sched_yield();
+	} while (loop--);
+
+	return FALSE;
+}
+
+u32 IPC_SEMFree(u32 SEM_Idx)
+{
+	assert(__atomic_load_n(&model_sem[SEM_Idx], __ATOMIC_RELAXED) == model_cpu_id + 1);
+	__atomic_store_n(&model_sem[SEM_Idx], 0, __ATOMIC_RELEASE);
+
+	return TRUE;
+}
+
+IPC_TypeDef *IPC_GetDev(u32 IPC_Dir, u32 Is_Rx)
+{
+	if (Is_Rx) {
+		return (IPC_Dir == IPC_KM4_TO_KM0) ? IPCKM0_DEV : IPCKM4_DEV;
+	}
+
+	return (IPC_Dir == IPC_KM4_TO_KM0) ? IPCKM4_DEV : IPCKM0_DEV;
+}
+
+IPC_TypeDef *IPC_GetDevById(u32 cpu_id)
+{
+	return cpu_id ? IPCKM4_DEV : IPCKM0_DEV;
+}
+
+void IPC_INTConfig(IPC_TypeDef *IPCx, u8 IPC_Shiftbit, u32 NewState)
+{
+	u32 dev = IPCx - model_ipc_dev;
+
+	if (NewState == ENABLE) {
+		__atomic_fetch_or(&model_tx_irq_en[dev], BIT(IPC_Shiftbit), __ATOMIC_RELEASE);
+	} else {
+		__atomic_fetch_and(&model_tx_irq_en[dev], ~BIT(IPC_Shiftbit), __ATOMIC_RELEASE);
+	}
+}
+
+u32 IPC_IERGet(IPC_TypeDef *IPCx)
+{
+	(void)IPCx;
+
+	return 0;
+}
+
+void IPC_INTUserHandler(IPC_TypeDef *IPCx, u8 IPC_Shiftbit, void *IrqHandler, void *IrqData)
+{
+	(void)IPCx;
+	(void)IrqData;
+
+	IPC_IrqHandler[IPC_Shiftbit] = (IPC_IRQ_FUN)IrqHandler;
+}
+
+void model_ipc_register(u32 IPC_Dir, u8 IPC_ChNum, IPC_IRQ_FUN Handler, void *Data)
+{
+	model_rx_handler[IPC_Dir][IPC_ChNum] = Handler;
+	model_rx_data[IPC_Dir][IPC_ChNum] = Data;
+
+	/* the sender blocks on the TX empty interrupt, as the ipc table sets it up */
+	IPC_IrqHandler[IPC_ChNum + IPC_TX_CHANNEL_SHIFT] = IPC_TXHandler;
+}
+
+/* TX empty interrupt of the channels this core sends on */
+static u32 model_ipc_tx_dispatch(void)
+{
+	IPC_TypeDef *IPCx = IPC_GetDevById(model_cpu_id);
+	u32 pending;
+	u32 shift;
+
+	pending = __atomic_load_n(&model_tx_irq_en[model_cpu_id], __ATOMIC_ACQUIRE) &
+			  ~__atomic_load_n(&IPCx->IPC_DATA, __ATOMIC_ACQUIRE);
+	if (pending == 0) {
+		return 0;
+	}
+
+	pthread_mutex_lock(&model_irq_gate[model_cpu_id]);
+	model_in_irq = 1;
+	for (shift = IPC_TX_CHANNEL_SHIFT; shift < IPC_CHANNEL_NUM; shift++) {
+		if (pending & BIT(shift)) {
+			assert(IPC_IrqHandler[shift] != NULL);
+			IPC_IrqHandler[shift](NULL, 0, shift);
+		}
+	}
+	model_in_irq = 0;
+	pthread_mutex_unlock(&model_irq_gate[model_cpu_id]);
+
+	return 1;
+}
+
+static u32 model_ipc_dispatch(void)
+{
+	u32 dir = (model_cpu_id == 0) ? IPC_KM4_TO_KM0 : IPC_KM0_TO_KM4;
+	IPC_TypeDef *IPCx = IPC_GetDev(dir, 0);
+	u32 pending;
+	u32 ch;
+
+	pending = __atomic_load_n(&IPCx->IPC_DATA, __ATOMIC_ACQUIRE) >> IPC_TX_CHANNEL_SHIFT;
+	if (pending == 0) {
+		return 0;
+	}
+
+	if (model_irq_latency_us) {
+		model_delay_us(model_irq_latency_us);
+	}
+
+	pthread_mutex_lock(&model_irq_gate[model_cpu_id]);
+	model_irq_cnt[model_cpu_id]++;
+	model_in_irq = 1;
+	for (ch = 0; ch < IPC_TX_CHANNEL_NUM; ch++) {
+		if ((pending & BIT(ch)) == 0) {
+			continue;
+		}
+
+		assert(model_rx_handler[dir][ch] != NULL);
+		model_rx_handler[dir][ch](model_rx_data[dir][ch], 0, ch);
+		__atomic_fetch_and(&IPCx->IPC_DATA, ~BIT(ch + IPC_TX_CHANNEL_SHIFT), __ATOMIC_RELEASE);
+	}
+	model_in_irq = 0;
+	pthread_mutex_unlock(&model_irq_gate[model_cpu_id]);
+
+	return 1;
+}
+
+static void *model_irq_entry(void *arg)
+{
+	model_cpu_id = (u32)(uintptr_t)arg;
+
+	while (!model_irq_stop) {
+		if ((model_ipc_dispatch() | model_ipc_tx_dispatch()) == 0) {
+			sched_yield();
+		}
+	}
+
+	/* drain what was sent last */
+	while (model_ipc_dispatch() | model_ipc_tx_dispatch());
+
+	return NULL;
+}
+
+void model_irq_start(void)
+{
+	u32 cpu;
+
+	model_irq_stop = 0;
+	for (cpu = 0; cpu < 2; cpu++) {
+		pthread_create(&model_irq_thread[cpu], NULL, model_irq_entry, (void *)(uintptr_t)cpu);
+	}
+}
+
+void model_irq_stop_all(void)
+{
+	u32 cpu;
+
+	model_irq_stop = 1;
+	for (cpu = 0; cpu < 2; cpu++) {
+		pthread_join(model_irq_thread[cpu], NULL);
+	}
+}
+
+static void *model_core_entry(void *arg)
+{
+	struct model_core_arg *core = (struct model_core_arg *)arg;
+	void *ret;
+
+	model_cpu_id = core->cpu_id;
+	ret = core->entry(core->arg);
+	free(core);
+
+	return ret;
+}
+
+void model_core_start(u32 CpuId, void *(*Entry)(void *), void *Arg)
+{
+	struct model_core_arg *core = malloc(sizeof(*core));
+
+	assert(model_thread_num < 2);
+
+	core->cpu_id = CpuId;
+	core->entry = Entry;
+	core->arg = Arg;
+	pthread_create(&model_thread[model_thread_num++], NULL, model_core_entry, core);
+}
+
+void model_core_join(void)
+{
+	while (model_thread_num) {
+		pthread_join(model_thread[--model_thread_num], NULL);
+	}
+}
+
+int rtos_sema_create_binary(rtos_sema_t *pp_handle)
+{
+	sem_t *sem = malloc(sizeof(sem_t));
+
+	sem_init(sem, 0, 0);
+	*pp_handle = sem;
+
+	return RTK_SUCCESS;
+}
+
+int rtos_sema_take(rtos_sema_t p_handle, u32 wait_ms)
+{
+	(void)wait_ms;
+
+	return sem_wait((sem_t *)p_handle) ? RTK_FAIL : RTK_SUCCESS;
+}
+
+int rtos_sema_give(rtos_sema_t p_handle)
+{
+	return sem_post((sem_t *)p_handle) ? RTK_FAIL : RTK_SUCCESS;
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _IPC_MODEL_H_
+#define _IPC_MODEL_H_
+
+#include "ameba_soc.h"
+
+/* rx handler of messages sent in direction IPC_Dir on channel IPC_ChNum, the TX empty
+handler of the channel is IPC_TXHandler */
+void model_ipc_register(u32 IPC_Dir, u8 IPC_ChNum, IPC_IRQ_FUN Handler, void *Data);
+
+/* start and stop the irq threads of both cores, stop drains pending messages first */
+void model_irq_start(void);
+void model_irq_stop_all(void);
+
+/* run Entry(Arg) as core CpuId (0 for KM0, 1 for KM4) */
+void model_core_start(u32 CpuId, void *(*Entry)(void *), void *Arg);
+void model_core_join(void);
+
+/* peer interrupt entry latency in us, spent before each dispatch */
+extern u32 model_irq_latency_us;
+
+/* IPC interrupts taken by each core */
+extern u32 model_irq_cnt[2];
+
+void model_delay_us(u32 us);
+double model_now_us(void);
+
+#endif
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Ownership check of the IPC buffer pool on the two core model. Both cores allocate,
+ * fill and send buffers to each other while the peer receives them in its rx handler,
+ * checks the payload and frees them either in the handler or later from its task.
+ * Then every kind of ownership violation is injected once and must be refused.
+ *
+ *   ipc_pool_check [rounds]	exit status is non-zero on any failure
+ */
+
+#include <sched.h>
+#include <stdlib.h>
+#include "ipc_model.h"
+#include "os_wrapper.h"
+
+#define POOL_BUF_SIZE		64
+#define POOL_BUF_NUM		8
+/* one channel per direction, the driver keeps one tx semaphore per channel and the model
+shares the globals of both cores */
+#define POOL_CH(cpu)		((u8)(cpu))
+
+static u8 pool_mem[IPC_POOL_SIZE(POOL_BUF_SIZE, POOL_BUF_NUM)] __attribute__((aligned(32)));
+static PIPC_POOL_STRUCT pool = (PIPC_POOL_STRUCT)pool_mem;
+
+static u32 rounds = 5000;
+static u32 fail;
+
+/* per receiving core */
+static u32 rx_cnt[2];
+static u32 rx_seq[2];
+static u32 rx_null[2];
+static void *volatile rx_keep[2][POOL_BUF_NUM];
+static u32 rx_keep_wr[2];
+static u32 rx_keep_rd[2];
+
+#define CHECK(expr)	do { \
+		if (!(expr)) { \
+			printf("ipc_pool: %s:%d check failed: %s\n", __FILE__, __LINE__, #expr); \
+			__atomic_fetch_add(&fail, 1, __ATOMIC_RELAXED); \
+		} \
+	} while (0)
+
+static u32 pool_dir(u32 cpu)
+{
+	return cpu ? IPC_KM4_TO_KM0 : IPC_KM0_TO_KM4;
+}
+
+static void pool_rx_handler(void *Data, u32 IrqStatus, u32 ChanNum)
+{
+	PIPC_POOL_STRUCT rx_pool;
+	u32 cpu = SYS_CPUID();
+	u32 *word;
+	u32 len;
+	u32 i;
+
+	UNUSED(Data);
+	UNUSED(IrqStatus);
+
+	word = ipc_pool_recv(pool_dir(!cpu), ChanNum, &rx_pool, &len);
+	if (word == NULL) {
+		rx_null[cpu]++;
+		return;
+	}
+
+	CHECK(rx_pool == pool);
+	CHECK(len == POOL_BUF_SIZE);
+	/* every word carries the sender and its sequence number, in order */
+	for (i = 0; i < len / sizeof(u32); i++) {
+		CHECK(word[i] == ((rx_seq[cpu] << 1) | !cpu));
+	}
+	rx_seq[cpu]++;
+	rx_cnt[cpu]++;
+
+	/* free half of the buffers right here, leave the others to the task */
+	if ((rx_seq[cpu] & 1) || (rx_keep_wr[cpu] - rx_keep_rd[cpu] == POOL_BUF_NUM)) {
+		CHECK(ipc_pool_free(rx_pool, word) == RTK_SUCCESS);
+	} else {
+		rx_keep[cpu][rx_keep_wr[cpu] % POOL_BUF_NUM] = word;
+		__atomic_store_n(&rx_keep_wr[cpu], rx_keep_wr[cpu] + 1, __ATOMIC_RELEASE);
+	}
+}
+
+/* free the buffers the handler left to the task */
+static void pool_task_free(u32 cpu)
+{
+	while (rx_keep_rd[cpu] != __atomic_load_n(&rx_keep_wr[cpu], __ATOMIC_ACQUIRE)) {
+		CHECK(ipc_pool_free(pool, rx_keep[cpu][rx_keep_rd[cpu] % POOL_BUF_NUM]) == RTK_SUCCESS);
+		__atomic_store_n(&rx_keep_rd[cpu], rx_keep_rd[cpu] + 1, __ATOMIC_RELEASE);
+	}
+}
+
+static void *pool_core(void *arg)
+{
+	u32 cpu = SYS_CPUID();
+	u32 seq = 0;
+	u32 *word;
+	u32 i;
+
+	UNUSED(arg);
+
+	while (seq < rounds) {
+		pool_task_free(cpu);
+
+		word = ipc_pool_alloc(pool);
+		if (word == NULL) {
+			sched_yield();
+			continue;
+		}
+
+		CHECK(pool->owner[((u8 *)word - pool_mem - sizeof(IPC_POOL_STRUCT)) / POOL_BUF_SIZE] == IPC_POOL_OWNER(cpu));
+		for (i = 0; i < POOL_BUF_SIZE / sizeof(u32); i++) {
+			word[i] = (seq << 1) | cpu;
+		}
+		CHECK(ipc_pool_send(pool_dir(cpu), POOL_CH(cpu), pool, word, POOL_BUF_SIZE) == IPC_SEND_SUCCESS);
+		seq++;
+	}
+
+	/* keep giving back what the handler left until both sides got all */
+	while ((__atomic_load_n(&rx_cnt[!cpu], __ATOMIC_ACQUIRE) != rounds) ||
+		   (__atomic_load_n(&rx_cnt[cpu], __ATOMIC_ACQUIRE) != rounds)) {
+		pool_task_free(cpu);
+		sched_yield();
+	}
+	pool_task_free(cpu);
+
+	return NULL;
+}
+
+static void *pool_violate(void *arg)
+{
+	static u8 not_pool[POOL_BUF_SIZE];
+	u32 *injected = (u32 *)arg;
+	IPC_MSG_STRUCT forged;
+	u8 *buf;
+	u8 *kept;
+
+	/* free after send, the buffer belongs to the peer now */
+	buf = ipc_pool_alloc(pool);
+	CHECK(ipc_pool_send(pool_dir(1), POOL_CH(1), pool, buf, 4) == IPC_SEND_SUCCESS);
+	CHECK(ipc_pool_free(pool, buf) == IPC_POOL_NOT_OWNER);
+	(*injected)++;
+
+	/* send after send */
+	CHECK(ipc_pool_send(pool_dir(1), POOL_CH(1), pool, buf, 4) == IPC_POOL_NOT_OWNER);
+	(*injected)++;
+
+	/* memory outside of the pool, and inside but not at a buffer start */
+	CHECK(ipc_pool_send(pool_dir(1), POOL_CH(1), pool, not_pool, 4) == IPC_POOL_NOT_OWNER);
+	(*injected)++;
+	kept = ipc_pool_alloc(pool);
+	CHECK(ipc_pool_send(pool_dir(1), POOL_CH(1), pool, kept + 4, 4) == IPC_POOL_NOT_OWNER);
+	(*injected)++;
+
+	/* longer than a buffer */
+	CHECK(ipc_pool_send(pool_dir(1), POOL_CH(1), pool, kept, POOL_BUF_SIZE + 1) == IPC_POOL_NOT_OWNER);
+	(*injected)++;
+
+	/* double free */
+	buf = ipc_pool_alloc(pool);
+	CHECK(ipc_pool_free(pool, buf) == RTK_SUCCESS);
+	CHECK(ipc_pool_free(pool, buf) == IPC_POOL_NOT_OWNER);
+	(*injected)++;
+
+	/* a message for a buffer the sender still owns must not reach the peer */
+	forged.msg_type = IPC_USER_POINT;
+	forged.msg = (u32)pool;
+	forged.msg_len = 4;
+	forged.rsvd = ((u8 *)kept - pool_mem - sizeof(IPC_POOL_STRUCT)) / POOL_BUF_SIZE;
+	CHECK(ipc_send_message(pool_dir(1), POOL_CH(1), &forged) == IPC_SEND_SUCCESS);
+	/* and an index past the pool */
+	forged.rsvd = POOL_BUF_NUM;
+	CHECK(ipc_send_message(pool_dir(1), POOL_CH(1), &forged) == IPC_SEND_SUCCESS);
+
+	CHECK(ipc_pool_free(pool, kept) == RTK_SUCCESS);
+
+	return NULL;
+}
+
+static void pool_null_handler(void *Data, u32 IrqStatus, u32 ChanNum)
+{
+	PIPC_POOL_STRUCT rx_pool;
+	u32 cpu = SYS_CPUID();
+	void *buf;
+	u32 len;
+
+	UNUSED(Data);
+	UNUSED(IrqStatus);
+
+	buf = ipc_pool_recv(pool_dir(!cpu), ChanNum, &rx_pool, &len);
+	if (buf == NULL) {
+		rx_null[cpu]++;
+		return;
+	}
+
+	/* the one buffer sent legally before it was freed again */
+	CHECK(ipc_pool_free(rx_pool, buf) == RTK_SUCCESS);
+	rx_cnt[cpu]++;
+}
+
+int main(int argc, char **argv)
+{
+	u32 injected = 0;
+	u32 i;
+
+	if (argc > 1) {
+		rounds = strtoul(argv[1], NULL, 0);
+	}
+
+	ipc_pool_init(pool, POOL_BUF_SIZE, POOL_BUF_NUM);
+	model_ipc_register(IPC_KM0_TO_KM4, POOL_CH(0), pool_rx_handler, NULL);
+	model_ipc_register(IPC_KM4_TO_KM0, POOL_CH(1), pool_rx_handler, NULL);
+
+	model_irq_start();
+	model_core_start(0, pool_core, NULL);
+	model_core_start(1, pool_core, NULL);
+	model_core_join();
+	model_irq_stop_all();
+
+	CHECK(rx_cnt[0] == rounds);
+	CHECK(rx_cnt[1] == rounds);
+	CHECK(rx_null[0] == 0 && rx_null[1] == 0);
+	CHECK(pool->violation == 0);
+	for (i = 0; i < POOL_BUF_NUM; i++) {
+		CHECK(pool->owner[i] == IPC_POOL_FREE);
+	}
+	printf("ipc_pool: %lu buffers each way, irq taken KM0 %lu KM4 %lu\n",
+		   (unsigned long)rounds, (unsigned long)model_irq_cnt[0], (unsigned long)model_irq_cnt[1]);
+
+	/* violations from KM4, KM0 receives */
+	rx_cnt[0] = 0;
+	model_ipc_register(IPC_KM4_TO_KM0, POOL_CH(1), pool_null_handler, NULL);
+	model_irq_start();
+	model_core_start(1, pool_violate, &injected);
+	model_core_join();
+	model_irq_stop_all();
+
+	CHECK(pool->violation == injected);
+	CHECK(rx_cnt[0] == 1);
+	CHECK(rx_null[0] == 2);
+	for (i = 0; i < POOL_BUF_NUM; i++) {
+		CHECK(pool->owner[i] == IPC_POOL_FREE);
+	}
+	printf("ipc_pool: %lu violations refused, %lu forged messages dropped\n",
+		   (unsigned long)pool->violation, (unsigned long)rx_null[0]);
+
+	if (fail) {
+		printf("ipc_pool: FAIL (%lu)\n", (unsigned long)fail);
+		return 1;
+	}
+
+	printf("ipc_pool: ownership kept\n");
+	return 0;
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Two thread throughput of the IPC message ring against the single message slot, on the
+ * two core model. Both cores send msgs messages to each other at the same time, each
+ * direction on its own channel, while the peer takes them in its rx handler after
+ * model_irq_latency_us of interrupt entry. With the slot every message waits for the peer
+ * handler of the one before, with the ring a burst shares one doorbell.
+ *
+ * Every message must arrive once and in order, and the ring must not take more peer
+ * interrupts than messages.
+ *
+ *   ipc_ring_bench [msgs [irq_latency_us [depth]]]	exit status is non-zero on any failure
+ */
+
+#include <sched.h>
+#include <stdlib.h>
+#include "ipc_model.h"
+#include "os_wrapper.h"
+
+#define RING_DEPTH_MAX		256
+/* one channel per direction, the model devices keep one TX bit per direction */
+#define RING_CH(cpu)		((u8)(cpu))
+
+static u8 ring_mem[2][IPC_RING_SIZE(RING_DEPTH_MAX)] __attribute__((aligned(32)));
+static PIPC_RING_STRUCT ring[2] = {(PIPC_RING_STRUCT)ring_mem[0], (PIPC_RING_STRUCT)ring_mem[1]};
+
+static u32 msgs = 20000;
+static u32 depth = 16;
+static u32 fail;
+
+/* per receiving core */
+static u32 rx_cnt[2];
+static u32 rx_order[2];
+/* per sending core */
+static u32 tx_full[2];
+
+#define CHECK(expr)	do { \
+		if (!(expr)) { \
+			printf("ipc_ring: %s:%d check failed: %s\n", __FILE__, __LINE__, #expr); \
+			__atomic_fetch_add(&fail, 1, __ATOMIC_RELAXED); \
+		} \
+	} while (0)
+
+static u32 ring_dir(u32 cpu)
+{
+	return cpu ? IPC_KM4_TO_KM0 : IPC_KM0_TO_KM4;
+}
+
+static void ring_rx_one(u32 cpu, PIPC_MSG_STRUCT msg)
+{
+	/* msg carries the sequence number, msg_len the sender */
+	if ((msg->msg != rx_cnt[cpu]) || (msg->msg_len != !cpu)) {
+		rx_order[cpu]++;
+	}
+	__atomic_store_n(&rx_cnt[cpu], rx_cnt[cpu] + 1, __ATOMIC_RELEASE);
+}
+
+static void slot_rx_handler(void *Data, u32 IrqStatus, u32 ChanNum)
+{
+	u32 cpu = SYS_CPUID();
+
+	UNUSED(Data);
+	UNUSED(IrqStatus);
+
+	ring_rx_one(cpu, ipc_get_message(ring_dir(!cpu), ChanNum));
+}
+
+static void ring_rx_handler(void *Data, u32 IrqStatus, u32 ChanNum)
+{
+	PIPC_RING_STRUCT rx_ring = ipc_ring_get(ring_dir(!SYS_CPUID()), ChanNum);
+	IPC_MSG_STRUCT msg;
+	u32 cpu = SYS_CPUID();
+
+	UNUSED(Data);
+	UNUSED(IrqStatus);
+
+	CHECK(rx_ring == ring[!cpu]);
+	while (ipc_ring_recv(rx_ring, &msg)) {
+		ring_rx_one(cpu, &msg);
+	}
+}
+
+/* wait until the peer got all, as a task would before tearing the channel down */
+static void ring_core_wait(u32 cpu)
+{
+	while (__atomic_load_n(&rx_cnt[!cpu], __ATOMIC_ACQUIRE) != msgs) {
+		sched_yield();
+	}
+}
+
+static void *slot_core(void *arg)
+{
+	u32 cpu = SYS_CPUID();
+	IPC_MSG_STRUCT msg;
+	u32 seq;
+
+	UNUSED(arg);
+
+	msg.msg_type = IPC_USER_DATA;
+	msg.msg_len = cpu;
+	msg.rsvd = 0;
+	for (seq = 0; seq < msgs; seq++) {
+		msg.msg = seq;
+		CHECK(ipc_send_message(ring_dir(cpu), RING_CH(cpu), &msg) == IPC_SEND_SUCCESS);
+	}
+	ring_core_wait(cpu);
+
+	return NULL;
+}
+
+static void *ring_core(void *arg)
+{
+	u32 cpu = SYS_CPUID();
+	IPC_MSG_STRUCT msg;
+	u32 seq = 0;
+	u32 ret;
+
+	UNUSED(arg);
+
+	msg.msg_type = IPC_USER_DATA;
+	msg.msg_len = cpu;
+	msg.rsvd = 0;
+	while (seq < msgs) {
+		msg.msg = seq;
+		ret = ipc_ring_send(ring_dir(cpu), RING_CH(cpu), ring[cpu], &msg);
+		if (ret == IPC_RING_FULL) {
+			tx_full[cpu]++;
+			sched_yield();
+			continue;
+		}
+		CHECK(ret == IPC_SEND_SUCCESS);
+		seq++;
+	}
+	ring_core_wait(cpu);
+
+	return NULL;
+}
+
+/* msgs each way, returns messages per second over both directions */
+static double ring_run(const char *name, void *(*core)(void *), IPC_IRQ_FUN handler)
+{
+	double start;
+	double us;
+	u32 cpu;
+
+	for (cpu = 0; cpu < 2; cpu++) {
+		rx_cnt[cpu] = rx_order[cpu] = tx_full[cpu] = 0;
+		model_irq_cnt[cpu] = 0;
+		model_ipc_register(ring_dir(cpu), RING_CH(cpu), handler, NULL);
+	}
+
+	model_irq_start();
+	start = model_now_us();
+	model_core_start(0, core, NULL);
+	model_core_start(1, core, NULL);
+	model_core_join();
+	us = model_now_us() - start;
+	model_irq_stop_all();
+
+	for (cpu = 0; cpu < 2; cpu++) {
+		CHECK(rx_cnt[cpu] == msgs);
+		CHECK(rx_order[cpu] == 0);
+		/* KM0 takes the interrupts of KM4_TO_KM0 */
+		CHECK(model_irq_cnt[cpu] <= msgs);
+	}
+
+	printf("ipc_ring: %-8s %9.0f msgs/s, %5.1f msgs per peer irq, ring full %lu/%lu\n",
+		   name, 2 * msgs / us * 1e6, 2.0 * msgs / (model_irq_cnt[0] + model_irq_cnt[1]),
+		   (unsigned long)tx_full[0], (unsigned long)tx_full[1]);
+
+	return 2 * msgs / us * 1e6;
+}
+
+int main(int argc, char **argv)
+{
+	double slot;
+	double rate;
+
+	model_irq_latency_us = 10;
+	if (argc > 1) {
+		msgs = strtoul(argv[1], NULL, 0);
+	}
+	if (argc > 2) {
+		model_irq_latency_us = strtoul(argv[2], NULL, 0);
+	}
+	if (argc > 3) {
+		depth = strtoul(argv[3], NULL, 0);
+	}
+	if ((depth == 0) || (depth > RING_DEPTH_MAX) || (depth & (depth - 1))) {
+		printf("ipc_ring: depth must be a power of 2 up to %u\n", RING_DEPTH_MAX);
+		return 1;
+	}
+
+	printf("ipc_ring: %lu msgs each way, irq latency %lu us, depth %lu\n",
+		   (unsigned long)msgs, (unsigned long)model_irq_latency_us, (unsigned long)depth);
+
+	slot = ring_run("slot", slot_core, slot_rx_handler);
+
+	ipc_ring_init(ring[0], depth);
+	ipc_ring_init(ring[1], depth);
+	rate = ring_run("ring", ring_core, ring_rx_handler);
+	CHECK(ring[0]->head == msgs && ring[0]->tail == msgs);
+	CHECK(ring[1]->head == msgs && ring[1]->tail == msgs);
+
+	if (fail) {
+		printf("ipc_ring: FAIL (%lu)\n", (unsigned long)fail);
+		return 1;
+	}
+
+	printf("ipc_ring: ring %.1fx the slot\n", rate / slot);
+	return 0;
+}
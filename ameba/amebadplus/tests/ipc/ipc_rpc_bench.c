@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Two thread round trip of the IPC RPC layer, on the two core model. Both cores call
+ * functions of each other at the same time, each direction on its own channel: first
+ * calls one by one with ipc_rpc_call, then batches of ipc_rpc_submit polled to the end,
+ * then a function ID nobody serves.
+ *
+ * Every call must return the result of its own arguments, and must be counted once in the
+ * channel statistics. Calls/s, the round trip latency and calls per peer irq are printed.
+ *
+ *   ipc_rpc_bench [calls [irq_latency_us [batch]]]	exit status is non-zero on any failure
+ */
+
+#include <sched.h>
+#include <stdlib.h>
+#include "ipc_model.h"
+#include "os_wrapper.h"
+
+#define RPC_DEPTH			16
+#define RPC_TIMEOUT_US		1000000
+/* one channel per direction, the model devices keep one TX bit per direction */
+#define RPC_CH(cpu)			((u8)(cpu))
+
+#define RPC_ID_ADD			1
+#define RPC_ID_MIX			2
+#define RPC_ID_NONE			7
+
+static u8 rpc_ring_mem[2][IPC_RING_SIZE(RPC_DEPTH)] __attribute__((aligned(32)));
+static IPC_RPC_CALL rpc_frame[2][RPC_DEPTH] __attribute__((aligned(32)));
+static IPC_RPC_STRUCT rpc[2];
+
+static u32 calls = 5000;
+static u32 batch = RPC_DEPTH;
+static u32 fail;
+
+/* per serving core */
+static u32 served[2];
+
+#define CHECK(expr)	do { \
+		if (!(expr)) { \
+			printf("ipc_rpc: %s:%d check failed: %s\n", __FILE__, __LINE__, #expr); \
+			__atomic_fetch_add(&fail, 1, __ATOMIC_RELAXED); \
+		} \
+	} while (0)
+
+static u32 rpc_add(u32 *args, u32 argc)
+{
+	u32 sum = 0;
+	u32 i;
+
+	for (i = 0; i < argc; i++) {
+		sum += args[i];
+	}
+	served[SYS_CPUID()]++;
+
+	return sum;
+}
+
+static u32 rpc_mix(u32 *args, u32 argc)
+{
+	served[SYS_CPUID()]++;
+
+	return (args[0] * 2654435761U) ^ (argc << 28) ^ SYS_CPUID();
+}
+
+static const IPC_RPC_ENTRY rpc_table[] = {
+	{RPC_ID_ADD, rpc_add},
+	{RPC_ID_MIX, rpc_mix},
+};
+
+static u32 rpc_dir(u32 cpu)
+{
+	return cpu ? IPC_KM4_TO_KM0 : IPC_KM0_TO_KM4;
+}
+
+static void rpc_rx_handler(void *Data, u32 IrqStatus, u32 ChanNum)
+{
+	UNUSED(Data);
+	UNUSED(IrqStatus);
+
+	ipc_rpc_serve(rpc_dir(!SYS_CPUID()), ChanNum);
+}
+
+/* call n of a core, argument count 0..IPC_RPC_MAX_ARGS */
+static void rpc_fill(PIPC_RPC_CALL call, u32 cpu, u32 n)
+{
+	u32 i;
+
+	call->func_id = (n & 1) ? RPC_ID_MIX : RPC_ID_ADD;
+	call->argc = (call->func_id == RPC_ID_MIX) ? 1 : n % (IPC_RPC_MAX_ARGS + 1);
+	for (i = 0; i < IPC_RPC_MAX_ARGS; i++) {
+		call->args[i] = (n << 8) + (cpu << 4) + i;
+	}
+}
+
+static u32 rpc_expect(PIPC_RPC_CALL call, u32 cpu)
+{
+	u32 sum = 0;
+	u32 i;
+
+	if (call->func_id == RPC_ID_MIX) {
+		/* served by the peer */
+		return (call->args[0] * 2654435761U) ^ (call->argc << 28) ^ !cpu;
+	}
+
+	for (i = 0; i < call->argc; i++) {
+		sum += call->args[i];
+	}
+
+	return sum;
+}
+
+static void *rpc_sync_core(void *arg)
+{
+	u32 cpu = SYS_CPUID();
+	PIPC_RPC_CALL call = &rpc_frame[cpu][0];
+	u32 ret;
+	u32 n;
+
+	UNUSED(arg);
+
+	for (n = 0; n < calls; n++) {
+		rpc_fill(call, cpu, n);
+		ret = ~0U;
+		CHECK(ipc_rpc_call(&rpc[cpu], call, &ret, RPC_TIMEOUT_US) == IPC_RPC_DONE);
+		CHECK(ret == rpc_expect(call, cpu));
+	}
+
+	return NULL;
+}
+
+static void *rpc_batch_core(void *arg)
+{
+	u32 cpu = SYS_CPUID();
+	PIPC_RPC_CALL frame = rpc_frame[cpu];
+	u32 submitted;
+	u32 num;
+	u32 n = 0;
+	u32 i;
+
+	UNUSED(arg);
+
+	while (n < calls) {
+		num = (calls - n < batch) ? calls - n : batch;
+		for (i = 0; i < num; i++) {
+			rpc_fill(&frame[i], cpu, n + i);
+		}
+
+		/* the ring has room for RPC_DEPTH, the rest follows once the peer drained some */
+		submitted = 0;
+		while (submitted < num) {
+			submitted += ipc_rpc_submit(&rpc[cpu], &frame[submitted], num - submitted);
+			if (submitted < num) {
+				sched_yield();
+			}
+		}
+
+		for (i = 0; i < num; i++) {
+			while (ipc_rpc_poll(&rpc[cpu], &frame[i]) == IPC_RPC_PENDING) {
+				sched_yield();
+			}
+			CHECK(frame[i].state == IPC_RPC_DONE);
+			CHECK(frame[i].ret == rpc_expect(&frame[i], cpu));
+			/* accounted once */
+			CHECK(ipc_rpc_poll(&rpc[cpu], &frame[i]) == IPC_RPC_DONE);
+		}
+		n += num;
+	}
+
+	return NULL;
+}
+
+static void *rpc_none_core(void *arg)
+{
+	u32 cpu = SYS_CPUID();
+	PIPC_RPC_CALL call = &rpc_frame[cpu][0];
+	u32 ret = 0x5A5A5A5A;
+
+	UNUSED(arg);
+
+	rpc_fill(call, cpu, 0);
+	call->func_id = RPC_ID_NONE;
+	CHECK(ipc_rpc_call(&rpc[cpu], call, &ret, RPC_TIMEOUT_US) == IPC_RPC_NO_FUNC);
+	CHECK(ret == 0);
+
+	return NULL;
+}
+
+static void rpc_run(const char *name, void *(*core)(void *), u32 num)
+{
+	double start;
+	double us;
+	u32 max;
+	u32 cpu;
+
+	for (cpu = 0; cpu < 2; cpu++) {
+		ipc_rpc_init(&rpc[cpu], rpc_dir(cpu), RPC_CH(cpu), (PIPC_RING_STRUCT)rpc_ring_mem[cpu], RPC_DEPTH);
+		served[cpu] = 0;
+		model_irq_cnt[cpu] = 0;
+	}
+
+	model_irq_start();
+	start = model_now_us();
+	model_core_start(0, core, NULL);
+	model_core_start(1, core, NULL);
+	model_core_join();
+	us = model_now_us() - start;
+	model_irq_stop_all();
+
+	for (cpu = 0; cpu < 2; cpu++) {
+		CHECK(rpc[cpu].stat.calls == num);
+		CHECK(rpc[cpu].stat.doorbell_timeout == 0);
+		CHECK(rpc[cpu].stat.latency_max * (u64)num >= rpc[cpu].stat.latency_total);
+	}
+
+	if (num > 1) {
+		max = (rpc[0].stat.latency_max > rpc[1].stat.latency_max) ? rpc[0].stat.latency_max : rpc[1].stat.latency_max;
+		printf("ipc_rpc: %-6s %8.0f calls/s, round trip avg %5.1f max %5lu us, %4.1f calls per peer irq, ring full %lu/%lu\n",
+			   name, 2 * num / us * 1e6,
+			   (double)(rpc[0].stat.latency_total + rpc[1].stat.latency_total) / (2 * num),
+			   (unsigned long)max,
+			   2.0 * num / (model_irq_cnt[0] + model_irq_cnt[1]),
+			   (unsigned long)rpc[0].stat.ring_full, (unsigned long)rpc[1].stat.ring_full);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	u32 cpu;
+
+	model_irq_latency_us = 10;
+	if (argc > 1) {
+		calls = strtoul(argv[1], NULL, 0);
+	}
+	if (argc > 2) {
+		model_irq_latency_us = strtoul(argv[2], NULL, 0);
+	}
+	if (argc > 3) {
+		batch = strtoul(argv[3], NULL, 0);
+	}
+	if ((batch == 0) || (batch > RPC_DEPTH)) {
+		printf("ipc_rpc: batch must be 1..%u\n", RPC_DEPTH);
+		return 1;
+	}
+
+	printf("ipc_rpc: %lu calls each way, irq latency %lu us, batch %lu\n",
+		   (unsigned long)calls, (unsigned long)model_irq_latency_us, (unsigned long)batch);
+
+	ipc_rpc_register(rpc_table, sizeof(rpc_table) / sizeof(rpc_table[0]));
+	for (cpu = 0; cpu < 2; cpu++) {
+		model_ipc_register(rpc_dir(cpu), RPC_CH(cpu), rpc_rx_handler, NULL);
+	}
+
+	rpc_run("sync", rpc_sync_core, calls);
+	CHECK(served[0] == calls && served[1] == calls);
+
+	rpc_run("batch", rpc_batch_core, calls);
+	CHECK(served[0] == calls && served[1] == calls);
+
+	rpc_run("none", rpc_none_core, 1);
+	CHECK(served[0] == 0 && served[1] == 0);
+
+	if (fail) {
+		printf("ipc_rpc: FAIL (%lu)\n", (unsigned long)fail);
+		return 1;
+	}
+
+	printf("ipc_rpc: every call returned its own result\n");
+	return 0;
+}
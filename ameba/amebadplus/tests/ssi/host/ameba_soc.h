@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host stand-in for ameba_soc.h, just what ameba_spi.c needs. The SPI registers and
+ * the GDMA functions it calls are modeled in ssi_model.c.
+ */
+
+#ifndef _AMEBA_SOC_H_
+#define _AMEBA_SOC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+
+#define __IO			volatile
+#define __I			volatile const
+#define __O			volatile
+#define _LONG_CALL_
+#define ALIGNMTO(x)		__attribute__((aligned(x)))
+#define BIT(x)			(1UL << (x))
+#define TRUE			1
+#define FALSE			0
+#define ENABLE			1
+#define DISABLE			0
+#define MIN(x, y)		(((x) < (y)) ? (x) : (y))
+#define MAX(x, y)		(((x) > (y)) ? (x) : (y))
+
+#define assert_param(expr)	((void)0)
+#define _memset			memset
+
+typedef u32(*IRQ_FUN)(void *Data);
+
+enum {
+	RTK_LOG_NONE = 0,
+	RTK_LOG_ERROR,
+	RTK_LOG_WARN,
+	RTK_LOG_INFO,
+	RTK_LOG_DEBUG,
+};
+extern int model_log_level;
+#define RTK_LOGS(tag, level, fmt, ...)	do { \
+		if ((level) <= model_log_level) { \
+			fprintf(stderr, "[%s] " fmt, tag, ##__VA_ARGS__); \
+		} \
+	} while (0)
+#define RTK_LOGE(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_ERROR, fmt, ##__VA_ARGS__)
+#define RTK_LOGW(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_WARN, fmt, ##__VA_ARGS__)
+#define RTK_LOGI(tag, fmt, ...)		RTK_LOGS(tag, RTK_LOG_INFO, fmt, ##__VA_ARGS__)
+
+#define RTK_SUCCESS		0
+#define RTK_FAIL		(-1)
+
+/* cache of the host is coherent */
+#define DCache_Clean(addr, len)			((void)(addr), (void)(len))
+#define DCache_Invalidate(addr, len)		((void)(addr), (void)(len))
+#define DCache_CleanInvalidate(addr, len)	((void)(addr), (void)(len))
+
+/* the SPI role bits of REG_LSYS_PLAT_CTRL, in plain memory */
+extern u32 model_sysctrl[];
+#define SYSTEM_CTRL_BASE	((u32)model_sysctrl)
+#define REG_LSYS_PLAT_CTRL	0x0230
+#define LSYS_BIT_SPI0_MST	((u32)0x00000001 << 26)
+#define LSYS_BIT_SPI1_MST	((u32)0x00000001 << 27)
+#define HAL_READ32(base, addr)				((u32)(*((volatile u32*)(base + addr))))
+#define HAL_WRITE32(base, addr, value32)	((*((volatile u32*)(base + addr))) = ((u32)(value32)))
+
+u32 irq_disable_save(void);
+void irq_enable_restore(u32 PrevStatus);
+
+#define INT_PRI_MIDDLE		5
+typedef enum {
+	SPI0_IRQ = 40,
+	SPI1_IRQ = 41,
+} IRQn_Type;
+
+#include "ameba_gdma.h"
+#include "ameba_spi.h"
+
+/* both SPI register blocks on one page of their own, every access to it traps into
+the model, see ssi_model.c */
+union model_spi_page {
+	SPI_TypeDef dev[2];
+	u8 page[4096];
+};
+extern union model_spi_page model_spi_page;
+#define SPI0_DEV		(&model_spi_page.dev[0])
+#define SPI1_DEV		(&model_spi_page.dev[1])
+
+#endif
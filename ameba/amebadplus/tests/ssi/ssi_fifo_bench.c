@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Bytes per CPU cycle of SSI_TransferFullDuplex against the SSI_SendData/SSI_ReceiveData
+ * loop it replaces, on the SPI FIFO model of ssi_model.c. Both run 8 and 16 bit frames
+ * with TX and RX buffers, TX only and RX only, on a wire that is never the bottleneck,
+ * on one about as fast as the register accesses and on a slow one. The old loop limits each SSI_SendData to what RX can still take,
+ * as a careful caller has to.
+ *
+ * The model counts only register accesses as CPU time, at model_apb_cycles each, so the
+ * numbers compare register traffic and FIFO waits, not instruction counts.
+ *
+ * Every frame sent must be the TX buffer (zero without one), every frame received the
+ * peer answer, no FIFO may over- or underflow, and SSI_TransferFullDuplex must leave the
+ * interrupt mask alone.
+ *
+ *   ssi_fifo_bench [frames [apb_cycles]]	exit status is non-zero on any failure
+ */
+
+#include <stdlib.h>
+#include "ssi_model.h"
+#include "reg_trap.h"
+
+#define FRAMES_MAX		65536
+/* CPU cycles per SCLK: a wire that is never the bottleneck, one as fast as the register
+accesses and a slow one */
+#define WIRE_INSTANT	0
+#define WIRE_FAST		1
+#define WIRE_SLOW		16
+
+static u32 frames = 4096;
+static u32 fail;
+
+static u16 tx16[FRAMES_MAX];
+static u16 rx16[FRAMES_MAX];
+static u8 tx8[FRAMES_MAX];
+static u8 rx8[FRAMES_MAX];
+static u32 wire_log[FRAMES_MAX];
+
+#define CHECK(expr)	do { \
+		if (!(expr)) { \
+			printf("ssi_fifo: %s:%d check failed: %s\n", __FILE__, __LINE__, #expr); \
+			fail++; \
+		} \
+	} while (0)
+
+struct fifo_case {
+	const char *name;
+	u32 dfs;
+	u32 tx;
+	u32 rx;
+};
+
+/* the exchange as it was done before, SSI_SendData topping up TX and SSI_ReceiveData
+draining RX in turn */
+static u32 legacy_exchange(SPI_TypeDef *spi, void *tx, void *rx, u32 len, u32 wide)
+{
+	u32 sent = 0;
+	u32 got = 0;
+	u32 n;
+
+	while (got < len) {
+		n = MIN(len - sent, SSI_RX_FIFO_DEPTH - (sent - got));
+		if (n) {
+			sent += SSI_SendData(spi, tx ? (u8 *)tx + (sent << wide) : NULL, n, SSI_MASTER);
+		}
+		got += SSI_ReceiveData(spi, rx ? (u8 *)rx + (got << wide) : NULL, len - got);
+	}
+
+	return got;
+}
+
+static double fifo_run(const struct fifo_case *fc, u32 legacy, u32 bit_cycles, u32 *access)
+{
+	struct model_ssi *ssi = &model_ssi[0];
+	u32 wide = (fc->dfs > DFS_8_BITS);
+	u32 mask = (1U << (fc->dfs + 1)) - 1;
+	void *tx = fc->tx ? (wide ? (void *)tx16 : (void *)tx8) : NULL;
+	void *rx = fc->rx ? (wide ? (void *)rx16 : (void *)rx8) : NULL;
+	u64 start_cycles;
+	u64 start_access;
+	u32 sent;
+	u32 got;
+	u32 imr;
+	u32 ret;
+	u32 i;
+
+	model_ssi_reset(0);
+	model_bit_cycles = bit_cycles;
+	ssi->wire = wire_log;
+	ssi->wire_max = FRAMES_MAX;
+
+	SSI_SetDataFrameSize(SPI0_DEV, fc->dfs);
+	SSI_INTConfig(SPI0_DEV, SPI_BIT_TXEIM, DISABLE);
+	imr = SPI0_DEV->SPI_IMR;
+
+	for (i = 0; i < frames; i++) {
+		tx16[i] = (u16)((i * 0x2545F491U >> 7) & mask);
+		tx8[i] = (u8)tx16[i];
+	}
+	memset(rx16, 0xA5, sizeof(rx16));
+	memset(rx8, 0xA5, sizeof(rx8));
+
+	start_cycles = model_cycles;
+	start_access = reg_trap_cnt;
+	if (legacy) {
+		ret = legacy_exchange(SPI0_DEV, tx, rx, frames, wide);
+	} else {
+		ret = SSI_TransferFullDuplex(SPI0_DEV, tx, rx, frames);
+		CHECK(SPI0_DEV->SPI_IMR == imr);
+	}
+	*access = reg_trap_cnt - start_access;
+
+	CHECK(ret == frames);
+	CHECK(ssi->frames == frames);
+	CHECK(ssi->tx_overflow == 0 && ssi->rx_overflow == 0 && ssi->rx_underflow == 0);
+	CHECK(ssi->tx_wr == ssi->tx_rd && ssi->rx_wr == ssi->rx_rd);
+
+	for (i = 0; i < frames; i++) {
+		sent = fc->tx ? (wide ? tx16[i] : tx8[i]) : 0;
+		got = wide ? rx16[i] : rx8[i];
+
+		if (wire_log[i] != sent) {
+			printf("ssi_fifo: %s frame %u sent %x, buffer %x\n", fc->name, i, wire_log[i], sent);
+			fail++;
+			break;
+		}
+		if (fc->rx && (got != model_ssi_peer(i, fc->dfs))) {
+			printf("ssi_fifo: %s frame %u got %x, peer %x\n", fc->name, i, got, model_ssi_peer(i, fc->dfs));
+			fail++;
+			break;
+		}
+	}
+	if (!fc->rx) {
+		/* nothing stored */
+		CHECK(rx16[0] == 0xA5A5 && rx8[frames - 1] == 0xA5);
+	}
+
+	return (double)(frames << wide) / (model_cycles - start_cycles);
+}
+
+int main(int argc, char **argv)
+{
+	static const struct fifo_case cases[] = {
+		{"8 bit",          DFS_8_BITS,  1, 1},
+		{"8 bit TX only",  DFS_8_BITS,  1, 0},
+		{"8 bit RX only",  DFS_8_BITS,  0, 1},
+		{"16 bit",         DFS_16_BITS, 1, 1},
+		{"16 bit TX only", DFS_16_BITS, 1, 0},
+		{"12 bit RX only", DFS_12_BITS, 0, 1},
+	};
+	static const u32 wires[] = {WIRE_INSTANT, WIRE_FAST, WIRE_SLOW};
+	double old_rate, new_rate;
+	u32 old_access, new_access;
+	u32 c, w;
+
+	if (argc > 1) {
+		frames = strtoul(argv[1], NULL, 0);
+	}
+	if (argc > 2) {
+		model_apb_cycles = strtoul(argv[2], NULL, 0);
+	}
+	if ((frames == 0) || (frames > FRAMES_MAX)) {
+		printf("ssi_fifo: frames must be 1..%u\n", FRAMES_MAX);
+		return 1;
+	}
+
+	model_ssi_init();
+
+	printf("ssi_fifo: %u frames, %u cycles per register access\n", frames, model_apb_cycles);
+	for (w = 0; w < sizeof(wires) / sizeof(wires[0]); w++) {
+		for (c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+			old_rate = fifo_run(&cases[c], 1, wires[w], &old_access);
+			new_rate = fifo_run(&cases[c], 0, wires[w], &new_access);
+			printf("ssi_fifo: %2u cycles/bit %-14s send/receive %.4f bytes/cycle %5.2f accesses/frame | full duplex %.4f bytes/cycle %5.2f accesses/frame | %.2fx\n",
+				   wires[w], cases[c].name, old_rate, (double)old_access / frames,
+				   new_rate, (double)new_access / frames, new_rate / old_rate);
+			/* when only the CPU limits, fewer accesses per frame are the speedup */
+			if (wires[w] == WIRE_INSTANT) {
+				CHECK(new_access < old_access);
+			}
+		}
+	}
+
+	if (fail) {
+		printf("ssi_fifo: FAIL (%u)\n", fail);
+		return 1;
+	}
+
+	printf("ssi_fifo: every frame sent and received once\n");
+	return 0;
+}
@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host model of the two SPI masters for ameba_spi.c. The register page traps (see
+ * ../common/reg_trap.c), so reading the data register pops the RX FIFO, writing it
+ * pushes the TX FIFO and the level and status registers follow both.
+ *
+ * Time is virtual and counted in CPU cycles: a register access takes model_apb_cycles,
+ * and between two accesses the wire shifts out TX frames back to back at
+ * model_bit_cycles per bit. Each frame that completes pushes the peer answer into RX,
+ * or is lost if RX is full. Disabling the SPI clears both FIFOs as the hardware does.
+ *
+ * GDMA channels move frames between memory and the FIFOs whenever the wire is simulated,
+ * as fast as the FIFOs allow, and take no CPU cycles. Their interrupts stay pending until
+ * model_ssi_run, so a handler never runs inside a register access of the driver.
+ */
+
+#include <stdlib.h>
+#include "ssi_model.h"
+#include "reg_trap.h"
+
+union model_spi_page model_spi_page __attribute__((aligned(REG_TRAP_PAGE_SIZE)));
+u32 model_sysctrl[REG_TRAP_PAGE_SIZE / sizeof(u32)];
+int model_log_level = RTK_LOG_NONE;
+
+struct model_ssi model_ssi[2];
+u64 model_cycles;
+u32 model_apb_cycles = 4;
+u32 model_bit_cycles = 2;
+
+struct model_gdma model_gdma[MAX_GDMA_CHNL + 1];
+u32 model_gdma_enables;
+u32 model_gdma_fail_in;
+
+static void model_gdma_run(struct model_ssi *ssi);
+
+u32 irq_disable_save(void)
+{
+	return 0;
+}
+
+void irq_enable_restore(u32 PrevStatus)
+{
+	(void)PrevStatus;
+}
+
+u32 model_ssi_peer(u32 n, u32 DataFrameSize)
+{
+	return ((n * 0x9E3779B1U) >> 11) & ((1U << (DataFrameSize + 1)) - 1);
+}
+
+static u32 model_ssi_dfs(struct model_ssi *ssi)
+{
+	return ssi->reg.SPI_CTRLR0 & SPI_MASK_DFS;
+}
+
+/* shift frames until Now */
+static void model_ssi_wire(struct model_ssi *ssi, u64 Now)
+{
+	u32 dfs = model_ssi_dfs(ssi);
+	u32 frame;
+
+	while (1) {
+		model_gdma_run(ssi);
+
+		if (!ssi->shifting) {
+			if (((ssi->reg.SPI_SSIENR & SPI_BIT_SSI_EN) == 0) || (ssi->tx_wr == ssi->tx_rd)) {
+				break;
+			}
+
+			frame = ssi->tx_fifo[ssi->tx_rd++ % SSI_TX_FIFO_DEPTH];
+			if (ssi->wire && (ssi->frames < ssi->wire_max)) {
+				ssi->wire[ssi->frames] = frame;
+			}
+			ssi->shift_end = ssi->wire_t + (dfs + 1) * model_bit_cycles;
+			ssi->shifting = 1;
+		}
+
+		if (ssi->shift_end > Now) {
+			return;
+		}
+
+		ssi->wire_t = ssi->shift_end;
+		ssi->shifting = 0;
+		if (ssi->rx_wr - ssi->rx_rd == SSI_RX_FIFO_DEPTH) {
+			ssi->rx_overflow++;
+		} else {
+			ssi->rx_fifo[ssi->rx_wr++ % SSI_RX_FIFO_DEPTH] = model_ssi_peer(ssi->frames, dfs);
+		}
+		ssi->frames++;
+	}
+
+	/* idle, the next frame starts when it is written */
+	ssi->wire_t = Now;
+}
+
+static u32 model_ssi_status(struct model_ssi *ssi)
+{
+	u32 tx = ssi->tx_wr - ssi->tx_rd;
+	u32 rx = ssi->rx_wr - ssi->rx_rd;
+	u32 sr = 0;
+
+	sr |= (ssi->shifting || tx) ? SPI_BIT_BUSY : 0;
+	sr |= (tx < SSI_TX_FIFO_DEPTH) ? SPI_BIT_TFNF : 0;
+	sr |= (tx == 0) ? SPI_BIT_TFE : 0;
+	sr |= rx ? SPI_BIT_RFNE : 0;
+	sr |= (rx == SSI_RX_FIFO_DEPTH) ? SPI_BIT_RFF : 0;
+
+	return sr;
+}
+
+static u32 model_ssi_read(u32 Offset)
+{
+	struct model_ssi *ssi = &model_ssi[Offset / sizeof(SPI_TypeDef)];
+	u32 reg = Offset % sizeof(SPI_TypeDef);
+	u32 val;
+
+	model_ssi_wire(ssi, model_cycles);
+	model_cycles += model_apb_cycles;
+
+	switch (reg) {
+	case offsetof(SPI_TypeDef, SPI_TXFLR):
+		return ssi->tx_wr - ssi->tx_rd;
+	case offsetof(SPI_TypeDef, SPI_RXFLR):
+		return ssi->rx_wr - ssi->rx_rd;
+	case offsetof(SPI_TypeDef, SPI_SR):
+		return model_ssi_status(ssi);
+	}
+
+	if ((reg >= offsetof(SPI_TypeDef, SPI_DRx)) && (reg < offsetof(SPI_TypeDef, SPI_RX_SAMPLE_DLY))) {
+		if (ssi->rx_wr == ssi->rx_rd) {
+			ssi->rx_underflow++;
+			return 0;
+		}
+		return ssi->rx_fifo[ssi->rx_rd++ % SSI_RX_FIFO_DEPTH];
+	}
+
+	memcpy(&val, (u8 *)&ssi->reg + reg, sizeof(val));
+	return val;
+}
+
+static void model_ssi_write(u32 Offset, u32 Value)
+{
+	struct model_ssi *ssi = &model_ssi[Offset / sizeof(SPI_TypeDef)];
+	u32 reg = Offset % sizeof(SPI_TypeDef);
+
+	model_ssi_wire(ssi, model_cycles);
+	model_cycles += model_apb_cycles;
+
+	if ((reg >= offsetof(SPI_TypeDef, SPI_DRx)) && (reg < offsetof(SPI_TypeDef, SPI_RX_SAMPLE_DLY))) {
+		if (ssi->tx_wr - ssi->tx_rd == SSI_TX_FIFO_DEPTH) {
+			ssi->tx_overflow++;
+		} else {
+			ssi->tx_fifo[ssi->tx_wr++ % SSI_TX_FIFO_DEPTH] = Value & ((1U << (model_ssi_dfs(ssi) + 1)) - 1);
+		}
+		return;
+	}
+
+	memcpy((u8 *)&ssi->reg + reg, &Value, sizeof(Value));
+
+	/* disabled: transfers halt and both FIFOs are cleared */
+	if ((reg == offsetof(SPI_TypeDef, SPI_SSIENR)) && ((Value & SPI_BIT_SSI_EN) == 0)) {
+		ssi->tx_rd = ssi->tx_wr;
+		ssi->rx_rd = ssi->rx_wr;
+		ssi->shifting = 0;
+	}
+}
+
+void model_ssi_reset(u32 Index)
+{
+	struct model_ssi *ssi = &model_ssi[Index];
+
+	memset(ssi, 0, sizeof(*ssi));
+	ssi->reg.SPI_CTRLR0 = DFS_8_BITS;
+	ssi->wire_t = model_cycles;
+}
+
+void model_ssi_init(void)
+{
+	memset(model_gdma, 0, sizeof(model_gdma));
+	model_gdma_enables = 0;
+	model_gdma_fail_in = 0;
+
+	model_ssi_reset(0);
+	model_ssi_reset(1);
+	reg_trap_init(&model_spi_page, model_ssi_read, model_ssi_write);
+}
+
+void model_ssi_run(u64 Cycles)
+{
+	struct model_gdma *ch;
+	u32 pending = 1;
+	u32 i;
+
+	model_cycles += Cycles;
+	model_ssi_wire(&model_ssi[0], model_cycles);
+	model_ssi_wire(&model_ssi[1], model_cycles);
+
+	/* a handler may start the next transfer, which may complete at once */
+	while (pending) {
+		pending = 0;
+		for (i = 0; i <= MAX_GDMA_CHNL; i++) {
+			ch = &model_gdma[i];
+			if (ch->used && ch->isr && ch->irq) {
+				ch->irq((void *)(uintptr_t)ch->irq_data);
+				pending = 1;
+			}
+		}
+	}
+}
+
+/* the SPI whose data register Addr is, or NULL */
+static struct model_ssi *model_gdma_ssi(u32 Addr)
+{
+	u32 base = (u32)(uintptr_t)&model_spi_page;
+
+	if ((Addr < base) || (Addr >= base + 2 * sizeof(SPI_TypeDef))) {
+		return NULL;
+	}
+
+	return &model_ssi[(Addr - base) / sizeof(SPI_TypeDef)];
+}
+
+/* one frame of Size bytes, little endian as the bus */
+static u32 model_gdma_load(u32 Addr, u32 Size)
+{
+	u32 val = 0;
+
+	memcpy(&val, (void *)(uintptr_t)Addr, Size);
+
+	return val;
+}
+
+static void model_gdma_store(u32 Addr, u32 Size, u32 Val)
+{
+	memcpy((void *)(uintptr_t)Addr, &Val, Size);
+}
+
+static u32 model_gdma_end(struct model_gdma *ch)
+{
+	if (ch->err && (ch->moved >= ch->err_at)) {
+		ch->isr |= ErrType & ch->init.GDMA_IsrType;
+		ch->enabled = 0;
+	} else if (ch->moved >= ch->bytes) {
+		ch->isr |= (TransferType | BlockType) & ch->init.GDMA_IsrType;
+		ch->enabled = 0;
+	}
+
+	return !ch->enabled;
+}
+
+/* move what the FIFOs of ssi allow */
+static void model_gdma_run(struct model_ssi *ssi)
+{
+	PGDMA_InitTypeDef init;
+	struct model_gdma *ch;
+	u32 mask = (1U << (model_ssi_dfs(ssi) + 1)) - 1;
+	u32 size;
+	u32 i;
+
+	for (i = 0; i <= MAX_GDMA_CHNL; i++) {
+		ch = &model_gdma[i];
+		init = &ch->init;
+		if (!ch->enabled) {
+			continue;
+		}
+
+		if ((init->GDMA_DIR == TTFCMemToPeri) && (model_gdma_ssi(init->GDMA_DstAddr) == ssi) &&
+			(ssi->reg.SPI_DMACR & SPI_BIT_TDMAE)) {
+			size = 1U << init->GDMA_DstDataWidth;
+			while (!model_gdma_end(ch) && (ssi->tx_wr - ssi->tx_rd < SSI_TX_FIFO_DEPTH)) {
+				ssi->tx_fifo[ssi->tx_wr++ % SSI_TX_FIFO_DEPTH] =
+					model_gdma_load(init->GDMA_SrcAddr + ((init->GDMA_SrcInc == IncType) ? ch->moved : 0), size) & mask;
+				ch->moved += size;
+			}
+		} else if ((init->GDMA_DIR == TTFCPeriToMem) && (model_gdma_ssi(init->GDMA_SrcAddr) == ssi) &&
+				   (ssi->reg.SPI_DMACR & SPI_BIT_RDMAE)) {
+			size = 1U << init->GDMA_SrcDataWidth;
+			while (!model_gdma_end(ch) && (ssi->rx_wr != ssi->rx_rd)) {
+				model_gdma_store(init->GDMA_DstAddr + ((init->GDMA_DstInc == IncType) ? ch->moved : 0), size,
+								 ssi->rx_fifo[ssi->rx_rd++ % SSI_RX_FIFO_DEPTH]);
+				ch->moved += size;
+			}
+		}
+	}
+}
+
+u8 GDMA_ChnlAlloc(u32 GDMA_Index, IRQ_FUN IrqFun, u32 IrqData, u32 IrqPriority)
+{
+	struct model_gdma *ch;
+	u32 i;
+
+	(void)GDMA_Index;
+	(void)IrqPriority;
+
+	for (i = 0; i <= MAX_GDMA_CHNL; i++) {
+		ch = &model_gdma[i];
+		if (!ch->used) {
+			memset(ch, 0, sizeof(*ch));
+			ch->used = 1;
+			ch->irq = IrqFun;
+			ch->irq_data = IrqData;
+			return (u8)i;
+		}
+	}
+
+	return 0xFF;
+}
+
+u8 GDMA_ChnlFree(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	(void)GDMA_Index;
+
+	if (!model_gdma[GDMA_ChNum].used || model_gdma[GDMA_ChNum].enabled) {
+		abort();
+	}
+	model_gdma[GDMA_ChNum].used = 0;
+
+	return 1;
+}
+
+void GDMA_StructInit(PGDMA_InitTypeDef GDMA_InitStruct)
+{
+	memset(GDMA_InitStruct, 0, sizeof(*GDMA_InitStruct));
+}
+
+void GDMA_Init(u8 GDMA_Index, u8 GDMA_ChNum, PGDMA_InitTypeDef GDMA_InitStruct)
+{
+	struct model_gdma *ch = &model_gdma[GDMA_ChNum];
+
+	(void)GDMA_Index;
+
+	if (!ch->used || ch->enabled) {
+		abort();
+	}
+	ch->init = *GDMA_InitStruct;
+	ch->bytes = GDMA_InitStruct->GDMA_BlockSize << GDMA_InitStruct->GDMA_SrcDataWidth;
+}
+
+void GDMA_Cmd(u8 GDMA_Index, u8 GDMA_ChNum, u32 NewState)
+{
+	struct model_gdma *ch = &model_gdma[GDMA_ChNum];
+
+	(void)GDMA_Index;
+
+	if (NewState == DISABLE) {
+		ch->enabled = 0;
+		return;
+	}
+
+	ch->enabled = 1;
+	ch->moved = 0;
+	ch->err = 0;
+	model_gdma_enables++;
+	if (model_gdma_fail_in && (--model_gdma_fail_in == 0)) {
+		ch->err = 1;
+		ch->err_at = (ch->bytes / 2) & ~3U;
+	}
+}
+
+u32 GDMA_ClearINT(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	u32 isr = model_gdma[GDMA_ChNum].isr;
+
+	(void)GDMA_Index;
+
+	model_gdma[GDMA_ChNum].isr = 0;
+
+	return isr;
+}
+
+u8 GDMA_Abort(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	(void)GDMA_Index;
+
+	model_gdma[GDMA_ChNum].enabled = 0;
+
+	return 1;
+}
+
+/* LLP chains are not modeled */
+void GDMA_SetLLP(u8 GDMA_Index, u8 GDMA_ChNum, u32 MultiBlockCount, struct GDMA_CH_LLI *pGdmaChLli, u32 round)
+{
+	(void)GDMA_Index;
+	(void)GDMA_ChNum;
+	(void)MultiBlockCount;
+	(void)pGdmaChLli;
+	(void)round;
+	abort();
+}
+
+u32 GDMA_GetDstAddr(u8 GDMA_Index, u8 GDMA_ChNum)
+{
+	(void)GDMA_Index;
+	(void)GDMA_ChNum;
+	abort();
+}
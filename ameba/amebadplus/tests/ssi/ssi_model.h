@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _SSI_MODEL_H_
+#define _SSI_MODEL_H_
+
+#include "ameba_soc.h"
+
+/* one SPI master, its FIFOs and the wire to a peer that answers each frame */
+struct model_ssi {
+	SPI_TypeDef reg;			/* plain registers, FIFO and level registers are computed */
+	u32 tx_fifo[SSI_TX_FIFO_DEPTH];
+	u32 tx_rd, tx_wr;
+	u32 rx_fifo[SSI_RX_FIFO_DEPTH];
+	u32 rx_rd, rx_wr;
+
+	u64 wire_t;					/* cycle the wire is simulated up to */
+	u64 shift_end;				/* cycle the frame on the wire is done, if shifting */
+	u32 shifting;
+	u32 frames;					/* frames done on the wire */
+	u32 *wire;					/* frames sent, up to wire_max, can be NULL */
+	u32 wire_max;
+
+	u32 tx_overflow;			/* writes to a full TX FIFO */
+	u32 rx_overflow;			/* frames lost to a full RX FIFO */
+	u32 rx_underflow;			/* reads of an empty RX FIFO */
+};
+
+extern struct model_ssi model_ssi[2];
+
+/* CPU cycles: each register access takes model_apb_cycles, a bit on the wire
+model_bit_cycles. Time only moves on register accesses and model_ssi_run. */
+extern u64 model_cycles;
+extern u32 model_apb_cycles;
+extern u32 model_bit_cycles;
+
+/* one GDMA channel between memory and a SPI FIFO, moving frames as soon as the FIFO
+has data or room and the SPI has DMA enabled for that direction */
+struct model_gdma {
+	u32 used;
+	IRQ_FUN irq;
+	u32 irq_data;
+	GDMA_InitTypeDef init;
+	u32 enabled;
+	u32 bytes;					/* block length in bytes */
+	u32 moved;					/* bytes moved so far */
+	u32 err;					/* raise ErrType once err_at bytes are moved */
+	u32 err_at;
+	u32 isr;					/* pending interrupt types */
+};
+
+extern struct model_gdma model_gdma[MAX_GDMA_CHNL + 1];
+/* channels enabled since model_ssi_init */
+extern u32 model_gdma_enables;
+/* when set, the channel enabled as the model_gdma_fail_in-th next fails halfway */
+extern u32 model_gdma_fail_in;
+
+/* map and trap the register page, reset both SPI and free all GDMA channels */
+void model_ssi_init(void);
+void model_ssi_reset(u32 Index);
+/* let Cycles pass without the CPU touching SPI, then take the pending GDMA interrupts
+one by one. This is the only place handlers run, never inside a register access. */
+void model_ssi_run(u64 Cycles);
+
+/* what the peer answers to frame n of a transfer, of DataFrameSize + 1 bits */
+u32 model_ssi_peer(u32 n, u32 DataFrameSize);
+
+#endif
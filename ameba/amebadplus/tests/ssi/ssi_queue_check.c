@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2024 Realtek Semiconductor Corp.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Ordering of the SPI transaction queue (SSI_QueueSubmit) on the FIFO and GDMA model of
+ * ssi_model.c. One script mixes command/address headers, CS held over two transactions,
+ * frame size changes, short transfers done by polling, transfers without buffers, an
+ * unaligned buffer, a GDMA error on RX and one on TX, and a transaction submitted from a
+ * callback. All of it is submitted at once and run from the GDMA interrupts.
+ *
+ * Callbacks must come in submit order, each transaction must put exactly its header and
+ * data on the wire (zero frames without TX data) and receive the peer answers into its
+ * own buffer. CS must only toggle with the wire idle and no frame may go out while it is
+ * released. The two failed transactions may be cut short but must not leak frames into
+ * the next one. Short transfers must not use GDMA.
+ *
+ * The same bulk traffic is then run queued and polled, printing how much of the time the
+ * CPU spends in the driver. Interrupts are taken between model_ssi_run slices only, so
+ * races between a submit and the ISR are not covered.
+ *
+ *   ssi_queue_check	exit status is non-zero on any failure
+ */
+
+#include <stdlib.h>
+#include "ssi_model.h"
+
+#define POLL_THRESHOLD	16
+#define SLICE_CYCLES	32			/* CPU work between two looks at the interrupts */
+#define BUF_MAX			512
+#define WIRE_MAX		16384
+#define OVERLAP_XFERS	32
+#define OVERLAP_LEN		256
+
+struct queue_case {
+	const char *name;
+	u8 cmd_len;
+	u8 cmd;
+	u8 addr_len;
+	u8 cs_hold;
+	u32 addr;
+	u32 dfs;			/* 0 keeps the frame size */
+	u32 tx;
+	u32 rx;
+	u32 len;
+	u32 offset;			/* buffer misalignment */
+	u32 fail;			/* model_gdma_fail_in for this transaction, 1 is its RX channel */
+};
+
+static const struct queue_case cases[] = {
+	{"read id",       1, 0x9F, 3, 0, 0x123456, 0,           0, 1, 64,  0, 0},
+	{"write start",   1, 0x02, 0, 1, 0,        0,           1, 0, 200, 0, 0},
+	{"write cont",    0, 0,    0, 0, 0,        0,           1, 1, 100, 0, 0},
+	{"status poll",   1, 0x05, 1, 0, 0x80,     0,           0, 1, 4,   0, 0},
+	{"16 bit",        1, 0x31, 0, 0, 0,        DFS_16_BITS, 1, 1, 128, 0, 0},
+	{"16 bit poll",   0, 0,    0, 0, 0,        0,           0, 1, 8,   0, 0},
+	{"8 bit clocks",  0, 0,    0, 0, 0,        DFS_8_BITS,  0, 0, 300, 0, 0},
+	{"unaligned",     1, 0x0B, 2, 0, 0xBEEF,   0,           1, 1, 37,  1, 0},
+	{"rx fails",      1, 0x03, 3, 0, 0x10000,  0,           1, 1, 256, 0, 1},
+	{"tx fails",      1, 0x03, 3, 0, 0x20000,  0,           1, 1, 256, 0, 2},
+	{"after fail",    1, 0x9F, 0, 0, 0,        0,           0, 1, 64,  0, 0},
+	/* submitted from the callback of "write cont" */
+	{"from callback", 1, 0x06, 0, 0, 0,        0,           1, 0, 32,  0, 0},
+};
+
+#define CASE_NUM		(sizeof(cases) / sizeof(cases[0]))
+#define CASE_SUBMIT		2			/* submits the last case */
+
+static SSI_QueueTypeDef queue;
+static SSI_XferTypeDef xfer[CASE_NUM];
+static u8 txbuf[CASE_NUM][BUF_MAX] __attribute__((aligned(4)));
+static u8 rxbuf[CASE_NUM][BUF_MAX] __attribute__((aligned(4)));
+static u32 wire_log[WIRE_MAX];
+
+/* in completion order */
+static u32 done_case[CASE_NUM];
+static u32 done_status[CASE_NUM];
+static u32 done_frames[CASE_NUM];
+static u32 done_cs[CASE_NUM];
+static u32 done_num;
+
+static u32 cs_state;
+static u32 cs_frames;			/* wire frames when CS was released */
+static u32 cs_asserts;
+static u32 fail;
+
+#define CHECK(expr)	do { \
+		if (!(expr)) { \
+			printf("ssi_queue: %s:%d check failed: %s\n", __FILE__, __LINE__, #expr); \
+			fail++; \
+		} \
+	} while (0)
+
+static u32 wire_idle(void)
+{
+	struct model_ssi *ssi = &model_ssi[0];
+
+	return (ssi->tx_wr == ssi->tx_rd) && !ssi->shifting;
+}
+
+static void queue_cs(u32 Index, u32 Assert)
+{
+	CHECK(Index == 0);
+	CHECK(Assert != cs_state);
+	CHECK(wire_idle());
+
+	if (Assert) {
+		/* nothing went out while released */
+		CHECK(model_ssi[0].frames == cs_frames);
+		cs_asserts++;
+	} else {
+		cs_frames = model_ssi[0].frames;
+	}
+	cs_state = Assert;
+}
+
+static void queue_cb(void *CbData, u32 Status)
+{
+	u32 n = (u32)(uintptr_t)CbData;
+
+	done_case[done_num] = n;
+	done_status[done_num] = Status;
+	done_frames[done_num] = model_ssi[0].frames;
+	done_cs[done_num] = cs_state;
+	done_num++;
+
+	if (n == CASE_SUBMIT) {
+		CHECK(SSI_QueueSubmit(&queue, &xfer[CASE_NUM - 1]) == RTK_SUCCESS);
+	}
+	/* the next in submit order is started after this returns */
+	if ((n + 1 < CASE_NUM) && cases[n + 1].fail) {
+		model_gdma_fail_in = cases[n + 1].fail;
+	}
+}
+
+static void queue_xfer(u32 n)
+{
+	const struct queue_case *qc = &cases[n];
+	SSI_XferTypeDef *x = &xfer[n];
+	u32 i;
+
+	memset(x, 0, sizeof(*x));
+	x->CmdLen = qc->cmd_len;
+	x->Cmd = qc->cmd;
+	x->AddrLen = qc->addr_len;
+	x->Addr = qc->addr;
+	x->CsHold = qc->cs_hold;
+	x->DataFrameSize = qc->dfs;
+	x->TxData = qc->tx ? txbuf[n] + qc->offset : NULL;
+	x->RxData = qc->rx ? rxbuf[n] + qc->offset : NULL;
+	x->Length = qc->len;
+	x->Callback = queue_cb;
+	x->CbData = (void *)(uintptr_t)n;
+
+	for (i = 0; i < BUF_MAX; i++) {
+		txbuf[n][i] = (u8)((n << 5) + i * 7 + 1);
+	}
+	memset(rxbuf[n], 0xA5, BUF_MAX);
+}
+
+/* the frames transaction n puts on the wire, returns how many */
+static u32 queue_expect(u32 n, u32 dfs, u32 *exp, u32 *hdr)
+{
+	const struct queue_case *qc = &cases[n];
+	u32 wide = (dfs > DFS_8_BITS);
+	u32 mask = (1U << (dfs + 1)) - 1;
+	u8 *tx = txbuf[n] + qc->offset;
+	u32 num = 0;
+	u32 i;
+
+	if (qc->cmd_len) {
+		exp[num++] = qc->cmd & mask;
+	}
+	for (i = qc->addr_len; i > 0; i--) {
+		exp[num++] = (qc->addr >> ((i - 1) * 8)) & 0xFF & mask;
+	}
+	*hdr = num;
+
+	for (i = 0; i < (wide ? qc->len / 2 : qc->len); i++) {
+		if (!qc->tx) {
+			exp[num++] = 0;
+		} else if (wide) {
+			exp[num++] = (tx[2 * i] | (tx[2 * i + 1] << 8)) & mask;
+		} else {
+			exp[num++] = tx[i] & mask;
+		}
+	}
+
+	return num;
+}
+
+static void queue_order(void)
+{
+	struct model_ssi *ssi = &model_ssi[0];
+	static u32 exp[BUF_MAX + 5];
+	u32 dfs = DFS_8_BITS;
+	u32 dma_xfers = 0;
+	u32 chains = 0;
+	u32 start = 0;
+	u32 num, hdr, got, wide;
+	u32 k, n, i;
+
+	model_ssi_reset(0);
+	ssi->wire = wire_log;
+	ssi->wire_max = WIRE_MAX;
+	SSI_Cmd(SPI0_DEV, ENABLE);
+
+	CHECK(SSI_QueueInit(&queue, 0, POLL_THRESHOLD, queue_cs) == TRUE);
+	for (n = 0; n < CASE_NUM; n++) {
+		queue_xfer(n);
+		dma_xfers += (cases[n].len >= POLL_THRESHOLD);
+		chains += ((n == 0) || !cases[n - 1].cs_hold);
+	}
+
+	for (n = 0; n < CASE_NUM - 1; n++) {
+		CHECK(SSI_QueueSubmit(&queue, &xfer[n]) == RTK_SUCCESS);
+	}
+	while (SSI_QueueBusy(&queue)) {
+		model_ssi_run(SLICE_CYCLES);
+	}
+
+	CHECK(done_num == CASE_NUM);
+	for (k = 0; k < done_num; k++) {
+		n = done_case[k];
+		CHECK(n == k);
+		if (n != k) {
+			break;
+		}
+
+		if (cases[n].dfs) {
+			dfs = cases[n].dfs;
+		}
+		wide = (dfs > DFS_8_BITS);
+		num = queue_expect(n, dfs, exp, &hdr);
+		got = done_frames[k] - start;
+
+		CHECK(done_cs[k] == cases[n].cs_hold);
+		if (cases[n].fail) {
+			/* cut short, but nothing of it left for the next one */
+			CHECK(done_status[k] == (u32)RTK_FAIL);
+			CHECK(got <= num);
+		} else {
+			CHECK(done_status[k] == RTK_SUCCESS);
+			CHECK(got == num);
+		}
+
+		for (i = 0; i < MIN(got, num); i++) {
+			if (wire_log[start + i] != exp[i]) {
+				printf("ssi_queue: %s frame %u sent %x, expected %x\n", cases[n].name, i, wire_log[start + i], exp[i]);
+				fail++;
+				break;
+			}
+		}
+
+		for (i = 0; cases[n].rx && !cases[n].fail && (i < num - hdr); i++) {
+			u8 *rx = rxbuf[n] + cases[n].offset;
+			u32 val = wide ? (u32)(rx[2 * i] | (rx[2 * i + 1] << 8)) : rx[i];
+
+			if (val != model_ssi_peer(start + hdr + i, dfs)) {
+				printf("ssi_queue: %s frame %u got %x, peer %x\n", cases[n].name, i, val, model_ssi_peer(start + hdr + i, dfs));
+				fail++;
+				break;
+			}
+		}
+		if (!cases[n].rx) {
+			CHECK(rxbuf[n][0] == 0xA5 && rxbuf[n][BUF_MAX - 1] == 0xA5);
+		}
+
+		printf("ssi_queue: %-13s %3u frames, %s\n", cases[n].name, got, (done_status[k] == RTK_SUCCESS) ? "done" : "failed");
+		start = done_frames[k];
+	}
+
+	CHECK(cs_asserts == chains);
+	CHECK(cs_state == 0);
+	CHECK(model_gdma_enables == 2 * dma_xfers);
+	CHECK(model_gdma_fail_in == 0);
+	CHECK(ssi->tx_overflow == 0 && ssi->rx_overflow == 0 && ssi->rx_underflow == 0);
+
+	SSI_QueueDeInit(&queue);
+	for (i = 0; i <= MAX_GDMA_CHNL; i++) {
+		CHECK(!model_gdma[i].used);
+	}
+}
+
+/* CPU cycles spent in the driver for the bulk traffic, polled or queued */
+static u64 queue_overlap(u32 Threshold, u64 *Total)
+{
+	u64 start = model_cycles;
+	u64 idle = 0;
+	u32 n;
+
+	model_ssi_reset(0);
+	SSI_Cmd(SPI0_DEV, ENABLE);
+	CHECK(SSI_QueueInit(&queue, 0, Threshold, NULL) == TRUE);
+
+	for (n = 0; n < OVERLAP_XFERS; n++) {
+		memset(&xfer[0], 0, sizeof(xfer[0]));
+		xfer[0].TxData = txbuf[0];
+		xfer[0].RxData = rxbuf[0];
+		xfer[0].Length = OVERLAP_LEN;
+		CHECK(SSI_QueueSubmit(&queue, &xfer[0]) == RTK_SUCCESS);
+		/* the application works until its transaction is done */
+		while (SSI_QueueBusy(&queue)) {
+			model_ssi_run(SLICE_CYCLES);
+			idle += SLICE_CYCLES;
+		}
+	}
+	SSI_QueueDeInit(&queue);
+
+	CHECK(model_ssi[0].frames == OVERLAP_XFERS * OVERLAP_LEN);
+	*Total = model_cycles - start;
+
+	return *Total - idle;
+}
+
+int main(void)
+{
+	u64 queued, polled;
+	u64 queued_total, polled_total;
+
+	model_ssi_init();
+
+	queue_order();
+
+	queued = queue_overlap(POLL_THRESHOLD, &queued_total);
+	polled = queue_overlap(0xFFFFFFFF, &polled_total);
+	printf("ssi_queue: %u x %u bytes, CPU in the driver %llu of %llu cycles queued, %llu of %llu polled\n",
+		   OVERLAP_XFERS, OVERLAP_LEN, (unsigned long long)queued, (unsigned long long)queued_total,
+		   (unsigned long long)polled, (unsigned long long)polled_total);
+	CHECK(queued < polled);
+
+	if (fail) {
+		printf("ssi_queue: FAIL (%u)\n", fail);
+		return 1;
+	}
+
+	printf("ssi_queue: transactions ran in submit order, CS and frame size followed\n");
+	return 0;
+}